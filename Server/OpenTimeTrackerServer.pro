@@ -18,23 +18,73 @@ SOURCES += src/main.cpp \
     src/TimeTracker.cpp \
     src/Database/EventManagement.cpp \
     src/Database/UserManagement.cpp \
+    src/Database/ChangeNotifier.cpp \
     src/Database/DatabaseManagement.cpp \
     src/Database/SettingsManagement.cpp \
     src/Database/ScheduleManagement.cpp \
     src/Schedule.cpp \
+    src/ScheduleTemplate.cpp \
     src/BreakTimeCalculator.cpp \
     src/Server.cpp \
     src/Client.cpp \
+    src/CredentialCache.cpp \
+    src/EventRecorder.cpp \
+    src/GroupMembership.cpp \
+    src/IoWorker.cpp \
+    src/LatencyHistogram.cpp \
+    src/Roster.cpp \
+    src/ScheduleCache.cpp \
+    src/ScheduleIndex.cpp \
+    src/Settings.cpp \
+    src/TcpServer.cpp \
+    src/TimerWheel.cpp \
+    src/UserDirectory.cpp \
+    src/UserSet.cpp \
+    src/WorkingDayCache.cpp \
     src/Packets/Packet.cpp \
+    src/Packets/ResponsePacket.cpp \
     src/PacketHandler.cpp \
     src/Packets/PacketReader.cpp \
     src/Packets/PacketWriter.cpp \
+    src/Packets/ClockEventRequestPacket.cpp \
+    src/Packets/ClockEventRequestPacketReader.cpp \
+    src/Packets/ClockEventRequestPacketWriter.cpp \
+    src/Packets/ClockEventResponsePacket.cpp \
+    src/Packets/ClockEventResponsePacketReader.cpp \
+    src/Packets/ClockEventResponsePacketWriter.cpp \
+    src/Packets/CompressionRequestPacket.cpp \
+    src/Packets/CompressionRequestPacketReader.cpp \
+    src/Packets/CompressionRequestPacketWriter.cpp \
+    src/Packets/CompressionResponsePacket.cpp \
+    src/Packets/CompressionResponsePacketReader.cpp \
+    src/Packets/CompressionResponsePacketWriter.cpp \
     src/Packets/KeepAliveRequestPacket.cpp \
     src/Packets/KeepAliveResponsePacket.cpp \
     src/Packets/KeepAliveRequestPacketReader.cpp \
     src/Packets/KeepAliveResponsePacketReader.cpp \
     src/Packets/KeepAliveRequestPacketWriter.cpp \
-    src/Packets/KeepAliveResponsePacketWriter.cpp
+    src/Packets/KeepAliveResponsePacketWriter.cpp \
+    src/Packets/LoginRequestPacket.cpp \
+    src/Packets/LoginRequestPacketReader.cpp \
+    src/Packets/LoginRequestPacketWriter.cpp \
+    src/Packets/LoginResponsePacket.cpp \
+    src/Packets/LoginResponsePacketReader.cpp \
+    src/Packets/LoginResponsePacketWriter.cpp \
+    src/Packets/SubscribeUserStatusRequestPacket.cpp \
+    src/Packets/SubscribeUserStatusRequestPacketReader.cpp \
+    src/Packets/SubscribeUserStatusRequestPacketWriter.cpp \
+    src/Packets/SubscribeUserStatusResponsePacket.cpp \
+    src/Packets/SubscribeUserStatusResponsePacketReader.cpp \
+    src/Packets/SubscribeUserStatusResponsePacketWriter.cpp \
+    src/Packets/UserStatusPacket.cpp \
+    src/Packets/UserStatusPacketReader.cpp \
+    src/Packets/UserStatusPacketWriter.cpp \
+    src/Packets/UserTotalsRequestPacket.cpp \
+    src/Packets/UserTotalsRequestPacketReader.cpp \
+    src/Packets/UserTotalsRequestPacketWriter.cpp \
+    src/Packets/UserTotalsResponsePacket.cpp \
+    src/Packets/UserTotalsResponsePacketReader.cpp \
+    src/Packets/UserTotalsResponsePacketWriter.cpp
 
 HEADERS += \
     src/Event.hpp \
@@ -45,23 +95,73 @@ HEADERS += \
     src/TimeTracker.hpp \
     src/Database/EventManagement.hpp \
     src/Database/UserManagement.hpp \
+    src/Database/ChangeNotifier.hpp \
     src/Database/DatabaseManagement.hpp \
     src/Database/SettingsManagement.hpp \
     src/Database/ScheduleManagement.hpp \
     src/Schedule.hpp \
+    src/ScheduleTemplate.hpp \
     src/BreakTimeCalculator.hpp \
     src/Server.hpp \
     src/Client.hpp \
+    src/CredentialCache.hpp \
+    src/EventRecorder.hpp \
+    src/GroupMembership.hpp \
+    src/IoWorker.hpp \
+    src/LatencyHistogram.hpp \
+    src/Roster.hpp \
+    src/ScheduleCache.hpp \
+    src/ScheduleIndex.hpp \
+    src/Settings.hpp \
+    src/TcpServer.hpp \
+    src/TimerWheel.hpp \
+    src/UserDirectory.hpp \
+    src/UserSet.hpp \
+    src/WorkingDayCache.hpp \
     src/Packets/Packet.hpp \
+    src/Packets/ResponsePacket.hpp \
     src/PacketHandler.hpp \
     src/Packets/PacketReader.hpp \
     src/Packets/PacketWriter.hpp \
+    src/Packets/ClockEventRequestPacket.hpp \
+    src/Packets/ClockEventRequestPacketReader.hpp \
+    src/Packets/ClockEventRequestPacketWriter.hpp \
+    src/Packets/ClockEventResponsePacket.hpp \
+    src/Packets/ClockEventResponsePacketReader.hpp \
+    src/Packets/ClockEventResponsePacketWriter.hpp \
+    src/Packets/CompressionRequestPacket.hpp \
+    src/Packets/CompressionRequestPacketReader.hpp \
+    src/Packets/CompressionRequestPacketWriter.hpp \
+    src/Packets/CompressionResponsePacket.hpp \
+    src/Packets/CompressionResponsePacketReader.hpp \
+    src/Packets/CompressionResponsePacketWriter.hpp \
     src/Packets/KeepAliveRequestPacket.hpp \
     src/Packets/KeepAliveResponsePacket.hpp \
     src/Packets/KeepAliveRequestPacketReader.hpp \
     src/Packets/KeepAliveResponsePacketReader.hpp \
     src/Packets/KeepAliveRequestPacketWriter.hpp \
-    src/Packets/KeepAliveResponsePacketWriter.hpp
+    src/Packets/KeepAliveResponsePacketWriter.hpp \
+    src/Packets/LoginRequestPacket.hpp \
+    src/Packets/LoginRequestPacketReader.hpp \
+    src/Packets/LoginRequestPacketWriter.hpp \
+    src/Packets/LoginResponsePacket.hpp \
+    src/Packets/LoginResponsePacketReader.hpp \
+    src/Packets/LoginResponsePacketWriter.hpp \
+    src/Packets/SubscribeUserStatusRequestPacket.hpp \
+    src/Packets/SubscribeUserStatusRequestPacketReader.hpp \
+    src/Packets/SubscribeUserStatusRequestPacketWriter.hpp \
+    src/Packets/SubscribeUserStatusResponsePacket.hpp \
+    src/Packets/SubscribeUserStatusResponsePacketReader.hpp \
+    src/Packets/SubscribeUserStatusResponsePacketWriter.hpp \
+    src/Packets/UserStatusPacket.hpp \
+    src/Packets/UserStatusPacketReader.hpp \
+    src/Packets/UserStatusPacketWriter.hpp \
+    src/Packets/UserTotalsRequestPacket.hpp \
+    src/Packets/UserTotalsRequestPacketReader.hpp \
+    src/Packets/UserTotalsRequestPacketWriter.hpp \
+    src/Packets/UserTotalsResponsePacket.hpp \
+    src/Packets/UserTotalsResponsePacketReader.hpp \
+    src/Packets/UserTotalsResponsePacketWriter.hpp
 
 RESOURCES += \
     qrc/database.qrc
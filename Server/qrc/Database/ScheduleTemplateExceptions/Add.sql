@@ -0,0 +1,2 @@
+INSERT INTO ScheduleTemplateExceptions (scheduleTemplateId, date)
+VALUES (:scheduleTemplateId, :date);
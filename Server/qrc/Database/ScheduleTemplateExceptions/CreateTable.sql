@@ -0,0 +1,16 @@
+CREATE TABLE ScheduleTemplateExceptions (
+    id                 INTEGER PRIMARY KEY AUTOINCREMENT
+                               NOT NULL,
+    scheduleTemplateId INTEGER REFERENCES ScheduleTemplates (id) ON DELETE CASCADE
+                               NOT NULL,
+    date               DATE    CHECK (date <> '')
+                               NOT NULL,
+    UNIQUE (
+        scheduleTemplateId,
+        date
+    )
+);
+
+CREATE INDEX index_ScheduleTemplateExceptions_search ON ScheduleTemplateExceptions (
+    date
+);
@@ -0,0 +1,3 @@
+SELECT scheduleTemplateId, date FROM ScheduleTemplateExceptions
+WHERE (:startDate <= date) AND (date <= :endDate)
+ORDER BY scheduleTemplateId, date ASC;
@@ -0,0 +1,2 @@
+INSERT INTO ScheduleTemplates (userId, dayOfWeek, startTime, duration, validFrom, validUntil)
+VALUES (:userId, :dayOfWeek, :startTime, :duration, :validFrom, :validUntil);
@@ -0,0 +1,21 @@
+CREATE TABLE ScheduleTemplates (
+    id         INTEGER  PRIMARY KEY AUTOINCREMENT
+                        NOT NULL,
+    userId     INTEGER  REFERENCES Users (id)
+                        NOT NULL,
+    dayOfWeek  INTEGER  CHECK ((1 <= dayOfWeek) AND (dayOfWeek <= 7))
+                        NOT NULL,
+    startTime  TIME     CHECK (startTime <> '')
+                        NOT NULL,
+    duration   INTEGER  CHECK ((0 < duration) AND (duration <= 86400))
+                        NOT NULL,
+    validFrom  DATE     CHECK (validFrom <> '')
+                        NOT NULL,
+    validUntil DATE     CHECK (validUntil <> ''),
+    CHECK ((validUntil IS NULL) OR (validFrom <= validUntil))
+);
+
+CREATE INDEX index_ScheduleTemplates_search ON ScheduleTemplates (
+    validFrom,
+    validUntil
+);
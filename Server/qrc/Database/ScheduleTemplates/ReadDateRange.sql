@@ -0,0 +1,3 @@
+SELECT * FROM ScheduleTemplates
+WHERE (validFrom <= :endDate) AND ((validUntil IS NULL) OR (:startDate <= validUntil))
+ORDER BY userId, id ASC;
@@ -0,0 +1,2 @@
+DELETE FROM ScheduleTemplates
+WHERE (id == :id);
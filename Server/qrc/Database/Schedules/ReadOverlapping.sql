@@ -0,0 +1,3 @@
+SELECT * FROM Schedules
+WHERE (startTimestamp < :endTimestamp) AND (:startTimestamp < endTimestamp)
+ORDER BY userId, startTimestamp ASC;
@@ -0,0 +1,3 @@
+SELECT id FROM Schedules
+WHERE (userId == :userId) AND (startTimestamp < :endTimestamp) AND (:startTimestamp < endTimestamp)
+LIMIT 1;
@@ -1,4 +1,4 @@
-SELECT startTimestamp, endTimestamp FROM WorkingDays
+SELECT id, startTimestamp, endTimestamp FROM WorkingDays
 WHERE ((startTimestamp <= :timestamp) AND (:timestamp <= endTimestamp))
 ORDER BY id DESC
 LIMIT 1;
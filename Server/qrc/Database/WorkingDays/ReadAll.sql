@@ -0,0 +1,2 @@
+SELECT id, startTimestamp, endTimestamp FROM WorkingDays
+ORDER BY id ASC;
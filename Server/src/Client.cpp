@@ -14,32 +14,232 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Client.hpp"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
 #include "PacketHandler.hpp"
+#include "Packets/ClockEventRequestPacketReader.hpp"
+#include "Packets/ClockEventResponsePacketWriter.hpp"
+#include "Packets/CompressionRequestPacket.hpp"
+#include "Packets/CompressionRequestPacketReader.hpp"
+#include "Packets/CompressionResponsePacket.hpp"
+#include "Packets/CompressionResponsePacketWriter.hpp"
 #include "Packets/KeepAliveRequestPacket.hpp"
 #include "Packets/KeepAliveRequestPacketReader.hpp"
 #include "Packets/KeepAliveRequestPacketWriter.hpp"
 #include "Packets/KeepAliveResponsePacket.hpp"
 #include "Packets/KeepAliveResponsePacketReader.hpp"
 #include "Packets/KeepAliveResponsePacketWriter.hpp"
+#include "Packets/LoginRequestPacketReader.hpp"
+#include "Packets/LoginResponsePacketWriter.hpp"
+#include "Packets/SubscribeUserStatusRequestPacketReader.hpp"
+#include "Packets/SubscribeUserStatusResponsePacketWriter.hpp"
+#include "Packets/UserTotalsRequestPacketReader.hpp"
+#include "Packets/UserTotalsResponsePacketWriter.hpp"
+#include "Settings.hpp"
 
 using namespace OpenTimeTracker::Server;
 
 Client::Client(QObject *parent, QTcpSocket *socket)
     : QObject(parent),
       m_socket(socket),
-      m_packetHandler()
+      m_packetHandler(),
+      m_outputQueue(),
+      m_outputFlushScheduled(false),
+      m_outputHighWaterMark(1024LL * 1024LL),
+      m_maxFrameSize(Settings::defaultValue(Settings::Key_MaxFrameSize)),
+      m_maxInputBufferSize(Settings::defaultValue(Settings::Key_MaxInputBufferSize)),
+      m_pendingRequests(),
+      m_maxPendingRequests(32),
+      m_inputPaused(false),
+      m_compressionThreshold(Settings::defaultValue(Settings::Key_CompressionThreshold)),
+      m_compressionEnabled(false),
+      m_lastActivityTime(currentTime()),
+      m_peerAddress(socket->peerAddress().toString()),
+      m_keepAliveTimer(),
+      m_pendingKeepAliveRequests(),
+      m_roundTripHistogramMutex(),
+      m_roundTripHistogram()
 {
+    // Take ownership of the socket
+    m_socket->setParent(this);
+
     // Register packet readers
+    m_packetHandler.registerPacketReader(new Packets::CompressionRequestPacketReader());
     m_packetHandler.registerPacketReader(new Packets::KeepAliveRequestPacketReader());
     m_packetHandler.registerPacketReader(new Packets::KeepAliveResponsePacketReader());
+    m_packetHandler.registerPacketReader(new Packets::LoginRequestPacketReader());
+    m_packetHandler.registerPacketReader(new Packets::SubscribeUserStatusRequestPacketReader());
+    m_packetHandler.registerPacketReader(new Packets::UserTotalsRequestPacketReader());
 
     // Register packet writers
+    m_packetHandler.registerPacketWriter(new Packets::CompressionResponsePacketWriter());
     m_packetHandler.registerPacketWriter(new Packets::KeepAliveRequestPacketWriter());
     m_packetHandler.registerPacketWriter(new Packets::KeepAliveResponsePacketWriter());
+    m_packetHandler.registerPacketWriter(new Packets::LoginResponsePacketWriter());
+    m_packetHandler.registerPacketWriter(new Packets::SubscribeUserStatusResponsePacketWriter());
+    m_packetHandler.registerPacketWriter(new Packets::UserTotalsResponsePacketWriter());
+
+    // Register clock event packet readers and writers (one for each event type)
+    const QList<Event::Type> clockEventTypes = QList<Event::Type>() << Event::Type_Started
+                                                                    << Event::Type_OnBreak
+                                                                    << Event::Type_FromBreak
+                                                                    << Event::Type_Finished;
+
+    foreach (const Event::Type eventType, clockEventTypes)
+    {
+        m_packetHandler.registerPacketReader(new Packets::ClockEventRequestPacketReader(eventType));
+        m_packetHandler.registerPacketWriter(
+                    new Packets::ClockEventResponsePacketWriter(eventType));
+    }
+
+    // Write packets without any whitespace to minimize the size of the sent data
+    m_packetHandler.setJsonFormat(QJsonDocument::Compact);
+
+    // Limit the amount of received data that is buffered
+    applyInputLimits();
 
     // Connect needed signals and slots
     connect(m_socket, SIGNAL(disconnected()), this, SLOT(handleDisconnect()));
     connect(m_socket, SIGNAL(readyRead()), this, SLOT(processReceivedData()));
+    connect(m_socket, SIGNAL(bytesWritten(qint64)), this, SLOT(handleBytesWritten(qint64)));
+    connect(&m_keepAliveTimer, SIGNAL(timeout()), this, SLOT(sendKeepAliveRequest()));
+}
+
+qint64 Client::outputHighWaterMark() const
+{
+    return m_outputHighWaterMark;
+}
+
+void Client::setOutputHighWaterMark(const qint64 &highWaterMark)
+{
+    m_outputHighWaterMark = highWaterMark;
+}
+
+int Client::maxFrameSize() const
+{
+    return m_maxFrameSize;
+}
+
+void Client::setMaxFrameSize(const int size)
+{
+    m_maxFrameSize = size;
+    applyInputLimits();
+}
+
+int Client::maxInputBufferSize() const
+{
+    return m_maxInputBufferSize;
+}
+
+void Client::setMaxInputBufferSize(const int size)
+{
+    m_maxInputBufferSize = size;
+    applyInputLimits();
+}
+
+int Client::maxPendingRequests() const
+{
+    return m_maxPendingRequests;
+}
+
+void Client::setMaxPendingRequests(const int count)
+{
+    m_maxPendingRequests = qMax(count, 1);
+}
+
+int Client::compressionThreshold() const
+{
+    return m_compressionThreshold;
+}
+
+void Client::setCompressionThreshold(const int size)
+{
+    m_compressionThreshold = size;
+
+    if (m_compressionEnabled)
+    {
+        m_packetHandler.setCompressionThreshold(m_compressionThreshold);
+    }
+}
+
+bool Client::isCompressionEnabled() const
+{
+    return m_compressionEnabled;
+}
+
+qint64 Client::idleTime() const
+{
+    return (currentTime() - m_lastActivityTime.load());
+}
+
+QString Client::peerAddress() const
+{
+    return m_peerAddress;
+}
+
+int Client::keepAliveInterval() const
+{
+    int interval = 0;
+
+    if (m_keepAliveTimer.isActive())
+    {
+        interval = m_keepAliveTimer.interval();
+    }
+
+    return interval;
+}
+
+void Client::setKeepAliveInterval(const int interval)
+{
+    m_keepAliveTimer.stop();
+    m_pendingKeepAliveRequests.clear();
+
+    if (interval > 0)
+    {
+        m_keepAliveTimer.start(interval);
+    }
+}
+
+LatencyHistogram Client::roundTripHistogram() const
+{
+    QMutexLocker locker(&m_roundTripHistogramMutex);
+
+    return m_roundTripHistogram;
+}
+
+void Client::pushPacketData(const QByteArray &packetData)
+{
+    if (!sendPacketData(packetData))
+    {
+        // Error, the packet could not be sent, terminate the connection
+        closeConnection();
+    }
+}
+
+void Client::sendResponse(QSharedPointer<Packets::Packet> response)
+{
+    const Packets::ResponsePacket *responsePacket =
+            dynamic_cast<const Packets::ResponsePacket *>(response.data());
+
+    if (responsePacket != nullptr)
+    {
+        // Send the response only if it matches one of the pending requests
+        if (m_pendingRequests.remove(responsePacket->referenceId()))
+        {
+            if (!sendPacket(*responsePacket))
+            {
+                // Error, the response could not be sent, terminate the connection
+                closeConnection();
+            }
+        }
+    }
+
+    // Resume processing of the received data if it was paused because of too many pending
+    // requests
+    if (m_inputPaused && (!isInputThrottled()))
+    {
+        processReceivedData();
+    }
 }
 
 void Client::handleDisconnect()
@@ -50,13 +250,177 @@ void Client::handleDisconnect()
 
 void Client::processReceivedData()
 {
-    // Read all available data and add it to the parser
-    m_packetHandler.addData(m_socket->readAll());
+    // Any received data means that the client is still active
+    if (m_socket->bytesAvailable() > 0)
+    {
+        m_lastActivityTime.store(currentTime());
+    }
 
-    // Extract packets with the packet parser
-    PacketHandler::Result result = PacketHandler::Result_Error;
+    // Pause processing of the received data while there is too much data waiting to be sent or
+    // while too many requests are waiting for their responses
+    m_inputPaused = isInputThrottled();
+
+    if (!m_inputPaused)
+    {
+        // Process the packets that are already buffered (e.g. the ones left over when processing
+        // was paused) before more data is read
+        PacketHandler::Result result = processBufferedPackets();
+
+        // Read more data while no complete packet is buffered. Only as much data is read as fits
+        // into the packet handler's buffer, the rest stays in the socket's buffer until the
+        // buffered packets are processed.
+        while ((result == PacketHandler::Result_NeedMoreData) && (m_socket->bytesAvailable() > 0))
+        {
+            qint64 readSize = m_socket->bytesAvailable();
+            const int maxBufferSize = m_packetHandler.maxBufferSize();
+
+            if (maxBufferSize > 0)
+            {
+                readSize = qMin(readSize,
+                                static_cast<qint64>(maxBufferSize -
+                                                    m_packetHandler.bufferedDataSize()));
+            }
+
+            if ((readSize > 0LL) && m_packetHandler.addData(m_socket->read(readSize)))
+            {
+                result = processBufferedPackets();
+            }
+            else
+            {
+                // Error, the buffer is full but it doesn't contain a complete packet, terminate
+                // the connection
+                closeConnection();
+                result = PacketHandler::Result_Error;
+            }
+        }
+
+        if (result == PacketHandler::Result_Success)
+        {
+            // Processing was stopped because of too much pending output data or too many pending
+            // requests, it will be resumed when enough data is written to the network or when
+            // enough responses are sent
+            m_inputPaused = true;
+        }
+    }
+}
+
+void Client::flushOutput()
+{
+    m_outputFlushScheduled = false;
+
+    if ((!m_outputQueue.isEmpty()) && m_socket->isOpen())
+    {
+        // Write all of the queued data with a single write
+        const qint64 bytesWritten = m_socket->write(m_outputQueue);
+
+        if (bytesWritten < 0)
+        {
+            // Error, terminate the connection
+            m_outputQueue.clear();
+            m_socket->abort();
+        }
+        else
+        {
+            // Keep the data that was not written, it will be written when the socket notifies
+            // that data was written to the network
+            m_outputQueue.remove(0, static_cast<int>(bytesWritten));
+        }
+    }
+}
+
+void Client::handleBytesWritten(qint64 bytes)
+{
+    Q_UNUSED(bytes);
+
+    // Write the rest of the queued data
+    if (!m_outputQueue.isEmpty())
+    {
+        flushOutput();
+    }
+
+    // Resume processing of the received data when enough of the pending data was written
+    if (m_inputPaused &&
+        (pendingOutputSize() < (m_outputHighWaterMark / 2LL)) &&
+        (m_pendingRequests.size() < m_maxPendingRequests))
+    {
+        processReceivedData();
+    }
+}
+
+void Client::sendKeepAliveRequest()
+{
+    const qint64 time = currentTime();
+
+    // Drop the requests that will not be answered anymore
+    const qint64 maxResponseTime = 4LL * m_keepAliveTimer.interval();
+    QHash<quint32, qint64>::iterator it = m_pendingKeepAliveRequests.begin();
+
+    while (it != m_pendingKeepAliveRequests.end())
+    {
+        if ((time - it.value()) > maxResponseTime)
+        {
+            it = m_pendingKeepAliveRequests.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Send a new request and remember when it was sent, its ID must not collide with any of the
+    // unanswered requests (possible after the packet ID counter wraps around)
+    quint32 packetId = 0U;
 
     do
+    {
+        packetId = PacketHandler::createPacketId();
+    }
+    while (m_pendingKeepAliveRequests.contains(packetId));
+
+    Packets::KeepAliveRequestPacket requestPacket;
+    requestPacket.setId(packetId);
+
+    if (sendPacket(requestPacket))
+    {
+        m_pendingKeepAliveRequests.insert(requestPacket.id(), time);
+    }
+}
+
+qint64 Client::pendingOutputSize() const
+{
+    return m_outputQueue.size() + m_socket->bytesToWrite();
+}
+
+bool Client::isOutputCongested() const
+{
+    return (pendingOutputSize() >= m_outputHighWaterMark);
+}
+
+bool Client::isInputThrottled() const
+{
+    return (isOutputCongested() || (m_pendingRequests.size() >= m_maxPendingRequests));
+}
+
+void Client::closeConnection()
+{
+    // Write the queued data so that it is sent before the connection is closed
+    flushOutput();
+    m_socket->close();
+}
+
+void Client::abortConnection()
+{
+    // Discard the queued data and reset the connection
+    m_outputQueue.clear();
+    m_socket->abort();
+}
+
+PacketHandler::Result Client::processBufferedPackets()
+{
+    PacketHandler::Result result = PacketHandler::Result_Success;
+
+    // Extract packets with the packet parser
+    while ((result == PacketHandler::Result_Success) && (!isInputThrottled()))
     {
         // Parse received data
         result = m_packetHandler.read();
@@ -67,18 +431,19 @@ void Client::processReceivedData()
             {
                 // Process received packet
                 bool success = false;
-                const QScopedPointer<Packets::Packet> packet(m_packetHandler.takePacket());
+                const QSharedPointer<Packets::Packet> packet(m_packetHandler.takePacket());
 
                 if (!packet.isNull())
                 {
-                    success = processReceivedPacket(*packet);
+                    success = processReceivedPacket(packet);
                 }
 
                 if (!success)
                 {
                     // Error, processing of the payload failed
                     // Terminate the connection
-                    m_socket->close();
+                    closeConnection();
+                    result = PacketHandler::Result_Error;
                 }
                 break;
             }
@@ -93,54 +458,156 @@ void Client::processReceivedData()
             default:
             {
                 // Error occurred, terminate the connection
-                m_socket->close();
+                closeConnection();
+                result = PacketHandler::Result_Error;
                 break;
             }
         }
     }
-    // Continue parsing until either an error occurs or more data is needed
-    while (result == PacketHandler::Result_Success);
+
+    return result;
+}
+
+void Client::applyInputLimits()
+{
+    // Limit the socket's own buffer so that a client cannot make it grow while processing of the
+    // received data is paused
+    m_socket->setReadBufferSize(m_maxInputBufferSize);
+
+    // Packet handler also has to fit the unfinished packet that remains from the previous read
+    m_packetHandler.setMaxFrameSize(m_maxFrameSize);
+
+    if ((m_maxInputBufferSize > 0) && (m_maxFrameSize > 0))
+    {
+        m_packetHandler.setMaxBufferSize(m_maxInputBufferSize + m_maxFrameSize + 2);
+    }
+    else
+    {
+        m_packetHandler.setMaxBufferSize(m_maxInputBufferSize);
+    }
+}
+
+qint64 Client::currentTime()
+{
+    // Use a monotonic clock so that changes of the system time don't affect the idle time
+    QElapsedTimer timer;
+    timer.start();
+
+    return timer.msecsSinceReference();
 }
 
 bool Client::sendPacket(const Packets::Packet &packet)
+{
+    return sendPacketData(m_packetHandler.toByteArray(packet));
+}
+
+bool Client::sendPacketData(const QByteArray &packetData)
 {
     bool success = false;
 
-    if (m_socket->isOpen())
+    if (m_socket->isOpen() && (!packetData.isEmpty()) && (!isOutputCongested()))
     {
-        // Write packet
-        const QByteArray packetData = m_packetHandler.toByteArray(packet);
-        const qint64 bytesWritten = m_socket->write(packetData);
+        // Add the packet to the output queue (compressed if it is large enough and if compression
+        // was negotiated with the client)
+        m_outputQueue.append(m_packetHandler.compressFrame(packetData));
+        success = true;
 
-        if (bytesWritten == packetData.size())
+        // Schedule writing of the output queue, all packets queued until then will be coalesced
+        // into a single write
+        if (!m_outputFlushScheduled)
         {
-            success = true;
+            m_outputFlushScheduled = true;
+            QMetaObject::invokeMethod(this, "flushOutput", Qt::QueuedConnection);
         }
     }
 
     return success;
 }
 
-bool Client::processReceivedPacket(const Packets::Packet &packet)
+bool Client::processReceivedPacket(const QSharedPointer<Packets::Packet> &packet)
 {
     bool success = false;
 
     // Check the packet type
-    if (packet.type() == Packets::KeepAliveRequestPacket::staticType())
+    if (packet->type() == Packets::KeepAliveRequestPacket::staticType())
     {
         // Downcast to derived class
         const Packets::KeepAliveRequestPacket *requestPacket =
-                dynamic_cast<const Packets::KeepAliveRequestPacket *>(&packet);
+                dynamic_cast<const Packets::KeepAliveRequestPacket *>(packet.data());
+
+        if (requestPacket != nullptr)
+        {
+            // Send response packet (the response is written from a template since "keep alive"
+            // packets make up most of the traffic)
+            const QByteArray packetData = Packets::KeepAliveResponsePacketWriter::writeFromTemplate(
+                                              PacketHandler::createPacketId(),
+                                              requestPacket->id());
+
+            success = sendPacketData(packetData);
+        }
+    }
+    else if (packet->type() == Packets::KeepAliveResponsePacket::staticType())
+    {
+        // Downcast to derived class
+        const Packets::KeepAliveResponsePacket *responsePacket =
+                dynamic_cast<const Packets::KeepAliveResponsePacket *>(packet.data());
+
+        if (responsePacket != nullptr)
+        {
+            // Record the round-trip time of the matching request (responses to dropped requests
+            // are ignored)
+            const QHash<quint32, qint64>::iterator it =
+                    m_pendingKeepAliveRequests.find(responsePacket->referenceId());
+
+            if (it != m_pendingKeepAliveRequests.end())
+            {
+                const qint64 roundTripTime = currentTime() - it.value();
+                m_pendingKeepAliveRequests.erase(it);
+
+                QMutexLocker locker(&m_roundTripHistogramMutex);
+                m_roundTripHistogram.addSample(roundTripTime);
+            }
+
+            success = true;
+        }
+    }
+    else if (packet->type() == Packets::CompressionRequestPacket::staticType())
+    {
+        // Downcast to derived class
+        const Packets::CompressionRequestPacket *requestPacket =
+                dynamic_cast<const Packets::CompressionRequestPacket *>(packet.data());
 
         if (requestPacket != nullptr)
         {
-            // Prepare packet
-            Packets::KeepAliveResponsePacket responsePacket;
+            // Only "zlib" compression (qCompress) is supported
+            const bool accepted = (requestPacket->algorithm() == QStringLiteral("zlib")) &&
+                                  (m_compressionThreshold > 0);
+
+            // Send response packet (the response itself is never compressed)
+            Packets::CompressionResponsePacket responsePacket;
             responsePacket.setId(PacketHandler::createPacketId());
             responsePacket.setReferenceId(requestPacket->id());
+            responsePacket.setAccepted(accepted);
 
-            // Send packet
             success = sendPacket(responsePacket);
+
+            // Compress all packets that are sent after the response
+            if (success && accepted)
+            {
+                m_compressionEnabled = true;
+                m_packetHandler.setCompressionThreshold(m_compressionThreshold);
+            }
+        }
+    }
+    else
+    {
+        // All other packets are requests that are processed by the server, a request with the same
+        // ID as one of the pending requests is invalid
+        if (!m_pendingRequests.contains(packet->id()))
+        {
+            m_pendingRequests.insert(packet->id());
+            emit requestReceived(this, packet);
+            success = true;
         }
     }
 
@@ -16,10 +16,18 @@
 #ifndef OPENTIMETRACKER_SERVER_CLIENT_HPP
 #define OPENTIMETRACKER_SERVER_CLIENT_HPP
 
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
 #include <QtNetwork/QTcpSocket>
+#include "LatencyHistogram.hpp"
 #include "PacketHandler.hpp"
 #include "Packets/Packet.hpp"
+#include "Packets/ResponsePacket.hpp"
 
 namespace OpenTimeTracker
 {
@@ -42,6 +50,191 @@ public:
      */
     explicit Client(QObject *parent, QTcpSocket *socket);
 
+    /*!
+     * \brief   Gets the output high-water mark
+     *
+     * \return  Output high-water mark (in bytes)
+     */
+    qint64 outputHighWaterMark() const;
+
+    /*!
+     * \brief   Sets the output high-water mark
+     *
+     * \param   highWaterMark   Output high-water mark (in bytes)
+     *
+     * When the amount of data waiting to be sent reaches the high-water mark processing of the
+     * received data is paused and no new packets are accepted for sending. Processing of the
+     * received data is resumed when the amount of data waiting to be sent drops below half of the
+     * high-water mark.
+     */
+    void setOutputHighWaterMark(const qint64 &highWaterMark);
+
+    /*!
+     * \brief   Gets the maximum frame size
+     *
+     * \return  Maximum size of a received packet (in bytes) or zero if it is not limited
+     */
+    int maxFrameSize() const;
+
+    /*!
+     * \brief   Sets the maximum frame size
+     *
+     * \param   size    Maximum size of a received packet (in bytes) or zero to not limit it
+     *
+     * The connection is closed as soon as the client sends a packet that exceeds this size, even
+     * before the end of the packet is received.
+     */
+    void setMaxFrameSize(const int size);
+
+    /*!
+     * \brief   Gets the maximum input buffer size
+     *
+     * \return  Maximum amount of received data that is buffered (in bytes) or zero if it is not
+     *          limited
+     */
+    int maxInputBufferSize() const;
+
+    /*!
+     * \brief   Sets the maximum input buffer size
+     *
+     * \param   size    Maximum amount of received data that is buffered (in bytes) or zero to not
+     *                  limit it
+     *
+     * The connection is closed if the received data doesn't fit into the input buffer.
+     */
+    void setMaxInputBufferSize(const int size);
+
+    /*!
+     * \brief   Gets the maximum number of pending requests
+     *
+     * \return  Maximum number of requests that are processed at the same time
+     */
+    int maxPendingRequests() const;
+
+    /*!
+     * \brief   Sets the maximum number of pending requests
+     *
+     * \param   count   Maximum number of requests that are processed at the same time
+     *
+     * Processing of the received data is paused while the maximum number of requests is waiting for
+     * their responses.
+     */
+    void setMaxPendingRequests(const int count);
+
+    /*!
+     * \brief   Gets the compression threshold
+     *
+     * \return  Packet payload size (in bytes) above which the sent packets are compressed or zero
+     *          if compression is disabled
+     */
+    int compressionThreshold() const;
+
+    /*!
+     * \brief   Sets the compression threshold
+     *
+     * \param   size    Packet payload size (in bytes) above which the sent packets are compressed
+     *                  or zero to disable compression
+     *
+     * Sent packets are compressed only after the client requests compression.
+     */
+    void setCompressionThreshold(const int size);
+
+    /*!
+     * \brief   Checks if the sent packets are compressed
+     *
+     * \retval  true    Compression was negotiated with the client
+     * \retval  false   Compression was not negotiated with the client
+     */
+    bool isCompressionEnabled() const;
+
+    /*!
+     * \brief   Gets the time since data was last received from the client
+     *
+     * \return  Idle time (in milliseconds)
+     *
+     * \note    This method is thread-safe
+     */
+    qint64 idleTime() const;
+
+    /*!
+     * \brief   Gets the address of the client
+     *
+     * \return  Peer address
+     *
+     * \note    This method is thread-safe
+     */
+    QString peerAddress() const;
+
+    /*!
+     * \brief   Gets the keep-alive interval
+     *
+     * \return  Keep-alive interval (in milliseconds)
+     */
+    int keepAliveInterval() const;
+
+    /*!
+     * \brief   Sets the keep-alive interval
+     *
+     * \param   interval    Keep-alive interval (in milliseconds)
+     *
+     * The server sends a "keep alive" request to the client in the specified interval and measures
+     * the round-trip time with the client's response. Sending of "keep alive" requests is disabled
+     * if the interval is zero.
+     */
+    void setKeepAliveInterval(const int interval);
+
+    /*!
+     * \brief   Gets the histogram of the measured round-trip times
+     *
+     * \return  Round-trip time histogram
+     *
+     * \note    This method is thread-safe
+     */
+    LatencyHistogram roundTripHistogram() const;
+
+public slots:
+    /*!
+     * \brief   Sends packet data that was pushed by the server
+     *
+     * \param   packetData  Packet data
+     *
+     * If the packet data cannot be sent (e.g. because the client does not read its data fast
+     * enough) the connection is closed.
+     *
+     * \note    This is intended to be invoked from other threads through a queued connection
+     */
+    void pushPacketData(const QByteArray &packetData);
+
+    /*!
+     * \brief   Writes all queued output data and closes the connection
+     *
+     * \note    This can be invoked from other threads through a queued connection
+     */
+    void closeConnection();
+
+    /*!
+     * \brief   Aborts the connection immediately
+     *
+     * All queued output data is discarded and the socket is reset without waiting for the peer.
+     * This is used for connections whose peer may no longer be reachable (e.g. idle connections)
+     * since a graceful close would keep the socket open until all pending data is acknowledged.
+     *
+     * \note    This can be invoked from other threads through a queued connection
+     */
+    void abortConnection();
+
+    /*!
+     * \brief   Sends the response to one of the pending requests
+     *
+     * \param   response    Response packet
+     *
+     * The response is matched with the pending request by its reference ID, responses that don't
+     * match any of the pending requests are dropped. Responses can be sent in any order.
+     *
+     * \note    This is intended to be invoked from other threads through a queued connection
+     */
+    void sendResponse(QSharedPointer<Packets::Packet> response);
+
 signals:
     /*!
      * \brief   Notification that the client's socket was disconnected
@@ -50,6 +243,16 @@ signals:
      */
     void disconnected(Client *client);
 
+    /*!
+     * \brief   Notification that a request was received which has to be processed by the server
+     *
+     * \param   client  Pointer to the instance of the client object that received the request
+     * \param   request Request packet
+     *
+     * The response shall be sent with Client::sendResponse().
+     */
+    void requestReceived(Client *client, QSharedPointer<Packets::Packet> request);
+
 private slots:
     /*!
      * \brief   Handles the situation when the socket is disconnected
@@ -63,7 +266,67 @@ private slots:
      */
     void processReceivedData();
 
+    /*!
+     * \brief   Writes all queued output data to the socket
+     *
+     * This is executed once per event loop iteration so that all packets queued in the same
+     * iteration are written to the socket with a single write.
+     */
+    void flushOutput();
+
+    /*!
+     * \brief   Handles the situation when data was written to the network
+     *
+     * \param   bytes   Number of bytes that were written
+     *
+     * Writes the rest of the queued output data and resumes processing of the received data if it
+     * was paused because of too much pending output data.
+     */
+    void handleBytesWritten(qint64 bytes);
+
+    /*!
+     * \brief   Sends a "keep alive" request to the client
+     *
+     * Requests that were not answered in four keep-alive intervals are dropped.
+     */
+    void sendKeepAliveRequest();
+
 private:
+    /*!
+     * \brief   Gets the amount of data waiting to be sent
+     *
+     * \return  Amount of data (in bytes)
+     */
+    qint64 pendingOutputSize() const;
+
+    /*!
+     * \brief   Checks if there is too much data waiting to be sent
+     *
+     * \retval  true    Output high-water mark is reached
+     * \retval  false   Output high-water mark is not reached
+     */
+    bool isOutputCongested() const;
+
+    /*!
+     * \brief   Checks if processing of the received data has to be paused
+     *
+     * \retval  true    Too much data is waiting to be sent or too many requests are pending
+     * \retval  false   Received data can be processed
+     */
+    bool isInputThrottled() const;
+
+    /*!
+     * \brief   Applies the input limits to the socket and to the packet handler
+     */
+    void applyInputLimits();
+
+    /*!
+     * \brief   Gets the current value of the monotonic clock
+     *
+     * \return  Current time (in milliseconds)
+     */
+    static qint64 currentTime();
+
     /*!
      * \brief   Sends packet to the server
      *
@@ -74,6 +337,19 @@ private:
      */
     bool sendPacket(const Packets::Packet &packet);
 
+    /*!
+     * \brief   Sends already written packet data to the server
+     *
+     * \param   packetData  Packet data
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * The packet data is added to the output queue which is written to the socket in the next
+     * event loop iteration. Sending fails if the output high-water mark is reached.
+     */
+    bool sendPacketData(const QByteArray &packetData);
+
     /*!
      * \brief   Processes received packet
      *
@@ -82,7 +358,16 @@ private:
      * \retval  true    Success
      * \retval  false   Error
      */
-    bool processReceivedPacket(const Packets::Packet &packet);
+    bool processReceivedPacket(const QSharedPointer<Packets::Packet> &packet);
+
+    /*!
+     * \brief   Extracts and processes the packets that are already in the packet handler's buffer
+     *
+     * \return  Result_Success      Processing was stopped because the input is throttled
+     * \return  Result_NeedMoreData All complete packets were processed
+     * \return  Result_Error        Processing failed and the connection is being closed
+     */
+    PacketHandler::Result processBufferedPackets();
 
     /*!
      * \brief   Holds the TCP socket
@@ -93,6 +378,88 @@ private:
      * \brief   Holds the packet handler
      */
     PacketHandler m_packetHandler;
+
+    /*!
+     * \brief   Holds the output data that is waiting to be written to the socket
+     */
+    QByteArray m_outputQueue;
+
+    /*!
+     * \brief   Holds the flag that indicates if writing of the output queue is already scheduled
+     */
+    bool m_outputFlushScheduled;
+
+    /*!
+     * \brief   Holds the output high-water mark (in bytes)
+     */
+    qint64 m_outputHighWaterMark;
+
+    /*!
+     * \brief   Holds the maximum size of a received packet (in bytes)
+     */
+    int m_maxFrameSize;
+
+    /*!
+     * \brief   Holds the maximum amount of received data that is buffered (in bytes)
+     */
+    int m_maxInputBufferSize;
+
+    /*!
+     * \brief   Holds the IDs of the requests that are waiting for their responses
+     */
+    QSet<quint32> m_pendingRequests;
+
+    /*!
+     * \brief   Holds the maximum number of pending requests
+     */
+    int m_maxPendingRequests;
+
+    /*!
+     * \brief   Holds the flag that indicates if processing of the received data is paused
+     */
+    bool m_inputPaused;
+
+    /*!
+     * \brief   Holds the packet payload size (in bytes) above which the sent packets are compressed
+     */
+    int m_compressionThreshold;
+
+    /*!
+     * \brief   Holds the flag that indicates if compression was negotiated with the client
+     */
+    bool m_compressionEnabled;
+
+    /*!
+     * \brief   Holds the time when data was last received from the client (in milliseconds)
+     *
+     * \note    This is read by the server's thread to detect idle clients
+     */
+    QAtomicInteger<qint64> m_lastActivityTime;
+
+    /*!
+     * \brief   Holds the address of the client
+     */
+    const QString m_peerAddress;
+
+    /*!
+     * \brief   Holds the timer for sending "keep alive" requests
+     */
+    QTimer m_keepAliveTimer;
+
+    /*!
+     * \brief   Holds the time when each unanswered "keep alive" request was sent (by packet ID)
+     */
+    QHash<quint32, qint64> m_pendingKeepAliveRequests;
+
+    /*!
+     * \brief   Holds the mutex that protects the round-trip time histogram
+     */
+    mutable QMutex m_roundTripHistogramMutex;
+
+    /*!
+     * \brief   Holds the histogram of the measured round-trip times
+     */
+    LatencyHistogram m_roundTripHistogram;
 };
 
 }
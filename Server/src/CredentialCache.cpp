@@ -0,0 +1,118 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QUuid>
+#include "CredentialCache.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+CredentialCache::CredentialCache()
+    : m_credentials(),
+      m_userNames()
+{
+}
+
+int CredentialCache::size() const
+{
+    return m_credentials.size();
+}
+
+void CredentialCache::clear()
+{
+    m_credentials.clear();
+    m_userNames.clear();
+}
+
+void CredentialCache::addUser(const User &user)
+{
+    // Remove the old credentials (the user's name could have changed)
+    removeUser(user.id());
+
+    // Add the credentials of the enabled user
+    if (user.isValid() && (!user.password().isEmpty()))
+    {
+        Credentials credentials;
+        credentials.userId = user.id();
+        credentials.salt = QUuid::createUuid().toRfc4122();
+        credentials.hash = hashPassword(credentials.salt, user.password());
+
+        m_credentials.insert(user.name(), credentials);
+        m_userNames.insert(user.id(), user.name());
+    }
+}
+
+void CredentialCache::removeUser(const qint64 &userId)
+{
+    const QHash<qint64, QString>::iterator it = m_userNames.find(userId);
+
+    if (it != m_userNames.end())
+    {
+        m_credentials.remove(it.value());
+        m_userNames.erase(it);
+    }
+}
+
+qint64 CredentialCache::verify(const QString &name, const QString &password) const
+{
+    qint64 userId = 0LL;
+    const QHash<QString, Credentials>::const_iterator it = m_credentials.constFind(name);
+
+    if (it != m_credentials.constEnd())
+    {
+        if ((!password.isEmpty()) &&
+            constantTimeEquals(hashPassword(it.value().salt, password), it.value().hash))
+        {
+            userId = it.value().userId;
+        }
+    }
+    else
+    {
+        // Hash the password also for unknown users so that the response time doesn't reveal which
+        // user names exist
+        hashPassword(QByteArray(16, '\0'), password);
+    }
+
+    return userId;
+}
+
+QByteArray CredentialCache::hashPassword(const QByteArray &salt, const QString &password)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(salt);
+    hash.addData(password.toUtf8());
+
+    return hash.result();
+}
+
+bool CredentialCache::constantTimeEquals(const QByteArray &left, const QByteArray &right)
+{
+    bool equal = false;
+
+    if (left.size() == right.size())
+    {
+        // Compare all bytes without stopping at the first difference
+        char difference = 0;
+
+        for (int i = 0; i < left.size(); i++)
+        {
+            difference |= static_cast<char>(left.at(i) ^ right.at(i));
+        }
+
+        equal = (difference == 0);
+    }
+
+    return equal;
+}
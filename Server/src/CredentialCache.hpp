@@ -0,0 +1,132 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_CREDENTIALCACHE_HPP
+#define OPENTIMETRACKER_SERVER_CREDENTIALCACHE_HPP
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include "User.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   In-memory index of the users' credentials
+ *
+ * Passwords are not kept in plain text: for each enabled user only a random salt and the SHA-256
+ * hash of the salted password are stored, indexed by the user's name. Verifying the credentials
+ * therefore needs only a hash lookup, hashing of the given password and a constant-time comparison
+ * of the hashes, without any database queries.
+ *
+ * Users with an empty password are disabled and can't be verified.
+ */
+class CredentialCache
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    CredentialCache();
+
+    /*!
+     * \brief   Gets the number of users in the cache
+     *
+     * \return  Number of users
+     */
+    int size() const;
+
+    /*!
+     * \brief   Removes all users from the cache
+     */
+    void clear();
+
+    /*!
+     * \brief   Adds the user's credentials to the cache
+     *
+     * \param   user    User
+     *
+     * Credentials that are already cached for the same user are replaced. A disabled user is
+     * removed from the cache instead.
+     */
+    void addUser(const User &user);
+
+    /*!
+     * \brief   Removes the user's credentials from the cache
+     *
+     * \param   userId  ID of the user
+     */
+    void removeUser(const qint64 &userId);
+
+    /*!
+     * \brief   Verifies the user's credentials
+     *
+     * \param   name        User's name
+     * \param   password    User's password
+     *
+     * \return  ID of the user or zero if the credentials are not valid
+     */
+    qint64 verify(const QString &name, const QString &password) const;
+
+private:
+    /*!
+     * \brief   Holds the cached credentials of a single user
+     */
+    struct Credentials
+    {
+        qint64 userId;          /*!< User ID */
+        QByteArray salt;        /*!< Random salt */
+        QByteArray hash;        /*!< Hash of the salted password */
+    };
+
+    /*!
+     * \brief   Calculates the hash of the salted password
+     *
+     * \param   salt        Salt
+     * \param   password    Password
+     *
+     * \return  Hash
+     */
+    static QByteArray hashPassword(const QByteArray &salt, const QString &password);
+
+    /*!
+     * \brief   Compares two byte arrays in a time that doesn't depend on their contents
+     *
+     * \param   left    Byte array
+     * \param   right   Byte array
+     *
+     * \retval  true    Byte arrays are equal
+     * \retval  false   Byte arrays are not equal
+     */
+    static bool constantTimeEquals(const QByteArray &left, const QByteArray &right);
+
+    /*!
+     * \brief   Holds the credentials by user name
+     */
+    QHash<QString, Credentials> m_credentials;
+
+    /*!
+     * \brief   Holds the user names by user ID
+     */
+    QHash<qint64, QString> m_userNames;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_CREDENTIALCACHE_HPP
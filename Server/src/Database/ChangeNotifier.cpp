@@ -0,0 +1,232 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ChangeNotifier.hpp"
+
+using namespace OpenTimeTracker::Server::Database;
+
+ChangeNotifier *ChangeNotifier::instance()
+{
+    static ChangeNotifier notifier;
+
+    return &notifier;
+}
+
+void ChangeNotifier::reportUserAdded(const qint64 &userId,
+                                     const QString &name,
+                                     const QString &password)
+{
+    report(Change_UserAdded, QList<QVariant>() << userId << name << password);
+}
+
+void ChangeNotifier::reportUserNameChanged(const qint64 &userId, const QString &newName)
+{
+    report(Change_UserNameChanged, QList<QVariant>() << userId << newName);
+}
+
+void ChangeNotifier::reportUserPasswordChanged(const qint64 &userId, const QString &newPassword)
+{
+    report(Change_UserPasswordChanged, QList<QVariant>() << userId << newPassword);
+}
+
+void ChangeNotifier::reportUserGroupAdded(const qint64 &userGroupId, const QString &name)
+{
+    report(Change_UserGroupAdded, QList<QVariant>() << userGroupId << name);
+}
+
+void ChangeNotifier::reportUserGroupNameChanged(const qint64 &userGroupId, const QString &newName)
+{
+    report(Change_UserGroupNameChanged, QList<QVariant>() << userGroupId << newName);
+}
+
+void ChangeNotifier::reportUserMappingAdded(const qint64 &userMappingId,
+                                            const qint64 &userGroupId,
+                                            const qint64 &userId)
+{
+    report(Change_UserMappingAdded, QList<QVariant>() << userMappingId << userGroupId << userId);
+}
+
+void ChangeNotifier::reportUserMappingRemoved(const qint64 &userMappingId)
+{
+    report(Change_UserMappingRemoved, QList<QVariant>() << userMappingId);
+}
+
+void ChangeNotifier::reportWorkingDayAdded(const qint64 &workingDayId,
+                                           const QDateTime &startTimestamp,
+                                           const QDateTime &endTimestamp)
+{
+    report(Change_WorkingDayAdded,
+           QList<QVariant>() << workingDayId << startTimestamp << endTimestamp);
+}
+
+void ChangeNotifier::reportScheduleAdded(const qint64 &scheduleId,
+                                         const qint64 &userId,
+                                         const QDateTime &startTimestamp,
+                                         const QDateTime &endTimestamp)
+{
+    report(Change_ScheduleAdded,
+           QList<QVariant>() << scheduleId << userId << startTimestamp << endTimestamp);
+}
+
+void ChangeNotifier::reportScheduleRemoved(const qint64 &scheduleId)
+{
+    report(Change_ScheduleRemoved, QList<QVariant>() << scheduleId);
+}
+
+void ChangeNotifier::reportScheduleTemplateChanged(const qint64 &scheduleTemplateId)
+{
+    report(Change_ScheduleTemplateChanged, QList<QVariant>() << scheduleTemplateId);
+}
+
+void ChangeNotifier::reportSettingChanged(const QString &name, const QVariant &value)
+{
+    report(Change_SettingChanged, QList<QVariant>() << name << value);
+}
+
+void ChangeNotifier::beginTransaction()
+{
+    m_transactionActive = true;
+    m_pendingChanges.clear();
+}
+
+void ChangeNotifier::commitTransaction()
+{
+    // Take the pending changes first so that the slots can already start a new transaction
+    const QList<QPair<Change, QList<QVariant> > > pendingChanges = m_pendingChanges;
+    m_transactionActive = false;
+    m_pendingChanges.clear();
+
+    for (int i = 0; i < pendingChanges.size(); i++)
+    {
+        emitChange(pendingChanges.at(i).first, pendingChanges.at(i).second);
+    }
+}
+
+void ChangeNotifier::rollbackTransaction()
+{
+    m_transactionActive = false;
+    m_pendingChanges.clear();
+}
+
+ChangeNotifier::ChangeNotifier()
+    : QObject(),
+      m_transactionActive(false),
+      m_pendingChanges()
+{
+}
+
+void ChangeNotifier::report(const Change change, const QList<QVariant> &arguments)
+{
+    if (m_transactionActive)
+    {
+        m_pendingChanges.append(qMakePair(change, arguments));
+    }
+    else
+    {
+        emitChange(change, arguments);
+    }
+}
+
+void ChangeNotifier::emitChange(const Change change, const QList<QVariant> &arguments)
+{
+    switch (change)
+    {
+        case Change_UserAdded:
+        {
+            emit userAdded(arguments.at(0).toLongLong(),
+                           arguments.at(1).toString(),
+                           arguments.at(2).toString());
+            break;
+        }
+
+        case Change_UserNameChanged:
+        {
+            emit userNameChanged(arguments.at(0).toLongLong(), arguments.at(1).toString());
+            break;
+        }
+
+        case Change_UserPasswordChanged:
+        {
+            emit userPasswordChanged(arguments.at(0).toLongLong(), arguments.at(1).toString());
+            break;
+        }
+
+        case Change_UserGroupAdded:
+        {
+            emit userGroupAdded(arguments.at(0).toLongLong(), arguments.at(1).toString());
+            break;
+        }
+
+        case Change_UserGroupNameChanged:
+        {
+            emit userGroupNameChanged(arguments.at(0).toLongLong(), arguments.at(1).toString());
+            break;
+        }
+
+        case Change_UserMappingAdded:
+        {
+            emit userMappingAdded(arguments.at(0).toLongLong(),
+                                  arguments.at(1).toLongLong(),
+                                  arguments.at(2).toLongLong());
+            break;
+        }
+
+        case Change_UserMappingRemoved:
+        {
+            emit userMappingRemoved(arguments.at(0).toLongLong());
+            break;
+        }
+
+        case Change_WorkingDayAdded:
+        {
+            emit workingDayAdded(arguments.at(0).toLongLong(),
+                                 arguments.at(1).toDateTime(),
+                                 arguments.at(2).toDateTime());
+            break;
+        }
+
+        case Change_ScheduleAdded:
+        {
+            emit scheduleAdded(arguments.at(0).toLongLong(),
+                               arguments.at(1).toLongLong(),
+                               arguments.at(2).toDateTime(),
+                               arguments.at(3).toDateTime());
+            break;
+        }
+
+        case Change_ScheduleRemoved:
+        {
+            emit scheduleRemoved(arguments.at(0).toLongLong());
+            break;
+        }
+
+        case Change_ScheduleTemplateChanged:
+        {
+            emit scheduleTemplateChanged(arguments.at(0).toLongLong());
+            break;
+        }
+
+        case Change_SettingChanged:
+        {
+            emit settingChanged(arguments.at(0).toString(), arguments.at(1));
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
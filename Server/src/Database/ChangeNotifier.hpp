@@ -0,0 +1,346 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_DATABASE_CHANGENOTIFIER_HPP
+#define OPENTIMETRACKER_SERVER_DATABASE_CHANGENOTIFIER_HPP
+
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Database
+{
+
+/*!
+ * \brief   Notifies about the changes written to the database
+ *
+ * The database management classes report each successful change to the notifier, which emits a
+ * matching signal so that in-memory caches can apply the change incrementally instead of reading
+ * everything from the database again.
+ *
+ * Signals are only emitted for committed changes: a change made outside of a transaction is
+ * reported immediately, while changes made inside of a transaction are held back until the
+ * transaction is committed and are dropped if it is rolled back.
+ *
+ * \note    The notifier shall only be used in the thread that accesses the database
+ */
+class ChangeNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief   Gets the notifier instance
+     *
+     * \return  Notifier instance
+     */
+    static ChangeNotifier *instance();
+
+    /*!
+     * \brief   Reports that a user was added
+     *
+     * \param   userId      ID of the user
+     * \param   name        Name of the user
+     * \param   password    Password of the user
+     */
+    void reportUserAdded(const qint64 &userId, const QString &name, const QString &password);
+
+    /*!
+     * \brief   Reports that a user's name was changed
+     *
+     * \param   userId  ID of the user
+     * \param   newName New name of the user
+     */
+    void reportUserNameChanged(const qint64 &userId, const QString &newName);
+
+    /*!
+     * \brief   Reports that a user's password was changed
+     *
+     * \param   userId      ID of the user
+     * \param   newPassword New password of the user
+     */
+    void reportUserPasswordChanged(const qint64 &userId, const QString &newPassword);
+
+    /*!
+     * \brief   Reports that a user group was added
+     *
+     * \param   userGroupId ID of the user group
+     * \param   name        Name of the user group
+     */
+    void reportUserGroupAdded(const qint64 &userGroupId, const QString &name);
+
+    /*!
+     * \brief   Reports that a user group's name was changed
+     *
+     * \param   userGroupId ID of the user group
+     * \param   newName     New name of the user group
+     */
+    void reportUserGroupNameChanged(const qint64 &userGroupId, const QString &newName);
+
+    /*!
+     * \brief   Reports that a user mapping was added
+     *
+     * \param   userMappingId   ID of the user mapping
+     * \param   userGroupId     ID of the user group
+     * \param   userId          ID of the user
+     */
+    void reportUserMappingAdded(const qint64 &userMappingId,
+                                const qint64 &userGroupId,
+                                const qint64 &userId);
+
+    /*!
+     * \brief   Reports that a user mapping was removed
+     *
+     * \param   userMappingId   ID of the user mapping
+     */
+    void reportUserMappingRemoved(const qint64 &userMappingId);
+
+    /*!
+     * \brief   Reports that a working day was added
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   startTimestamp  Start of the working day
+     * \param   endTimestamp    End of the working day
+     */
+    void reportWorkingDayAdded(const qint64 &workingDayId,
+                               const QDateTime &startTimestamp,
+                               const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Reports that a schedule was added
+     *
+     * \param   scheduleId      ID of the schedule
+     * \param   userId          ID of the user
+     * \param   startTimestamp  Start of the schedule
+     * \param   endTimestamp    End of the schedule
+     */
+    void reportScheduleAdded(const qint64 &scheduleId,
+                             const qint64 &userId,
+                             const QDateTime &startTimestamp,
+                             const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Reports that a schedule was removed
+     *
+     * \param   scheduleId  ID of the schedule
+     */
+    void reportScheduleRemoved(const qint64 &scheduleId);
+
+    /*!
+     * \brief   Reports that a schedule template or its exceptions were changed
+     *
+     * \param   scheduleTemplateId  ID of the schedule template
+     */
+    void reportScheduleTemplateChanged(const qint64 &scheduleTemplateId);
+
+    /*!
+     * \brief   Reports that a setting was added or changed
+     *
+     * \param   name    Name of the setting
+     * \param   value   New value of the setting
+     */
+    void reportSettingChanged(const QString &name, const QVariant &value);
+
+    /*!
+     * \brief   Starts holding back the reported changes
+     *
+     * \note    This is called by DatabaseManagement when a transaction is started
+     */
+    void beginTransaction();
+
+    /*!
+     * \brief   Emits all changes that were held back
+     *
+     * \note    This is called by DatabaseManagement when a transaction is committed
+     */
+    void commitTransaction();
+
+    /*!
+     * \brief   Drops all changes that were held back
+     *
+     * \note    This is called by DatabaseManagement when a transaction is rolled back
+     */
+    void rollbackTransaction();
+
+signals:
+    /*!
+     * \brief   Notification that a user was added
+     *
+     * \param   userId      ID of the user
+     * \param   name        Name of the user
+     * \param   password    Password of the user
+     */
+    void userAdded(const qint64 &userId, const QString &name, const QString &password);
+
+    /*!
+     * \brief   Notification that a user's name was changed
+     *
+     * \param   userId  ID of the user
+     * \param   newName New name of the user
+     */
+    void userNameChanged(const qint64 &userId, const QString &newName);
+
+    /*!
+     * \brief   Notification that a user's password was changed
+     *
+     * \param   userId      ID of the user
+     * \param   newPassword New password of the user
+     */
+    void userPasswordChanged(const qint64 &userId, const QString &newPassword);
+
+    /*!
+     * \brief   Notification that a user group was added
+     *
+     * \param   userGroupId ID of the user group
+     * \param   name        Name of the user group
+     */
+    void userGroupAdded(const qint64 &userGroupId, const QString &name);
+
+    /*!
+     * \brief   Notification that a user group's name was changed
+     *
+     * \param   userGroupId ID of the user group
+     * \param   newName     New name of the user group
+     */
+    void userGroupNameChanged(const qint64 &userGroupId, const QString &newName);
+
+    /*!
+     * \brief   Notification that a user mapping was added
+     *
+     * \param   userMappingId   ID of the user mapping
+     * \param   userGroupId     ID of the user group
+     * \param   userId          ID of the user
+     */
+    void userMappingAdded(const qint64 &userMappingId,
+                          const qint64 &userGroupId,
+                          const qint64 &userId);
+
+    /*!
+     * \brief   Notification that a user mapping was removed
+     *
+     * \param   userMappingId   ID of the user mapping
+     */
+    void userMappingRemoved(const qint64 &userMappingId);
+
+    /*!
+     * \brief   Notification that a working day was added
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   startTimestamp  Start of the working day
+     * \param   endTimestamp    End of the working day
+     */
+    void workingDayAdded(const qint64 &workingDayId,
+                         const QDateTime &startTimestamp,
+                         const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Notification that a schedule was added
+     *
+     * \param   scheduleId      ID of the schedule
+     * \param   userId          ID of the user
+     * \param   startTimestamp  Start of the schedule
+     * \param   endTimestamp    End of the schedule
+     */
+    void scheduleAdded(const qint64 &scheduleId,
+                       const qint64 &userId,
+                       const QDateTime &startTimestamp,
+                       const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Notification that a schedule was removed
+     *
+     * \param   scheduleId  ID of the schedule
+     */
+    void scheduleRemoved(const qint64 &scheduleId);
+
+    /*!
+     * \brief   Notification that a schedule template or its exceptions were changed
+     *
+     * \param   scheduleTemplateId  ID of the schedule template
+     */
+    void scheduleTemplateChanged(const qint64 &scheduleTemplateId);
+
+    /*!
+     * \brief   Notification that a setting was added or changed
+     *
+     * \param   name    Name of the setting
+     * \param   value   New value of the setting
+     */
+    void settingChanged(const QString &name, const QVariant &value);
+
+private:
+    /*!
+     * \brief   Enumerates the types of changes
+     */
+    enum Change
+    {
+        Change_UserAdded,               /*!< User was added */
+        Change_UserNameChanged,         /*!< User's name was changed */
+        Change_UserPasswordChanged,     /*!< User's password was changed */
+        Change_UserGroupAdded,          /*!< User group was added */
+        Change_UserGroupNameChanged,    /*!< User group's name was changed */
+        Change_UserMappingAdded,        /*!< User mapping was added */
+        Change_UserMappingRemoved,      /*!< User mapping was removed */
+        Change_WorkingDayAdded,         /*!< Working day was added */
+        Change_ScheduleAdded,           /*!< Schedule was added */
+        Change_ScheduleRemoved,         /*!< Schedule was removed */
+        Change_ScheduleTemplateChanged, /*!< Schedule template was changed */
+        Change_SettingChanged           /*!< Setting was added or changed */
+    };
+
+    /*!
+     * \brief   Constructor is private, use ChangeNotifier::instance()
+     */
+    ChangeNotifier();
+
+    /*!
+     * \brief   Emits the change or holds it back until the transaction is committed
+     *
+     * \param   change      Type of the change
+     * \param   arguments   Arguments of the change's signal
+     */
+    void report(const Change change, const QList<QVariant> &arguments);
+
+    /*!
+     * \brief   Emits the signal for the change
+     *
+     * \param   change      Type of the change
+     * \param   arguments   Arguments of the change's signal
+     */
+    void emitChange(const Change change, const QList<QVariant> &arguments);
+
+    /*!
+     * \brief   Holds the flag that indicates if a transaction is in progress
+     */
+    bool m_transactionActive;
+
+    /*!
+     * \brief   Holds the changes that are held back until the transaction is committed
+     */
+    QList<QPair<Change, QList<QVariant> > > m_pendingChanges;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_DATABASE_CHANGENOTIFIER_HPP
@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "DatabaseManagement.hpp"
+#include "ChangeNotifier.hpp"
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlQuery>
 #include <QtSql/QSqlRecord>
@@ -24,7 +25,7 @@
 
 using namespace OpenTimeTracker::Server::Database;
 
-const qint32 DatabaseManagement::m_version = 1;
+const qint32 DatabaseManagement::m_version = 2;
 const QString DatabaseManagement::m_connectionName("OpenTimeTracker::Server");
 
 bool DatabaseManagement::isConnected()
@@ -111,6 +112,11 @@ bool DatabaseManagement::connect(const QString &databaseFilePath)
                         success = initialize();
                     }
                 }
+                else if (databaseVersion < m_version)
+                {
+                    // Older database version detected, upgrade it
+                    success = upgrade(databaseVersion);
+                }
                 else
                 {
                     // Error, unsupported version
@@ -143,6 +149,11 @@ bool DatabaseManagement::beginTransaction()
     if (isConnected())
     {
         success = database().transaction();
+
+        if (success)
+        {
+            ChangeNotifier::instance()->beginTransaction();
+        }
     }
 
     return success;
@@ -155,6 +166,11 @@ bool DatabaseManagement::commitTransaction()
     if (isConnected())
     {
         success = database().commit();
+
+        if (success)
+        {
+            ChangeNotifier::instance()->commitTransaction();
+        }
     }
 
     return success;
@@ -169,6 +185,9 @@ bool DatabaseManagement::rollbackTransaction()
         success = database().rollback();
     }
 
+    // Pending changes are dropped even if the rollback failed since they were never committed
+    ChangeNotifier::instance()->rollbackTransaction();
+
     return success;
 }
 
@@ -214,7 +233,8 @@ QStringList DatabaseManagement::readSqlCommandsFromResource(const QString &comma
 bool DatabaseManagement::executeSqlCommand(const QString &command,
                                            const QMap<QString, QVariant> &values,
                                            QList<QMap<QString, QVariant> > *results,
-                                           int *rowsAffected)
+                                           int *rowsAffected,
+                                           QVariant *lastInsertId)
 {
     bool success = false;
 
@@ -276,6 +296,96 @@ bool DatabaseManagement::executeSqlCommand(const QString &command,
             {
                 *rowsAffected = query.numRowsAffected();
             }
+
+            // Optionally get the ID of the inserted row
+            if (lastInsertId != nullptr)
+            {
+                *lastInsertId = query.lastInsertId();
+            }
+        }
+    }
+
+    return success;
+}
+
+bool DatabaseManagement::executeSqlCommandBatch(const QString &command,
+                                                const QList<QMap<QString, QVariant> > &valuesList,
+                                                QList<QVariant> *lastInsertIds,
+                                                QStringList *errors)
+{
+    bool success = false;
+
+    if (lastInsertIds != nullptr)
+    {
+        lastInsertIds->clear();
+    }
+
+    if (errors != nullptr)
+    {
+        errors->clear();
+    }
+
+    if (isConnected() && (!command.isEmpty()))
+    {
+        // Prepare SQL command only once for all value sets
+        QSqlQuery query(database());
+
+        if (query.prepare(command))
+        {
+            success = true;
+            const QList<QString> keys = query.boundValues().keys();
+
+            foreach (const QMap<QString, QVariant> &values, valuesList)
+            {
+                // Bind all needed values
+                QString error;
+
+                foreach (const QString &key, keys)
+                {
+                    if (values.contains(key))
+                    {
+                        // Bind value
+                        query.bindValue(key, values[key]);
+                    }
+                    else
+                    {
+                        // Error, missing value
+                        error = QStringLiteral("Missing value: ") + key;
+                        break;
+                    }
+                }
+
+                // Execute SQL command
+                QVariant lastInsertId;
+
+                if (error.isEmpty())
+                {
+                    if (query.exec())
+                    {
+                        lastInsertId = query.lastInsertId();
+                    }
+                    else
+                    {
+                        error = query.lastError().text();
+                    }
+                }
+
+                if (!error.isEmpty())
+                {
+                    success = false;
+                }
+
+                // Optionally report the result of the execution
+                if (lastInsertIds != nullptr)
+                {
+                    lastInsertIds->append(lastInsertId);
+                }
+
+                if (errors != nullptr)
+                {
+                    errors->append(error);
+                }
+            }
         }
     }
 
@@ -341,6 +451,18 @@ bool DatabaseManagement::initialize()
             success = createTable(QStringLiteral("Schedules"));
         }
 
+        // Create table: ScheduleTemplates
+        if (success)
+        {
+            success = createTable(QStringLiteral("ScheduleTemplates"));
+        }
+
+        // Create table: ScheduleTemplateExceptions
+        if (success)
+        {
+            success = createTable(QStringLiteral("ScheduleTemplateExceptions"));
+        }
+
         // Create table: Events
         if (success)
         {
@@ -365,6 +487,47 @@ bool DatabaseManagement::initialize()
     return success;
 }
 
+bool DatabaseManagement::upgrade(const qint32 databaseVersion)
+{
+    bool success = false;
+
+    if (isConnected() && (0 < databaseVersion) && (databaseVersion < m_version))
+    {
+        success = beginTransaction();
+
+        // Version 2: tables for the recurring schedule templates
+        if (success && (databaseVersion < 2))
+        {
+            success = createTable(QStringLiteral("ScheduleTemplates"));
+
+            if (success)
+            {
+                success = createTable(QStringLiteral("ScheduleTemplateExceptions"));
+            }
+        }
+
+        // Write the database version
+        if (success)
+        {
+            success = writeVersion();
+        }
+
+        // Finish the transaction
+        if (success)
+        {
+            // No error occurred, commit the transaction
+            success = commitTransaction();
+        }
+        else
+        {
+            // On error rollback the transaction
+            rollbackTransaction();
+        }
+    }
+
+    return success;
+}
+
 qint32 DatabaseManagement::readVersion()
 {
     // Initialize the version to an invalid value
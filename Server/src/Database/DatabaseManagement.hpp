@@ -111,6 +111,8 @@ public:
      * \param   results         Optional parameter for results of the executed command
      * \param   rowsAffected    Optional parameter for number of affected rows of the executed
      *                          command
+     * \param   lastInsertId    Optional parameter for the ID of the row inserted by the executed
+     *                          command
      *
      * \retval  true    Success
      * \retval  false   Error
@@ -120,7 +122,30 @@ public:
     static bool executeSqlCommand(const QString &command,
                                   const QMap<QString, QVariant> &values = QMap<QString, QVariant>(),
                                   QList<QMap<QString, QVariant> > *results = nullptr,
-                                  int *rowsAffected = nullptr);
+                                  int *rowsAffected = nullptr,
+                                  QVariant *lastInsertId = nullptr);
+
+    /*!
+     * \brief   Executes the same SQL command for each set of values
+     *
+     * \param   command         SQL command
+     * \param   valuesList      List of value sets, the command is executed once for each of them
+     * \param   lastInsertIds   Optional parameter for the ID of the row inserted for each value set
+     *                          (invalid if the execution failed)
+     * \param   errors          Optional parameter for the error of each value set (empty if the
+     *                          execution succeeded)
+     *
+     * \retval  true    Success, the command was executed successfully for all value sets
+     * \retval  false   Error, the command couldn't be prepared or failed for some value sets
+     *
+     * The command is prepared only once and the prepared statement is reused for all value sets.
+     * A failed execution doesn't stop the execution for the remaining value sets so that all
+     * errors (e.g. constraint violations) are reported at once.
+     */
+    static bool executeSqlCommandBatch(const QString &command,
+                                       const QList<QMap<QString, QVariant> > &valuesList,
+                                       QList<QVariant> *lastInsertIds = nullptr,
+                                       QStringList *errors = nullptr);
 
 private:
     /*!
@@ -161,6 +186,18 @@ private:
      */
     static bool initialize();
 
+    /*!
+     * \brief   Upgrades the database to the supported version
+     *
+     * \param   databaseVersion Version of the opened database
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * \note    All tables added since the opened version are created in a single transaction.
+     */
+    static bool upgrade(const qint32 databaseVersion);
+
     /*!
      * \brief   Reads the database's version
      *
@@ -72,6 +72,8 @@ QList<Event> Database::EventManagement::readEvents(const QDateTime &startTimesta
             if (DatabaseManagement::executeSqlCommand(command, values, &results))
             {
                 // Get all events from the query
+                events.reserve(results.size());
+
                 for (int i = 0; i < results.size(); i++)
                 {
                     Event event = Event::fromMap(results.at(i));
@@ -116,6 +118,8 @@ QList<EventChangeLogItem> Database::EventManagement::readEventChangeLog(const qi
             if (DatabaseManagement::executeSqlCommand(command, values, &results))
             {
                 // Get all event change log items from the query
+                eventChangeLog.reserve(results.size());
+
                 for (int i = 0; i < results.size(); i++)
                 {
                     EventChangeLogItem item = EventChangeLogItem::fromMap(results.at(i));
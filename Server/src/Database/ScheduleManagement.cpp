@@ -15,13 +15,21 @@
  */
 #include "ScheduleManagement.hpp"
 #include "DatabaseManagement.hpp"
+#include "ChangeNotifier.hpp"
+#include "../ScheduleIndex.hpp"
 
 using namespace OpenTimeTracker::Server;
 
-QPair<QDateTime, QDateTime> Database::ScheduleManagement::readWorkingDay(const QDateTime &timestamp)
+QPair<QDateTime, QDateTime> Database::ScheduleManagement::readWorkingDay(const QDateTime &timestamp,
+                                                                        qint64 *workingDayId)
 {
     QPair<QDateTime, QDateTime> workingDay;
 
+    if (workingDayId != nullptr)
+    {
+        *workingDayId = 0LL;
+    }
+
     if (DatabaseManagement::isConnected())
     {
         // Read command
@@ -72,6 +80,12 @@ QPair<QDateTime, QDateTime> Database::ScheduleManagement::readWorkingDay(const Q
                                                                            Qt::ISODate);
                             endTimestamp.setTimeSpec(Qt::UTC);
                             workingDay.second = endTimestamp;
+
+                            // Optionally get the working day's ID
+                            if (workingDayId != nullptr)
+                            {
+                                *workingDayId = map["id"].toLongLong();
+                            }
                         }
                         else
                         {
@@ -86,6 +100,55 @@ QPair<QDateTime, QDateTime> Database::ScheduleManagement::readWorkingDay(const Q
     return workingDay;
 }
 
+QMap<qint64, QPair<QDateTime, QDateTime> > Database::ScheduleManagement::readWorkingDays()
+{
+    QMap<qint64, QPair<QDateTime, QDateTime> > workingDays;
+
+    if (DatabaseManagement::isConnected())
+    {
+        // Read command
+        const QString command = DatabaseManagement::readSqlCommandFromResource(
+                                    QStringLiteral("WorkingDays/ReadAll.sql"));
+
+        if (command.isEmpty() == false)
+        {
+            // Execute SQL command
+            QList<QMap<QString, QVariant> > results;
+
+            if (DatabaseManagement::executeSqlCommand(command, QMap<QString, QVariant>(), &results))
+            {
+                // Get all working days from the query (timestamps are stored in UTC)
+                foreach (const QMap<QString, QVariant> &result, results)
+                {
+                    QDateTime startTimestamp = QDateTime::fromString(
+                                                   result.value("startTimestamp").toString(),
+                                                   Qt::ISODate);
+                    startTimestamp.setTimeSpec(Qt::UTC);
+
+                    QDateTime endTimestamp = QDateTime::fromString(
+                                                 result.value("endTimestamp").toString(),
+                                                 Qt::ISODate);
+                    endTimestamp.setTimeSpec(Qt::UTC);
+
+                    if (startTimestamp.isValid() && endTimestamp.isValid())
+                    {
+                        workingDays.insert(result.value("id").toLongLong(),
+                                           qMakePair(startTimestamp, endTimestamp));
+                    }
+                    else
+                    {
+                        // On error stop reading the results and clear them
+                        workingDays.clear();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return workingDays;
+}
+
 QList<Schedule> Database::ScheduleManagement::readSchedules(const qint64 &userId,
                                                             const QDateTime &startTimestamp,
                                                             const QDateTime &endTimestamp)
@@ -199,10 +262,12 @@ bool Database::ScheduleManagement::addWorkingDay(const QDateTime &startTimestamp
             values[":endTimestamp"] = endTimestamp.toUTC().toString(Qt::ISODate);
 
             int rowsAffected = -1;
+            QVariant lastInsertId;
             success = DatabaseManagement::executeSqlCommand(command,
                                                             values,
                                                             nullptr,
-                                                            &rowsAffected);
+                                                            &rowsAffected,
+                                                            &lastInsertId);
 
             if (success)
             {
@@ -210,6 +275,13 @@ bool Database::ScheduleManagement::addWorkingDay(const QDateTime &startTimestamp
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportWorkingDayAdded(lastInsertId.toLongLong(),
+                                                                      startTimestamp,
+                                                                      endTimestamp);
+                }
             }
         }
     }
@@ -237,14 +309,65 @@ bool Database::ScheduleManagement::addSchedule(const qint64 &userId,
             values[":startTimestamp"] = startTimestamp.toUTC().toString(Qt::ISODate);
             values[":endTimestamp"] = endTimestamp.toUTC().toString(Qt::ISODate);
 
-            int rowsAffected = -1;
-            success = DatabaseManagement::executeSqlCommand(command, values, nullptr, &rowsAffected);
+            // Check for overlaps and add the schedule in a single transaction, so that no other
+            // writer can add an overlapping schedule in between (a concurrent write of another
+            // connection makes this transaction fail instead)
+            success = DatabaseManagement::beginTransaction();
 
             if (success)
             {
-                if (rowsAffected != 1)
+                // Make sure the schedule doesn't overlap with any of the user's schedules
+                const QString overlapCommand = DatabaseManagement::readSqlCommandFromResource(
+                                                   QStringLiteral(
+                                                       "Schedules/ReadOverlappingSingleUser.sql"));
+                QList<QMap<QString, QVariant> > results;
+
+                success = DatabaseManagement::executeSqlCommand(overlapCommand, values, &results);
+
+                if (success)
                 {
-                    success = false;
+                    success = results.isEmpty();
+                }
+
+                // Add the schedule
+                int rowsAffected = -1;
+                QVariant lastInsertId;
+
+                if (success)
+                {
+                    success = DatabaseManagement::executeSqlCommand(command,
+                                                                    values,
+                                                                    nullptr,
+                                                                    &rowsAffected,
+                                                                    &lastInsertId);
+                }
+
+                if (success)
+                {
+                    if (rowsAffected != 1)
+                    {
+                        success = false;
+                    }
+                    else
+                    {
+                        // Notify about the change (delivered when the transaction is committed)
+                        ChangeNotifier::instance()->reportScheduleAdded(lastInsertId.toLongLong(),
+                                                                        userId,
+                                                                        startTimestamp,
+                                                                        endTimestamp);
+                    }
+                }
+
+                // Finish the transaction
+                if (success)
+                {
+                    // No error occurred, commit the transaction
+                    success = DatabaseManagement::commitTransaction();
+                }
+                else
+                {
+                    // On error (or overlap) rollback the transaction
+                    DatabaseManagement::rollbackTransaction();
                 }
             }
         }
@@ -253,6 +376,179 @@ bool Database::ScheduleManagement::addSchedule(const qint64 &userId,
     return success;
 }
 
+bool Database::ScheduleManagement::publishSchedules(const QList<Schedule> &schedules,
+                                                   QStringList *rowErrors)
+{
+    bool success = false;
+    QStringList errors;
+
+    // Read commands
+    const QString readCommand = DatabaseManagement::readSqlCommandFromResource(
+                                    QStringLiteral("Schedules/ReadOverlapping.sql"));
+    const QString addCommand = DatabaseManagement::readSqlCommandFromResource(
+                                   QStringLiteral("Schedules/Add.sql"));
+
+    if (DatabaseManagement::isConnected() && (!readCommand.isEmpty()) && (!addCommand.isEmpty()))
+    {
+        success = true;
+    }
+
+    // Find the time range of the published schedules
+    QDateTime startTimestamp;
+    QDateTime endTimestamp;
+
+    if (success)
+    {
+        foreach (const Schedule &schedule, schedules)
+        {
+            if (schedule.startTimestamp().isValid() &&
+                ((!startTimestamp.isValid()) || (schedule.startTimestamp() < startTimestamp)))
+            {
+                startTimestamp = schedule.startTimestamp();
+            }
+
+            if (schedule.endTimestamp().isValid() &&
+                ((!endTimestamp.isValid()) || (schedule.endTimestamp() > endTimestamp)))
+            {
+                endTimestamp = schedule.endTimestamp();
+            }
+        }
+    }
+
+    // Validate and add the schedules in a single transaction, so that no other writer can add an
+    // overlapping schedule after the existing schedules were read
+    bool transactionStarted = false;
+
+    if (success)
+    {
+        success = DatabaseManagement::beginTransaction();
+        transactionStarted = success;
+    }
+
+    // Index the existing schedules within the time range (read with a single query)
+    ScheduleIndex scheduleIndex;
+
+    if (success && startTimestamp.isValid() && endTimestamp.isValid())
+    {
+        QMap<QString, QVariant> values;
+        values[":startTimestamp"] = startTimestamp.toUTC().toString(Qt::ISODate);
+        values[":endTimestamp"] = endTimestamp.toUTC().toString(Qt::ISODate);
+
+        QList<QMap<QString, QVariant> > results;
+        success = DatabaseManagement::executeSqlCommand(readCommand, values, &results);
+
+        // Note: already stored schedules that overlap with each other are indexed only once
+        for (int i = 0; i < results.size(); i++)
+        {
+            const Schedule schedule = Schedule::fromMap(results.at(i));
+
+            scheduleIndex.insert(schedule.userId(),
+                                 schedule.startTimestamp(),
+                                 schedule.endTimestamp());
+        }
+    }
+
+    // Validate the published schedules against the existing and the already validated schedules
+    QList<QMap<QString, QVariant> > valuesList;
+
+    if (success)
+    {
+        valuesList.reserve(schedules.size());
+
+        foreach (const Schedule &schedule, schedules)
+        {
+            QString error;
+
+            if ((schedule.userId() < 1LL) ||
+                (!schedule.startTimestamp().isValid()) ||
+                (!schedule.endTimestamp().isValid()) ||
+                (schedule.startTimestamp() >= schedule.endTimestamp()))
+            {
+                error = QStringLiteral("Invalid schedule");
+            }
+            else if (!scheduleIndex.insert(schedule.userId(),
+                                           schedule.startTimestamp(),
+                                           schedule.endTimestamp()))
+            {
+                error = QStringLiteral("Schedule overlaps with another schedule of the user");
+            }
+            else
+            {
+                QMap<QString, QVariant> values;
+                values[":userId"] = schedule.userId();
+                values[":startTimestamp"] = schedule.startTimestamp().toUTC().toString(Qt::ISODate);
+                values[":endTimestamp"] = schedule.endTimestamp().toUTC().toString(Qt::ISODate);
+                valuesList.append(values);
+            }
+
+            if (!error.isEmpty())
+            {
+                success = false;
+            }
+
+            errors.append(error);
+        }
+    }
+
+    // Add all schedules
+    if (success)
+    {
+        QList<QVariant> scheduleIds;
+        QStringList addErrors;
+        success = DatabaseManagement::executeSqlCommandBatch(addCommand,
+                                                             valuesList,
+                                                             &scheduleIds,
+                                                             &addErrors);
+
+        if (scheduleIds.size() == schedules.size())
+        {
+            for (int i = 0; i < schedules.size(); i++)
+            {
+                if (scheduleIds.at(i).isValid())
+                {
+                    ChangeNotifier::instance()->reportScheduleAdded(
+                                scheduleIds.at(i).toLongLong(),
+                                schedules.at(i).userId(),
+                                schedules.at(i).startTimestamp(),
+                                schedules.at(i).endTimestamp());
+                }
+                else
+                {
+                    errors[i] = addErrors.at(i);
+                }
+            }
+        }
+        else
+        {
+            // Error, the command couldn't be executed
+            success = false;
+        }
+    }
+
+    // Finish the transaction
+    if (transactionStarted)
+    {
+        if (success)
+        {
+            // No error occurred, commit the transaction
+            success = DatabaseManagement::commitTransaction();
+        }
+        else
+        {
+            // On error (or overlap) rollback the transaction
+            DatabaseManagement::rollbackTransaction();
+        }
+    }
+
+    // Optionally report the errors of each schedule
+    if (rowErrors != nullptr)
+    {
+        *rowErrors = errors;
+    }
+
+    return success;
+}
+
 bool Database::ScheduleManagement::removeSchedule(const qint64 &scheduleId)
 {
     bool success = false;
@@ -279,6 +575,273 @@ bool Database::ScheduleManagement::removeSchedule(const qint64 &scheduleId)
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportScheduleRemoved(scheduleId);
+                }
+            }
+        }
+    }
+
+    return success;
+}
+
+QList<ScheduleTemplate> Database::ScheduleManagement::readScheduleTemplates(const QDate &startDate,
+                                                                            const QDate &endDate)
+{
+    QList<ScheduleTemplate> scheduleTemplates;
+
+    if (DatabaseManagement::isConnected() && startDate.isValid() && endDate.isValid())
+    {
+        // Read commands
+        const QString templatesCommand = DatabaseManagement::readSqlCommandFromResource(
+                                             QStringLiteral("ScheduleTemplates/ReadDateRange.sql"));
+        const QString exceptionsCommand = DatabaseManagement::readSqlCommandFromResource(
+                                              QStringLiteral(
+                                                  "ScheduleTemplateExceptions/ReadDateRange.sql"));
+
+        if ((!templatesCommand.isEmpty()) && (!exceptionsCommand.isEmpty()))
+        {
+            // Execute SQL commands
+            QMap<QString, QVariant> values;
+            values[":startDate"] = startDate.toString(Qt::ISODate);
+            values[":endDate"] = endDate.toString(Qt::ISODate);
+
+            QList<QMap<QString, QVariant> > templateResults;
+            QList<QMap<QString, QVariant> > exceptionResults;
+            bool success = DatabaseManagement::executeSqlCommand(templatesCommand,
+                                                                 values,
+                                                                 &templateResults);
+
+            if (success)
+            {
+                success = DatabaseManagement::executeSqlCommand(exceptionsCommand,
+                                                                values,
+                                                                &exceptionResults);
+            }
+
+            // Get all schedule templates from the query
+            QHash<qint64, int> templateIndexes;
+
+            for (int i = 0; success && (i < templateResults.size()); i++)
+            {
+                const ScheduleTemplate scheduleTemplate =
+                        ScheduleTemplate::fromMap(templateResults.at(i));
+
+                if (scheduleTemplate.isValid())
+                {
+                    templateIndexes.insert(scheduleTemplate.id(), scheduleTemplates.size());
+                    scheduleTemplates.append(scheduleTemplate);
+                }
+                else
+                {
+                    success = false;
+                }
+            }
+
+            // Add the exceptions to their schedule templates
+            for (int i = 0; success && (i < exceptionResults.size()); i++)
+            {
+                const QMap<QString, QVariant> &result = exceptionResults.at(i);
+                const qint64 scheduleTemplateId = result.value("scheduleTemplateId").toLongLong();
+                const QDate date = QDate::fromString(result.value("date").toString(), Qt::ISODate);
+
+                if (templateIndexes.contains(scheduleTemplateId))
+                {
+                    scheduleTemplates[templateIndexes.value(scheduleTemplateId)].addException(date);
+                }
+            }
+
+            // On error clear the results
+            if (!success)
+            {
+                scheduleTemplates.clear();
+            }
+        }
+    }
+
+    return scheduleTemplates;
+}
+
+QList<Schedule> Database::ScheduleManagement::readExpandedSchedules(
+        const QDateTime &startTimestamp,
+        const QDateTime &endTimestamp)
+{
+    // Schedules sorted by user ID and start (milliseconds since the epoch)
+    QMap<QPair<qint64, qint64>, Schedule> sortedSchedules;
+    ScheduleIndex scheduleIndex;
+
+    // Stored schedules are always used
+    foreach (const Schedule &schedule, readSchedules(startTimestamp, endTimestamp))
+    {
+        scheduleIndex.insert(schedule.userId(),
+                             schedule.startTimestamp(),
+                             schedule.endTimestamp());
+        sortedSchedules.insertMulti(qMakePair(schedule.userId(),
+                                              schedule.startTimestamp().toMSecsSinceEpoch()),
+                                    schedule);
+    }
+
+    // Expand the schedule templates, a stored schedule replaces the expanded schedules it overlaps
+    const QList<ScheduleTemplate> scheduleTemplates =
+            readScheduleTemplates(startTimestamp.toLocalTime().date(),
+                                  endTimestamp.toLocalTime().date());
+
+    foreach (const ScheduleTemplate &scheduleTemplate, scheduleTemplates)
+    {
+        foreach (const Schedule &schedule, scheduleTemplate.expand(startTimestamp, endTimestamp))
+        {
+            if (scheduleIndex.insert(schedule.userId(),
+                                     schedule.startTimestamp(),
+                                     schedule.endTimestamp()))
+            {
+                sortedSchedules.insert(qMakePair(schedule.userId(),
+                                                 schedule.startTimestamp().toMSecsSinceEpoch()),
+                                       schedule);
+            }
+        }
+    }
+
+    return sortedSchedules.values();
+}
+
+bool Database::ScheduleManagement::addScheduleTemplate(const qint64 &userId,
+                                                       const int dayOfWeek,
+                                                       const QTime &startTime,
+                                                       const qint32 duration,
+                                                       const QDate &validFrom,
+                                                       const QDate &validUntil)
+{
+    bool success = false;
+
+    if (DatabaseManagement::isConnected())
+    {
+        // Read command
+        const QString command = DatabaseManagement::readSqlCommandFromResource(
+                                    QStringLiteral("ScheduleTemplates/Add.sql"));
+
+        // Execute command
+        if ((!command.isEmpty()) && startTime.isValid() && validFrom.isValid())
+        {
+            QMap<QString, QVariant> values;
+            values[":userId"] = userId;
+            values[":dayOfWeek"] = dayOfWeek;
+            values[":startTime"] = startTime.toString(Qt::ISODate);
+            values[":duration"] = duration;
+            values[":validFrom"] = validFrom.toString(Qt::ISODate);
+
+            if (validUntil.isNull())
+            {
+                values[":validUntil"] = QVariant(QVariant::String);
+            }
+            else
+            {
+                values[":validUntil"] = validUntil.toString(Qt::ISODate);
+            }
+
+            int rowsAffected = -1;
+            QVariant lastInsertId;
+            success = DatabaseManagement::executeSqlCommand(command,
+                                                            values,
+                                                            nullptr,
+                                                            &rowsAffected,
+                                                            &lastInsertId);
+
+            if (success)
+            {
+                if (rowsAffected != 1)
+                {
+                    success = false;
+                }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportScheduleTemplateChanged(
+                                lastInsertId.toLongLong());
+                }
+            }
+        }
+    }
+
+    return success;
+}
+
+bool Database::ScheduleManagement::addScheduleTemplateException(const qint64 &scheduleTemplateId,
+                                                                const QDate &date)
+{
+    bool success = false;
+
+    if (DatabaseManagement::isConnected())
+    {
+        // Read command
+        const QString command = DatabaseManagement::readSqlCommandFromResource(
+                                    QStringLiteral("ScheduleTemplateExceptions/Add.sql"));
+
+        // Execute command
+        if ((!command.isEmpty()) && date.isValid())
+        {
+            QMap<QString, QVariant> values;
+            values[":scheduleTemplateId"] = scheduleTemplateId;
+            values[":date"] = date.toString(Qt::ISODate);
+
+            int rowsAffected = -1;
+            success = DatabaseManagement::executeSqlCommand(command,
+                                                            values,
+                                                            nullptr,
+                                                            &rowsAffected);
+
+            if (success)
+            {
+                if (rowsAffected != 1)
+                {
+                    success = false;
+                }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportScheduleTemplateChanged(scheduleTemplateId);
+                }
+            }
+        }
+    }
+
+    return success;
+}
+
+bool Database::ScheduleManagement::removeScheduleTemplate(const qint64 &scheduleTemplateId)
+{
+    bool success = false;
+
+    if (DatabaseManagement::isConnected())
+    {
+        // Read command
+        const QString command = DatabaseManagement::readSqlCommandFromResource(
+                                    QStringLiteral("ScheduleTemplates/Remove.sql"));
+
+        // Execute command (the template's exceptions are removed with it)
+        if (command.isEmpty() == false)
+        {
+            QMap<QString, QVariant> values;
+            values[":id"] = scheduleTemplateId;
+
+            int rowsAffected = -1;
+            success = DatabaseManagement::executeSqlCommand(command,
+                                                            values,
+                                                            nullptr,
+                                                            &rowsAffected);
+
+            if (success)
+            {
+                if (rowsAffected != 1)
+                {
+                    success = false;
+                }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportScheduleTemplateChanged(scheduleTemplateId);
+                }
             }
         }
     }
@@ -17,8 +17,11 @@
 #define OPENTIMETRACKER_SERVER_DATABASE_SCHEDULEMANAGEMENT_HPP
 
 #include <QDateTime>
+#include <QMap>
 #include <QPair>
+#include <QStringList>
 #include "../Schedule.hpp"
+#include "../ScheduleTemplate.hpp"
 
 namespace OpenTimeTracker
 {
@@ -36,7 +39,9 @@ public:
     /*!
      * \brief   Reads working day time range
      *
-     * \param   timestamp   Timestamp that is within the working day time range
+     * \param       timestamp       Timestamp that is within the working day time range
+     * \param[out]  workingDayId    Optional parameter for the ID of the working day (zero if no
+     *                              working day was found)
      *
      * \return  A pair of timestamps:
      *          - first: start of working day
@@ -44,8 +49,19 @@ public:
      *
      * \note    The last added working day entry found in the database that satisfies the search
      *          parameter is returned.
+     *
+     * \note    This queries the database on every call. The server doesn't use it, it looks up
+     *          working days in its WorkingDayCache (see Server::startWorkday()).
+     */
+    static QPair<QDateTime, QDateTime> readWorkingDay(const QDateTime &timestamp,
+                                                      qint64 *workingDayId = nullptr);
+
+    /*!
+     * \brief   Reads all working days from the database
+     *
+     * \return  Start and end of each working day (by working day ID)
      */
-    static QPair<QDateTime, QDateTime> readWorkingDay(const QDateTime &timestamp);
+    static QMap<qint64, QPair<QDateTime, QDateTime> > readWorkingDays();
 
     /*!
      * \brief   Reads schedules from the database for a specific time range and user
@@ -89,6 +105,8 @@ public:
     /*!
      * \brief   Adds a new schedule to the database
      *
+     * The schedule is rejected if it overlaps with any of the user's schedules.
+     *
      * \param   userId          Schedule's user ID
      * \param   startTimestamp  The exact date and time of start of the schedule
      * \param   endTimestamp    The exact date and time of end of the schedule
@@ -100,6 +118,22 @@ public:
                             const QDateTime &startTimestamp,
                             const QDateTime &endTimestamp);
 
+    /*!
+     * \brief   Adds all of the schedules to the database in a single transaction
+     *
+     * \param       schedules   Schedules to add (their IDs are ignored)
+     * \param[out]  rowErrors   Optional output for the error of each schedule (empty on success)
+     *
+     * \retval  true    Success
+     * \retval  false   Error, none of the schedules were added
+     *
+     * The schedules are validated before anything is written: a schedule is rejected if it is
+     * invalid or if it overlaps with a stored schedule or another published schedule of its user.
+     * The stored schedules are read with a single query and kept in a ScheduleIndex.
+     */
+    static bool publishSchedules(const QList<Schedule> &schedules,
+                                 QStringList *rowErrors = nullptr);
+
     /*!
      * \brief   Removes a schedule from the database
      *
@@ -110,6 +144,75 @@ public:
      */
     static bool removeSchedule(const qint64 &scheduleId);
 
+    /*!
+     * \brief   Reads the schedule templates that are valid within a date range
+     *
+     * \param   startDate   First date of the range
+     * \param   endDate     Last date of the range
+     *
+     * \return  List of schedule templates with their exceptions within the date range
+     */
+    static QList<ScheduleTemplate> readScheduleTemplates(const QDate &startDate,
+                                                         const QDate &endDate);
+
+    /*!
+     * \brief   Reads the schedules of all users for a specific time range, including the schedules
+     *          expanded from the schedule templates
+     *
+     * \param   startTimestamp  Read schedules from and including this timestamp
+     * \param   endTimestamp    Read schedules up to and including this timestamp
+     *
+     * \return  List of schedules ordered by user ID and start
+     *
+     * Only the schedule templates that are valid within the time range are read and expanded. An
+     * expanded schedule that overlaps with a stored schedule of the same user is skipped, so a
+     * stored schedule can be used to replace a single occurrence of a schedule template.
+     */
+    static QList<Schedule> readExpandedSchedules(const QDateTime &startTimestamp,
+                                                 const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Adds a new recurring schedule template to the database
+     *
+     * \param   userId      Schedule template's user ID
+     * \param   dayOfWeek   Day of the week on which the schedule takes place (1 for Monday)
+     * \param   startTime   Time of day (local time) at which the schedule starts
+     * \param   duration    Duration of the schedule in seconds (at most one day)
+     * \param   validFrom   First date on which the template is valid
+     * \param   validUntil  Last date on which the template is valid or a null date if the template
+     *                      is valid indefinitely
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     */
+    static bool addScheduleTemplate(const qint64 &userId,
+                                    const int dayOfWeek,
+                                    const QTime &startTime,
+                                    const qint32 duration,
+                                    const QDate &validFrom,
+                                    const QDate &validUntil = QDate());
+
+    /*!
+     * \brief   Adds a date on which the schedule template's schedule doesn't take place
+     *
+     * \param   scheduleTemplateId  ID of the schedule template
+     * \param   date                Exception date
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     */
+    static bool addScheduleTemplateException(const qint64 &scheduleTemplateId, const QDate &date);
+
+    /*!
+     * \brief   Removes a schedule template and its exceptions from the database
+     *
+     * \param   scheduleTemplateId  ID of the schedule template
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     */
+    static bool removeScheduleTemplate(const qint64 &scheduleTemplateId);
+
 private:
     /*!
      * \brief   Constructor is disabled
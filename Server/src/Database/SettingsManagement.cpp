@@ -15,6 +15,7 @@
  */
 #include "SettingsManagement.hpp"
 #include "DatabaseManagement.hpp"
+#include "ChangeNotifier.hpp"
 
 using namespace OpenTimeTracker::Server;
 
@@ -97,6 +98,11 @@ bool Database::SettingsManagement::addSettings(const QMap<QString, QVariant> &se
                         {
                             success = false;
                         }
+                        else
+                        {
+                            // Notify about the change (sent out when the transaction is committed)
+                            ChangeNotifier::instance()->reportSettingChanged(name, settings[name]);
+                        }
                     }
 
                     if (!success)
@@ -153,6 +159,11 @@ bool Database::SettingsManagement::changeSetting(const QString &name, const QVar
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportSettingChanged(name, newValue);
+                }
             }
         }
     }
@@ -13,8 +13,10 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <QtCore/QHash>
 #include "UserManagement.hpp"
 #include "DatabaseManagement.hpp"
+#include "ChangeNotifier.hpp"
 
 using namespace OpenTimeTracker::Server;
 
@@ -169,7 +171,12 @@ bool Database::UserManagement::addUser(const QString &name, const QString &passw
             }
 
             int rowsAffected = -1;
-            success = DatabaseManagement::executeSqlCommand(command, values, nullptr, &rowsAffected);
+            QVariant lastInsertId;
+            success = DatabaseManagement::executeSqlCommand(command,
+                                                            values,
+                                                            nullptr,
+                                                            &rowsAffected,
+                                                            &lastInsertId);
 
             if (success)
             {
@@ -177,6 +184,13 @@ bool Database::UserManagement::addUser(const QString &name, const QString &passw
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserAdded(lastInsertId.toLongLong(),
+                                                                name,
+                                                                values[":password"].toString());
+                }
             }
         }
     }
@@ -201,7 +215,12 @@ bool Database::UserManagement::addUserGroup(const QString &name)
             values[":name"] = name;
 
             int rowsAffected = -1;
-            success = DatabaseManagement::executeSqlCommand(command, values, nullptr, &rowsAffected);
+            QVariant lastInsertId;
+            success = DatabaseManagement::executeSqlCommand(command,
+                                                            values,
+                                                            nullptr,
+                                                            &rowsAffected,
+                                                            &lastInsertId);
 
             if (success)
             {
@@ -209,6 +228,12 @@ bool Database::UserManagement::addUserGroup(const QString &name)
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserGroupAdded(lastInsertId.toLongLong(),
+                                                                     name);
+                }
             }
         }
     }
@@ -234,10 +259,12 @@ bool Database::UserManagement::addUserMapping(const qint64 &userGroupId, const q
             values[":userId"] = userId;
 
             int rowsAffected = -1;
+            QVariant lastInsertId;
             success = DatabaseManagement::executeSqlCommand(command,
                                                             values,
                                                             nullptr,
-                                                            &rowsAffected);
+                                                            &rowsAffected,
+                                                            &lastInsertId);
 
             if (success)
             {
@@ -245,6 +272,13 @@ bool Database::UserManagement::addUserMapping(const qint64 &userGroupId, const q
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserMappingAdded(lastInsertId.toLongLong(),
+                                                                       userGroupId,
+                                                                       userId);
+                }
             }
         }
     }
@@ -282,6 +316,11 @@ bool Database::UserManagement::changeUserName(const qint64 &userId, const QStrin
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserNameChanged(userId, newName);
+                }
             }
         }
     }
@@ -319,6 +358,11 @@ bool Database::UserManagement::changeUserPassword(const qint64 &userId, const QS
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserPasswordChanged(userId, newPassword);
+                }
             }
         }
     }
@@ -362,6 +406,11 @@ bool Database::UserManagement::changeUserGroupName(const qint64 &userGroupId,
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserGroupNameChanged(userGroupId, newName);
+                }
             }
         }
     }
@@ -398,8 +447,246 @@ bool Database::UserManagement::removeUserMapping(const qint64 &userMappingId)
                 {
                     success = false;
                 }
+                else
+                {
+                    // Notify about the change
+                    ChangeNotifier::instance()->reportUserMappingRemoved(userMappingId);
+                }
+            }
+        }
+    }
+
+    return success;
+}
+
+bool Database::UserManagement::importRoster(const Roster &roster, QStringList *rowErrors)
+{
+    bool success = false;
+    const QList<Roster::Entry> entries = roster.entries();
+    QList<QStringList> errors;
+
+    for (int i = 0; i < entries.size(); i++)
+    {
+        errors.append(QStringList());
+    }
+
+    // Read commands
+    const QString addUserCommand = DatabaseManagement::readSqlCommandFromResource(
+                                       QStringLiteral("Users/Add.sql"));
+    const QString addUserGroupCommand = DatabaseManagement::readSqlCommandFromResource(
+                                            QStringLiteral("UserGroups/Add.sql"));
+    const QString addUserMappingCommand = DatabaseManagement::readSqlCommandFromResource(
+                                              QStringLiteral("UserMapping/Add.sql"));
+
+    // Begin transaction
+    if (DatabaseManagement::isConnected() &&
+        (!addUserCommand.isEmpty()) &&
+        (!addUserGroupCommand.isEmpty()) &&
+        (!addUserMappingCommand.isEmpty()))
+    {
+        success = DatabaseManagement::beginTransaction();
+    }
+
+    const bool transactionStarted = success;
+
+    // Add users
+    QList<QVariant> userIds;
+
+    if (success)
+    {
+        QList<QMap<QString, QVariant> > valuesList;
+        valuesList.reserve(entries.size());
+
+        foreach (const Roster::Entry &entry, entries)
+        {
+            QMap<QString, QVariant> values;
+            values[":name"] = entry.userName;
+
+            if (entry.password.isEmpty())
+            {
+                // User with an empty password shall be considered to be disabled
+                values[":password"] = QString();
+            }
+            else
+            {
+                values[":password"] = entry.password;
+            }
+
+            valuesList.append(values);
+        }
+
+        QStringList userErrors;
+        DatabaseManagement::executeSqlCommandBatch(addUserCommand,
+                                                   valuesList,
+                                                   &userIds,
+                                                   &userErrors);
+
+        if (userIds.size() == entries.size())
+        {
+            for (int i = 0; i < entries.size(); i++)
+            {
+                if (userIds.at(i).isValid())
+                {
+                    ChangeNotifier::instance()->reportUserAdded(
+                                userIds.at(i).toLongLong(),
+                                entries.at(i).userName,
+                                valuesList.at(i)[":password"].toString());
+                }
+                else
+                {
+                    errors[i].append(QStringLiteral("User: ") + userErrors.at(i));
+                }
             }
         }
+        else
+        {
+            // Error, the command couldn't be executed
+            success = false;
+        }
+    }
+
+    // Add the user groups that don't exist yet
+    QHash<QString, qint64> userGroupIds;
+    QHash<QString, QString> userGroupErrors;
+
+    if (success)
+    {
+        foreach (const UserGroup &userGroup, readUserGroups())
+        {
+            userGroupIds.insert(userGroup.name(), userGroup.id());
+        }
+
+        QStringList newUserGroupNames;
+        QList<QMap<QString, QVariant> > valuesList;
+
+        foreach (const QString &userGroupName, roster.userGroupNames())
+        {
+            if (!userGroupIds.contains(userGroupName))
+            {
+                QMap<QString, QVariant> values;
+                values[":name"] = userGroupName;
+
+                newUserGroupNames.append(userGroupName);
+                valuesList.append(values);
+            }
+        }
+
+        QList<QVariant> newUserGroupIds;
+        QStringList newUserGroupErrors;
+        DatabaseManagement::executeSqlCommandBatch(addUserGroupCommand,
+                                                   valuesList,
+                                                   &newUserGroupIds,
+                                                   &newUserGroupErrors);
+
+        if (newUserGroupIds.size() == newUserGroupNames.size())
+        {
+            for (int i = 0; i < newUserGroupNames.size(); i++)
+            {
+                if (newUserGroupIds.at(i).isValid())
+                {
+                    const qint64 userGroupId = newUserGroupIds.at(i).toLongLong();
+                    userGroupIds.insert(newUserGroupNames.at(i), userGroupId);
+                    ChangeNotifier::instance()->reportUserGroupAdded(userGroupId,
+                                                                     newUserGroupNames.at(i));
+                }
+                else
+                {
+                    userGroupErrors.insert(newUserGroupNames.at(i), newUserGroupErrors.at(i));
+                }
+            }
+        }
+        else
+        {
+            // Error, the command couldn't be executed
+            success = false;
+        }
+    }
+
+    // Add user mappings of the added users
+    if (success)
+    {
+        QList<QMap<QString, QVariant> > valuesList;
+        QList<int> rows;
+
+        for (int i = 0; i < entries.size(); i++)
+        {
+            if (userIds.at(i).isValid())
+            {
+                foreach (const QString &userGroupName, entries.at(i).userGroupNames)
+                {
+                    if (userGroupIds.contains(userGroupName))
+                    {
+                        QMap<QString, QVariant> values;
+                        values[":userGroupId"] = userGroupIds.value(userGroupName);
+                        values[":userId"] = userIds.at(i);
+
+                        valuesList.append(values);
+                        rows.append(i);
+                    }
+                    else
+                    {
+                        errors[i].append(QStringLiteral("User group ") +
+                                         userGroupName +
+                                         QStringLiteral(": ") +
+                                         userGroupErrors.value(userGroupName));
+                    }
+                }
+            }
+        }
+
+        QList<QVariant> userMappingIds;
+        QStringList userMappingErrors;
+        DatabaseManagement::executeSqlCommandBatch(addUserMappingCommand,
+                                                   valuesList,
+                                                   &userMappingIds,
+                                                   &userMappingErrors);
+
+        if (userMappingIds.size() == rows.size())
+        {
+            for (int i = 0; i < rows.size(); i++)
+            {
+                if (userMappingIds.at(i).isValid())
+                {
+                    ChangeNotifier::instance()->reportUserMappingAdded(
+                                userMappingIds.at(i).toLongLong(),
+                                valuesList.at(i)[":userGroupId"].toLongLong(),
+                                valuesList.at(i)[":userId"].toLongLong());
+                }
+                else
+                {
+                    errors[rows.at(i)].append(QStringLiteral("User mapping: ") +
+                                              userMappingErrors.at(i));
+                }
+            }
+        }
+        else
+        {
+            // Error, the command couldn't be executed
+            success = false;
+        }
+    }
+
+    // Finish the transaction
+    if (success)
+    {
+        // No error occurred, commit the transaction
+        success = DatabaseManagement::commitTransaction();
+    }
+    else if (transactionStarted)
+    {
+        // On error rollback the transaction
+        DatabaseManagement::rollbackTransaction();
+    }
+
+    // Optionally report the errors of each entry
+    if (rowErrors != nullptr)
+    {
+        rowErrors->clear();
+
+        foreach (const QStringList &entryErrors, errors)
+        {
+            rowErrors->append(entryErrors.join(QStringLiteral("; ")));
+        }
     }
 
     return success;
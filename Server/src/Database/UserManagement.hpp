@@ -16,6 +16,8 @@
 #ifndef OPENTIMETRACKER_SERVER_DATABASE_USERMANAGEMENT_HPP
 #define OPENTIMETRACKER_SERVER_DATABASE_USERMANAGEMENT_HPP
 
+#include <QtCore/QStringList>
+#include "../Roster.hpp"
 #include "../User.hpp"
 #include "../UserGroup.hpp"
 #include "../UserMapping.hpp"
@@ -150,6 +152,23 @@ public:
      */
     static bool removeUserMapping(const qint64 &userMappingId);
 
+    /*!
+     * \brief   Imports the users and their user groups from the roster to the database
+     *
+     * \param       roster      Roster
+     * \param[out]  rowErrors   Optional parameter for the errors of each roster entry (empty
+     *                          string if the entry was imported without errors)
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * All users, the user groups that don't exist yet and the user mappings are added in a single
+     * transaction and each of them with a single prepared statement. Entries that violate the
+     * database constraints (e.g. a user name that already exists) are skipped and reported in the
+     * row errors while the rest of the roster is still imported.
+     */
+    static bool importRoster(const Roster &roster, QStringList *rowErrors = nullptr);
+
 private:
     /*!
      * \brief   Constructor is disabled
@@ -14,37 +14,119 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Event.hpp"
+#include <QtCore/QSharedData>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of an event
+ */
+class EventData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    EventData()
+        : QSharedData(),
+          m_id(0LL),
+          m_timestamp(),
+          m_userId(0LL),
+          m_type(Event::Type_Invalid),
+          m_enabled(false)
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    EventData(const EventData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_timestamp(other.m_timestamp),
+          m_userId(other.m_userId),
+          m_type(other.m_type),
+          m_enabled(other.m_enabled)
+    {
+    }
+
+    /*!
+     * \brief   Holds the event's ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the event's timestamp
+     */
+    QDateTime m_timestamp;
+
+    /*!
+     * \brief   Holds the event's user ID
+     */
+    qint64 m_userId;
+
+    /*!
+     * \brief   Holds the event's type
+     */
+    Event::Type m_type;
+
+    /*!
+     * \brief   Holds the event's enable state
+     */
+    bool m_enabled;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from events
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<EventData> &defaultData()
+{
+    static const QSharedDataPointer<EventData> data(new EventData());
+
+    return data;
+}
+
+}
+}
 
 using namespace OpenTimeTracker::Server;
 
 Event::Event()
-    : m_id(0LL),
-      m_timestamp(),
-      m_userId(0LL),
-      m_type(Type_Invalid),
-      m_enabled(false)
+    : m_data(defaultData())
 {
 }
 
 Event::Event(const Event &other)
-    : m_id(other.m_id),
-      m_timestamp(other.m_timestamp),
-      m_userId(other.m_userId),
-      m_type(other.m_type),
-      m_enabled(other.m_enabled)
+    : m_data(other.m_data)
+{
+}
+
+Event::Event(Event &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+Event::~Event()
 {
 }
 
 Event &Event::operator =(const Event &other)
 {
-    if (this != &other)
-    {
-        m_id = other.m_id;
-        m_timestamp = other.m_timestamp;
-        m_userId = other.m_userId;
-        m_type = other.m_type;
-        m_enabled = other.m_enabled;
-    }
+    m_data = other.m_data;
+
+    return *this;
+}
+
+Event &Event::operator =(Event &&other) noexcept
+{
+    m_data.swap(other.m_data);
 
     return *this;
 }
@@ -53,7 +135,10 @@ bool Event::isValid() const
 {
     bool valid = true;
 
-    if ((m_id < 1LL) || (!m_timestamp.isValid()) || (m_userId < 1LL) || (m_type == Type_Invalid))
+    if ((m_data->m_id < 1LL) ||
+        (!m_data->m_timestamp.isValid()) ||
+        (m_data->m_userId < 1LL) ||
+        (m_data->m_type == Type_Invalid))
     {
         valid = false;
     }
@@ -63,37 +148,37 @@ bool Event::isValid() const
 
 qint64 Event::id() const
 {
-    return m_id;
+    return m_data->m_id;
 }
 
 void Event::setId(const qint64 &newId)
 {
-    m_id = newId;
+    m_data->m_id = newId;
 }
 
 QDateTime Event::timestamp() const
 {
-    return m_timestamp;
+    return m_data->m_timestamp;
 }
 
 void Event::setTimestamp(const QDateTime &newTimestamp)
 {
-    m_timestamp = newTimestamp;
+    m_data->m_timestamp = newTimestamp;
 }
 
 qint64 Event::userId() const
 {
-    return m_userId;
+    return m_data->m_userId;
 }
 
 void Event::setUserId(const qint64 &newUserId)
 {
-    m_userId = newUserId;
+    m_data->m_userId = newUserId;
 }
 
 Event::Type Event::type() const
 {
-    return m_type;
+    return m_data->m_type;
 }
 
 void Event::setType(const Type &newType)
@@ -101,22 +186,22 @@ void Event::setType(const Type &newType)
     if ((newType >= static_cast<int>(Type_Invalid)) ||
         (newType <= static_cast<int>(Type_Finished)))
     {
-        m_type = newType;
+        m_data->m_type = newType;
     }
     else
     {
-        m_type = Type_Invalid;
+        m_data->m_type = Type_Invalid;
     }
 }
 
 bool Event::isEnabled() const
 {
-    return m_enabled;
+    return m_data->m_enabled;
 }
 
 void Event::setEnabled(bool enabled)
 {
-    m_enabled = enabled;
+    m_data->m_enabled = enabled;
 }
 
 Event Event::fromMap(const QMap<QString, QVariant> &map)
@@ -18,6 +18,7 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
@@ -26,6 +27,8 @@ namespace OpenTimeTracker
 namespace Server
 {
 
+class EventData;
+
 /*!
  * \brief   Holds event entries
  */
@@ -55,6 +58,20 @@ public:
      */
     Event(const Event &other);
 
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    Event(Event &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~Event();
+
     /*!
      * \brief   operator =
      * \param   other   Object to be copied
@@ -63,6 +80,14 @@ public:
      */
     Event &operator =(const Event &other);
 
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    Event &operator =(Event &&other) noexcept;
+
     /*!
      * \brief   Checks if object is valid
      *
@@ -155,33 +180,14 @@ public:
 
 private:
     /*!
-     * \brief   Holds the event's ID
+     * \brief   Holds the event's data, which is implicitly shared between the copies
      */
-    qint64 m_id;
-
-    /*!
-     * \brief   Holds the event's timestamp
-     */
-    QDateTime m_timestamp;
-
-    /*!
-     * \brief   Holds the event's user ID
-     */
-    qint64 m_userId;
-
-    /*!
-     * \brief   Holds the event's type
-     */
-    Type m_type;
-
-    /*!
-     * \brief   Holds the event's enable state
-     */
-    bool m_enabled;
-
+    QSharedDataPointer<EventData> m_data;
 };
 
 }
 }
 
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::Event, Q_MOVABLE_TYPE);
+
 #endif // OPENTIMETRACKER_SERVER_EVENT_HPP
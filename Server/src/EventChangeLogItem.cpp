@@ -14,46 +14,142 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "EventChangeLogItem.hpp"
+#include <QtCore/QSharedData>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of an event change log item
+ */
+class EventChangeLogItemData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    EventChangeLogItemData()
+        : QSharedData(),
+          m_id(0LL),
+          m_eventId(0LL),
+          m_timestamp(),
+          m_fieldName(),
+          m_fromValue(),
+          m_toValue(),
+          m_userId(0LL),
+          m_comment()
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    EventChangeLogItemData(const EventChangeLogItemData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_eventId(other.m_eventId),
+          m_timestamp(other.m_timestamp),
+          m_fieldName(other.m_fieldName),
+          m_fromValue(other.m_fromValue),
+          m_toValue(other.m_toValue),
+          m_userId(other.m_userId),
+          m_comment(other.m_comment)
+    {
+    }
+
+    /*!
+     * \brief   Holds the event change log item's ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the event change log item's event ID
+     */
+    qint64 m_eventId;
+
+    /*!
+     * \brief   Holds the event change log item's timestamp
+     *
+     * \note    Timestamp is in UTC
+     */
+    QDateTime m_timestamp;
+
+    /*!
+     * \brief   Holds the event change log item's field name
+     */
+    QString m_fieldName;
+
+    /*!
+     * \brief   Holds the event change log item's original value
+     */
+    QVariant m_fromValue;
+
+    /*!
+     * \brief   Holds the event change log item's new value
+     */
+    QVariant m_toValue;
+
+    /*!
+     * \brief   Holds the event change log item's user ID
+     */
+    qint64 m_userId;
+
+    /*!
+     * \brief   Holds the event change log item's comment
+     */
+    QString m_comment;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from event change log items
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<EventChangeLogItemData> &defaultData()
+{
+    static const QSharedDataPointer<EventChangeLogItemData> data(new EventChangeLogItemData());
+
+    return data;
+}
+
+}
+}
 
 using namespace OpenTimeTracker::Server;
 
 EventChangeLogItem::EventChangeLogItem()
-    : m_id(0LL),
-      m_eventId(0LL),
-      m_timestamp(),
-      m_fieldName(),
-      m_fromValue(),
-      m_toValue(),
-      m_userId(0LL),
-      m_comment()
+    : m_data(defaultData())
 {
 }
 
 EventChangeLogItem::EventChangeLogItem(const EventChangeLogItem &other)
-    : m_id(other.m_id),
-      m_eventId(other.m_eventId),
-      m_timestamp(other.m_timestamp),
-      m_fieldName(other.m_fieldName),
-      m_fromValue(other.m_fromValue),
-      m_toValue(other.m_toValue),
-      m_userId(other.m_userId),
-      m_comment(other.m_comment)
+    : m_data(other.m_data)
+{
+}
+
+EventChangeLogItem::EventChangeLogItem(EventChangeLogItem &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+EventChangeLogItem::~EventChangeLogItem()
 {
 }
 
 EventChangeLogItem &EventChangeLogItem::operator =(const EventChangeLogItem &other)
 {
-    if (this != &other)
-    {
-        m_id = other.m_id;
-        m_eventId = other.m_eventId;
-        m_timestamp = other.m_timestamp;
-        m_fieldName = other.m_fieldName;
-        m_fromValue = other.m_fromValue;
-        m_toValue = other.m_toValue;
-        m_userId = other.m_userId;
-        m_comment = other.m_comment;
-    }
+    m_data = other.m_data;
+
+    return *this;
+}
+
+EventChangeLogItem &EventChangeLogItem::operator =(EventChangeLogItem &&other) noexcept
+{
+    m_data.swap(other.m_data);
 
     return *this;
 }
@@ -62,16 +158,16 @@ bool EventChangeLogItem::isValid() const
 {
     bool valid = true;
 
-    if ((m_id < 1LL) ||
-        (m_eventId < 1LL) ||
-        (!m_timestamp.isValid()) ||
-        m_fieldName.isEmpty() ||
-        (!m_fromValue.isValid()) ||
-        m_fromValue.isNull() ||
-        (!m_toValue.isValid()) ||
-        m_toValue.isNull() ||
-        (m_userId < 1LL) ||
-        m_comment.isEmpty())
+    if ((m_data->m_id < 1LL) ||
+        (m_data->m_eventId < 1LL) ||
+        (!m_data->m_timestamp.isValid()) ||
+        m_data->m_fieldName.isEmpty() ||
+        (!m_data->m_fromValue.isValid()) ||
+        m_data->m_fromValue.isNull() ||
+        (!m_data->m_toValue.isValid()) ||
+        m_data->m_toValue.isNull() ||
+        (m_data->m_userId < 1LL) ||
+        m_data->m_comment.isEmpty())
     {
         valid = false;
     }
@@ -81,82 +177,82 @@ bool EventChangeLogItem::isValid() const
 
 qint64 EventChangeLogItem::id() const
 {
-    return m_id;
+    return m_data->m_id;
 }
 
 void EventChangeLogItem::setId(const qint64 &newId)
 {
-    m_id = newId;
+    m_data->m_id = newId;
 }
 
 qint64 EventChangeLogItem::eventId() const
 {
-    return m_eventId;
+    return m_data->m_eventId;
 }
 
 void EventChangeLogItem::setEventId(const qint64 &newEventId)
 {
-    m_eventId = newEventId;
+    m_data->m_eventId = newEventId;
 }
 
 QDateTime EventChangeLogItem::timestamp() const
 {
-    return m_timestamp;
+    return m_data->m_timestamp;
 }
 
 void EventChangeLogItem::setTimestamp(const QDateTime &newTimestamp)
 {
-    m_timestamp = newTimestamp;
+    m_data->m_timestamp = newTimestamp;
 }
 
 QString EventChangeLogItem::fieldName() const
 {
-    return m_fieldName;
+    return m_data->m_fieldName;
 }
 
 void EventChangeLogItem::setFieldName(const QString &newFieldName)
 {
-    m_fieldName = newFieldName;
+    m_data->m_fieldName = newFieldName;
 }
 
 QVariant EventChangeLogItem::fromValue() const
 {
-    return m_fromValue;
+    return m_data->m_fromValue;
 }
 
 void EventChangeLogItem::setFromValue(const QVariant &newFromValue)
 {
-    m_fromValue = newFromValue;
+    m_data->m_fromValue = newFromValue;
 }
 
 QVariant EventChangeLogItem::toValue() const
 {
-    return m_toValue;
+    return m_data->m_toValue;
 }
 
 void EventChangeLogItem::setToValue(const QVariant &newToValue)
 {
-    m_toValue = newToValue;
+    m_data->m_toValue = newToValue;
 }
 
 qint64 EventChangeLogItem::userId() const
 {
-    return m_userId;
+    return m_data->m_userId;
 }
 
 void EventChangeLogItem::setUserId(const qint64 &newUserId)
 {
-    m_userId = newUserId;
+    m_data->m_userId = newUserId;
 }
 
 QString EventChangeLogItem::comment() const
 {
-    return m_comment;
+    return m_data->m_comment;
 }
 
 void EventChangeLogItem::setComment(const QString &newComment)
 {
-    m_comment = newComment;
+    m_data->m_comment = newComment;
 }
 
 EventChangeLogItem EventChangeLogItem::fromMap(const QMap<QString, QVariant> &map)
@@ -18,6 +18,7 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
@@ -26,6 +27,8 @@ namespace OpenTimeTracker
 namespace Server
 {
 
+class EventChangeLogItemData;
+
 /*!
  * \brief   Tracks changes applied to event entries
  */
@@ -43,6 +46,20 @@ public:
      */
     EventChangeLogItem(const EventChangeLogItem &other);
 
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    EventChangeLogItem(EventChangeLogItem &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~EventChangeLogItem();
+
     /*!
      * \brief   operator =
      * \param   other   Object to be copied
@@ -51,6 +68,14 @@ public:
      */
     EventChangeLogItem &operator =(const EventChangeLogItem &other);
 
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    EventChangeLogItem &operator =(EventChangeLogItem &&other) noexcept;
+
     /*!
      * \brief   Checks if object is valid
      *
@@ -185,49 +210,15 @@ public:
 
 private:
     /*!
-     * \brief   Holds the event change log item's ID
-     */
-    qint64 m_id;
-
-    /*!
-     * \brief   Holds the event change log item's event ID
-     */
-    qint64 m_eventId;
-
-    /*!
-     * \brief   Holds the event change log item's timestamp
-     *
-     * \note    Timestamp is in UTC
-     */
-    QDateTime m_timestamp;
-
-    /*!
-     * \brief   Holds the event change log item's field name
-     */
-    QString m_fieldName;
-
-    /*!
-     * \brief   Holds the event change log item's original value
-     */
-    QVariant m_fromValue;
-
-    /*!
-     * \brief   Holds the event change log item's new value
-     */
-    QVariant m_toValue;
-
-    /*!
-     * \brief   Holds the event change log item's user ID
+     * \brief   Holds the event change log item's data, which is implicitly shared between the
+     *          copies
      */
-    qint64 m_userId;
-
-    /*!
-     * \brief   Holds the event change log item's comment
-     */
-    QString m_comment;
+    QSharedDataPointer<EventChangeLogItemData> m_data;
 };
 
 }
 }
 
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::EventChangeLogItem, Q_MOVABLE_TYPE);
+
 #endif // OPENTIMETRACKER_SERVER_EVENTCHANGELOGITEM_HPP
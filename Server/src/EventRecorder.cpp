@@ -0,0 +1,226 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "EventRecorder.hpp"
+#include <QtCore/QtDebug>
+#include "Database/DatabaseManagement.hpp"
+#include "Database/EventManagement.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+EventRecorder::EventRecorder(QObject *parent)
+    : QObject(parent),
+      m_flushDelay(100),
+      m_flushTimer(),
+      m_pendingEvents(),
+      m_droppedEventCount(0),
+      m_maxWriteAttempts(3),
+      m_maxEventsPerFlush(32)
+{
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, SIGNAL(timeout()), this, SLOT(flushQueuedEvents()));
+}
+
+EventRecorder::~EventRecorder()
+{
+    flush();
+
+    // Events that could not be written are lost at this point
+    foreach (const PendingEvent &pendingEvent, m_pendingEvents)
+    {
+        qWarning() << "Dropped event of user" << pendingEvent.event.userId()
+                   << "at" << pendingEvent.event.timestamp().toString(Qt::ISODate)
+                   << "with type" << static_cast<int>(pendingEvent.event.type());
+        m_droppedEventCount++;
+    }
+
+    m_pendingEvents.clear();
+}
+
+int EventRecorder::flushDelay() const
+{
+    return m_flushDelay;
+}
+
+void EventRecorder::setFlushDelay(const int delay)
+{
+    m_flushDelay = qMax(delay, 0);
+}
+
+int EventRecorder::pendingEventCount() const
+{
+    return m_pendingEvents.size();
+}
+
+int EventRecorder::droppedEventCount() const
+{
+    return m_droppedEventCount;
+}
+
+int EventRecorder::maxWriteAttempts() const
+{
+    return m_maxWriteAttempts;
+}
+
+void EventRecorder::setMaxWriteAttempts(const int attempts)
+{
+    m_maxWriteAttempts = qMax(attempts, 1);
+}
+
+int EventRecorder::maxEventsPerFlush() const
+{
+    return m_maxEventsPerFlush;
+}
+
+void EventRecorder::setMaxEventsPerFlush(const int count)
+{
+    m_maxEventsPerFlush = qMax(count, 0);
+}
+
+void EventRecorder::addEvent(const QDateTime &timestamp,
+                             const qint64 &userId,
+                             const Event::Type type)
+{
+    Event event;
+    event.setTimestamp(timestamp);
+    event.setUserId(userId);
+    event.setType(type);
+
+    PendingEvent pendingEvent;
+    pendingEvent.event = event;
+    pendingEvent.failedAttempts = 0;
+
+    m_pendingEvents.append(pendingEvent);
+
+    // Schedule writing of the queued events, all events queued until then are written together
+    if (!m_flushTimer.isActive())
+    {
+        m_flushTimer.start(m_flushDelay);
+    }
+}
+
+void EventRecorder::flush()
+{
+    m_flushTimer.stop();
+
+    if (!m_pendingEvents.isEmpty())
+    {
+        writeEvents(m_pendingEvents.size());
+    }
+
+    // Retry writing of the failed events later
+    if (!m_pendingEvents.isEmpty())
+    {
+        m_flushTimer.start(m_flushDelay);
+    }
+}
+
+void EventRecorder::flushQueuedEvents()
+{
+    int count = m_pendingEvents.size();
+
+    if ((m_maxEventsPerFlush > 0) && (m_maxEventsPerFlush < count))
+    {
+        count = m_maxEventsPerFlush;
+    }
+
+    const bool success = (count > 0) ? writeEvents(count) : true;
+
+    // Write the remaining events right after the other queued work of the thread, on error retry
+    // writing later
+    if (!m_pendingEvents.isEmpty())
+    {
+        m_flushTimer.start(success ? 0 : m_flushDelay);
+    }
+}
+
+bool EventRecorder::writeEvents(const int count)
+{
+    // Write the events in a single transaction
+    bool success = Database::DatabaseManagement::beginTransaction();
+
+    if (success)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            const Event &event = m_pendingEvents.at(i).event;
+            success = Database::EventManagement::addEvent(event.timestamp(),
+                                                          event.userId(),
+                                                          event.type());
+
+            if (!success)
+            {
+                break;
+            }
+        }
+
+        if (success)
+        {
+            success = Database::DatabaseManagement::commitTransaction();
+        }
+
+        if (!success)
+        {
+            Database::DatabaseManagement::rollbackTransaction();
+        }
+    }
+
+    if (success)
+    {
+        m_pendingEvents.erase(m_pendingEvents.begin(), m_pendingEvents.begin() + count);
+    }
+    else
+    {
+        // Error, write the events one by one so that a single invalid event doesn't prevent
+        // writing of all the others. The events that can't be written are kept for the next
+        // flush until they reach the maximum number of write attempts.
+        QList<PendingEvent> failedEvents;
+        bool dropped = false;
+
+        for (int i = 0; i < count; i++)
+        {
+            PendingEvent pendingEvent = m_pendingEvents.at(i);
+
+            if (!Database::EventManagement::addEvent(pendingEvent.event.timestamp(),
+                                                     pendingEvent.event.userId(),
+                                                     pendingEvent.event.type()))
+            {
+                pendingEvent.failedAttempts++;
+
+                qWarning() << "Failed to write event of user" << pendingEvent.event.userId()
+                           << "at" << pendingEvent.event.timestamp().toString(Qt::ISODate)
+                           << "with type" << static_cast<int>(pendingEvent.event.type())
+                           << "(attempt" << pendingEvent.failedAttempts << "of"
+                           << m_maxWriteAttempts << ")";
+
+                if (pendingEvent.failedAttempts < m_maxWriteAttempts)
+                {
+                    failedEvents.append(pendingEvent);
+                }
+                else
+                {
+                    m_droppedEventCount++;
+                    dropped = true;
+                }
+            }
+        }
+
+        // Failed events stay ahead of the events that were not written yet
+        m_pendingEvents = failedEvents + m_pendingEvents.mid(count);
+        success = failedEvents.isEmpty() && (!dropped);
+    }
+
+    return success;
+}
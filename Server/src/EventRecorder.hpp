@@ -0,0 +1,205 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_EVENTRECORDER_HPP
+#define OPENTIMETRACKER_SERVER_EVENTRECORDER_HPP
+
+#include <QtCore/QObject>
+#include <QtCore/QList>
+#include <QtCore/QTimer>
+#include "Event.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Write-behind stage for recording events in the database
+ *
+ * Events are first only queued in memory. The queued events are written to the database in a
+ * single transaction shortly afterwards, so that the caller doesn't have to wait for the database.
+ *
+ * If the transaction fails the events are written one by one. Events that still can't be written
+ * are logged and stay queued for the next flush, they are only dropped after the maximum number of
+ * write attempts.
+ *
+ * \note    The event recorder must live in the same thread as the database connection, which is the
+ *          server's thread. Writing blocks that thread, so a timed flush writes at most the maximum
+ *          number of events per flush (in the transaction as well as one by one) and the remaining
+ *          events are written by the following flushes, which run after the other queued work.
+ */
+class EventRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief   Constructor
+     *
+     * \param   parent  Pointer to the parent object
+     */
+    explicit EventRecorder(QObject *parent = 0);
+
+    /*!
+     * \brief   Destructor
+     *
+     * Writes all queued events to the database, events that can't be written are dropped
+     */
+    ~EventRecorder();
+
+    /*!
+     * \brief   Gets the flush delay
+     *
+     * \return  Maximum time that an event is queued before it is written (in milliseconds)
+     */
+    int flushDelay() const;
+
+    /*!
+     * \brief   Sets the flush delay
+     *
+     * \param   delay   Maximum time that an event is queued before it is written (in milliseconds)
+     */
+    void setFlushDelay(const int delay);
+
+    /*!
+     * \brief   Gets the number of events waiting to be written to the database
+     *
+     * \return  Number of queued events
+     */
+    int pendingEventCount() const;
+
+    /*!
+     * \brief   Gets the number of events that could not be written to the database
+     *
+     * \return  Number of dropped events
+     */
+    int droppedEventCount() const;
+
+    /*!
+     * \brief   Gets the maximum number of write attempts
+     *
+     * \return  Maximum number of times writing of an event is attempted before it is dropped
+     */
+    int maxWriteAttempts() const;
+
+    /*!
+     * \brief   Sets the maximum number of write attempts
+     *
+     * \param   attempts    Maximum number of times writing of an event is attempted before it is
+     *                      dropped
+     */
+    void setMaxWriteAttempts(const int attempts);
+
+    /*!
+     * \brief   Gets the maximum number of events written by a timed flush
+     *
+     * \return  Maximum number of events per flush (zero if not limited)
+     */
+    int maxEventsPerFlush() const;
+
+    /*!
+     * \brief   Sets the maximum number of events written by a timed flush
+     *
+     * \param   count   Maximum number of events per flush (zero if not limited)
+     */
+    void setMaxEventsPerFlush(const int count);
+
+    /*!
+     * \brief   Queues a new event for writing to the database
+     *
+     * \param   timestamp   Event's timestamp
+     * \param   userId      Event's user ID
+     * \param   type        Event's type
+     */
+    void addEvent(const QDateTime &timestamp, const qint64 &userId, const Event::Type type);
+
+public slots:
+    /*!
+     * \brief   Writes all queued events to the database
+     *
+     * \note    This ignores the maximum number of events per flush and blocks until all events were
+     *          written once, it is meant for stopping the server
+     */
+    void flush();
+
+private slots:
+    /*!
+     * \brief   Writes the oldest queued events (up to the maximum number of events per flush)
+     */
+    void flushQueuedEvents();
+
+private:
+    /*!
+     * \brief   Holds an event that is waiting to be written to the database
+     */
+    struct PendingEvent
+    {
+        /*!
+         * \brief   Event
+         */
+        Event event;
+
+        /*!
+         * \brief   Number of failed attempts to write the event
+         */
+        int failedAttempts;
+    };
+
+    /*!
+     * \brief   Holds the maximum time that an event is queued (in milliseconds)
+     */
+    int m_flushDelay;
+
+    /*!
+     * \brief   Holds the timer that triggers writing of the queued events
+     */
+    QTimer m_flushTimer;
+
+    /*!
+     * \brief   Holds the events that are waiting to be written to the database
+     */
+    QList<PendingEvent> m_pendingEvents;
+
+    /*!
+     * \brief   Holds the number of events that could not be written to the database
+     */
+    int m_droppedEventCount;
+
+    /*!
+     * \brief   Holds the maximum number of times writing of an event is attempted
+     */
+    int m_maxWriteAttempts;
+
+    /*!
+     * \brief   Holds the maximum number of events written by a timed flush
+     */
+    int m_maxEventsPerFlush;
+
+    /*!
+     * \brief   Writes the oldest queued events to the database
+     *
+     * \param   count   Number of events to write
+     *
+     * \retval  true    All of the events were written
+     * \retval  false   Some of the events failed and were either queued again or dropped
+     */
+    bool writeEvents(const int count);
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_EVENTRECORDER_HPP
@@ -0,0 +1,203 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QtAlgorithms>
+#include "GroupMembership.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+GroupMembership::GroupMembership()
+    : m_userSlots(),
+      m_userIds(),
+      m_members()
+{
+}
+
+void GroupMembership::clear()
+{
+    m_userSlots.clear();
+    m_userIds.clear();
+    m_members.clear();
+}
+
+int GroupMembership::userCount() const
+{
+    return m_userIds.size();
+}
+
+bool GroupMembership::addUser(const qint64 &userId)
+{
+    bool success = false;
+
+    if ((userId > 0LL) && (!m_userSlots.contains(userId)))
+    {
+        // Assign the next free slot to the user
+        m_userSlots.insert(userId, m_userIds.size());
+        m_userIds.append(userId);
+        success = true;
+    }
+
+    return success;
+}
+
+bool GroupMembership::addMember(const qint64 &userGroupId, const qint64 &userId)
+{
+    bool success = false;
+    const QHash<qint64, int>::const_iterator it = m_userSlots.constFind(userId);
+
+    if ((userGroupId > 0LL) && (it != m_userSlots.constEnd()))
+    {
+        m_members[userGroupId].insert(it.value());
+        success = true;
+    }
+
+    return success;
+}
+
+bool GroupMembership::removeMember(const qint64 &userGroupId, const qint64 &userId)
+{
+    bool success = false;
+    const QHash<qint64, int>::const_iterator it = m_userSlots.constFind(userId);
+
+    if (it != m_userSlots.constEnd())
+    {
+        const QHash<qint64, UserSet>::iterator membersIt = m_members.find(userGroupId);
+
+        if (membersIt != m_members.end())
+        {
+            membersIt.value().remove(it.value());
+
+            if (membersIt.value().isEmpty())
+            {
+                m_members.erase(membersIt);
+            }
+        }
+
+        success = true;
+    }
+
+    return success;
+}
+
+UserSet GroupMembership::members(const qint64 &userGroupId) const
+{
+    return m_members.value(userGroupId);
+}
+
+UserSet GroupMembership::membersOfAny(const QList<qint64> &userGroupIds) const
+{
+    UserSet userSet;
+
+    foreach (const qint64 userGroupId, userGroupIds)
+    {
+        const QHash<qint64, UserSet>::const_iterator it = m_members.constFind(userGroupId);
+
+        if (it != m_members.constEnd())
+        {
+            userSet.unite(it.value());
+        }
+    }
+
+    return userSet;
+}
+
+UserSet GroupMembership::membersOfAll(const QList<qint64> &userGroupIds) const
+{
+    UserSet userSet;
+
+    if (!userGroupIds.isEmpty())
+    {
+        userSet = m_members.value(userGroupIds.first());
+
+        for (int i = 1; (i < userGroupIds.size()) && (!userSet.isEmpty()); i++)
+        {
+            userSet.intersect(m_members.value(userGroupIds.at(i)));
+        }
+    }
+
+    return userSet;
+}
+
+int GroupMembership::memberCount(const qint64 &userGroupId) const
+{
+    int count = 0;
+    const QHash<qint64, UserSet>::const_iterator it = m_members.constFind(userGroupId);
+
+    if (it != m_members.constEnd())
+    {
+        count = it.value().count();
+    }
+
+    return count;
+}
+
+bool GroupMembership::isMember(const qint64 &userGroupId, const qint64 &userId) const
+{
+    bool member = false;
+    const QHash<qint64, int>::const_iterator it = m_userSlots.constFind(userId);
+
+    if (it != m_userSlots.constEnd())
+    {
+        const QHash<qint64, UserSet>::const_iterator membersIt = m_members.constFind(userGroupId);
+
+        if (membersIt != m_members.constEnd())
+        {
+            member = membersIt.value().contains(it.value());
+        }
+    }
+
+    return member;
+}
+
+QVector<qint64> GroupMembership::userGroupsOfUser(const qint64 &userId) const
+{
+    QVector<qint64> userGroupIds;
+    const QHash<qint64, int>::const_iterator it = m_userSlots.constFind(userId);
+
+    if (it != m_userSlots.constEnd())
+    {
+        // Check the user's bit in each user group
+        for (QHash<qint64, UserSet>::const_iterator membersIt = m_members.constBegin();
+             membersIt != m_members.constEnd();
+             ++membersIt)
+        {
+            if (membersIt.value().contains(it.value()))
+            {
+                userGroupIds.append(membersIt.key());
+            }
+        }
+
+        qSort(userGroupIds);
+    }
+
+    return userGroupIds;
+}
+
+QVector<qint64> GroupMembership::userIds(const UserSet &userSet) const
+{
+    const QVector<int> slotList = userSet.toSlotList();
+    QVector<qint64> userIdList;
+    userIdList.reserve(slotList.size());
+
+    foreach (const int slot, slotList)
+    {
+        if (slot < m_userIds.size())
+        {
+            userIdList.append(m_userIds.at(slot));
+        }
+    }
+
+    return userIdList;
+}
@@ -0,0 +1,173 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_GROUPMEMBERSHIP_HPP
+#define OPENTIMETRACKER_SERVER_GROUPMEMBERSHIP_HPP
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include "UserSet.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Membership of the users in the user groups
+ *
+ * Each user gets a dense slot index when it is added and each user group keeps its members as a
+ * UserSet over these slots. Queries over several user groups (e.g. "users in group A or B but not
+ * in group C") are then answered with word-wide bit operations instead of merging ID lists.
+ */
+class GroupMembership
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    GroupMembership();
+
+    /*!
+     * \brief   Removes all users and memberships
+     */
+    void clear();
+
+    /*!
+     * \brief   Gets the number of users
+     *
+     * \return  Number of users
+     */
+    int userCount() const;
+
+    /*!
+     * \brief   Adds the user
+     *
+     * \param   userId  ID of the user
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid ID or the user was already added
+     */
+    bool addUser(const qint64 &userId);
+
+    /*!
+     * \brief   Adds the user to the user group
+     *
+     * \param   userGroupId ID of the user group
+     * \param   userId      ID of the user
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid user group ID or unknown user
+     */
+    bool addMember(const qint64 &userGroupId, const qint64 &userId);
+
+    /*!
+     * \brief   Removes the user from the user group
+     *
+     * \param   userGroupId ID of the user group
+     * \param   userId      ID of the user
+     *
+     * \retval  true    Success
+     * \retval  false   Error, unknown user
+     */
+    bool removeMember(const qint64 &userGroupId, const qint64 &userId);
+
+    /*!
+     * \brief   Gets the members of the user group
+     *
+     * \param   userGroupId ID of the user group
+     *
+     * \return  Members of the user group (empty for an unknown user group)
+     */
+    UserSet members(const qint64 &userGroupId) const;
+
+    /*!
+     * \brief   Gets the users that are members of at least one of the user groups
+     *
+     * \param   userGroupIds    IDs of the user groups
+     *
+     * \return  Union of the members of the user groups
+     */
+    UserSet membersOfAny(const QList<qint64> &userGroupIds) const;
+
+    /*!
+     * \brief   Gets the users that are members of all of the user groups
+     *
+     * \param   userGroupIds    IDs of the user groups
+     *
+     * \return  Intersection of the members of the user groups (empty if no user group is given)
+     */
+    UserSet membersOfAll(const QList<qint64> &userGroupIds) const;
+
+    /*!
+     * \brief   Gets the number of members of the user group
+     *
+     * \param   userGroupId ID of the user group
+     *
+     * \return  Number of members
+     */
+    int memberCount(const qint64 &userGroupId) const;
+
+    /*!
+     * \brief   Checks if the user is a member of the user group
+     *
+     * \param   userGroupId ID of the user group
+     * \param   userId      ID of the user
+     *
+     * \retval  true    User is a member of the user group
+     * \retval  false   User is not a member of the user group
+     */
+    bool isMember(const qint64 &userGroupId, const qint64 &userId) const;
+
+    /*!
+     * \brief   Gets the user groups of the user
+     *
+     * \param   userId  ID of the user
+     *
+     * \return  IDs of the user groups in ascending order
+     */
+    QVector<qint64> userGroupsOfUser(const qint64 &userId) const;
+
+    /*!
+     * \brief   Converts the set of user slots to user IDs
+     *
+     * \param   userSet Set of user slots
+     *
+     * \return  IDs of the users in the order in which they were added
+     */
+    QVector<qint64> userIds(const UserSet &userSet) const;
+
+private:
+    /*!
+     * \brief   Holds the slot index of each user (by user ID)
+     */
+    QHash<qint64, int> m_userSlots;
+
+    /*!
+     * \brief   Holds the user ID of each slot
+     */
+    QVector<qint64> m_userIds;
+
+    /*!
+     * \brief   Holds the members of each user group (by user group ID)
+     */
+    QHash<qint64, UserSet> m_members;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_GROUPMEMBERSHIP_HPP
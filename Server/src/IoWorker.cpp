@@ -0,0 +1,97 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "IoWorker.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+IoWorker::IoWorker(QObject *parent)
+    : QObject(parent),
+      m_keepAliveInterval(0),
+      m_maxFrameSize(0),
+      m_maxInputBufferSize(0),
+      m_compressionThreshold(0)
+{
+}
+
+int IoWorker::keepAliveInterval() const
+{
+    return m_keepAliveInterval;
+}
+
+void IoWorker::setKeepAliveInterval(const int interval)
+{
+    m_keepAliveInterval = interval;
+}
+
+int IoWorker::maxFrameSize() const
+{
+    return m_maxFrameSize;
+}
+
+void IoWorker::setMaxFrameSize(const int size)
+{
+    m_maxFrameSize = size;
+}
+
+int IoWorker::maxInputBufferSize() const
+{
+    return m_maxInputBufferSize;
+}
+
+void IoWorker::setMaxInputBufferSize(const int size)
+{
+    m_maxInputBufferSize = size;
+}
+
+int IoWorker::compressionThreshold() const
+{
+    return m_compressionThreshold;
+}
+
+void IoWorker::setCompressionThreshold(const int size)
+{
+    m_compressionThreshold = size;
+}
+
+void IoWorker::addClient(qintptr socketDescriptor)
+{
+    // Create the socket in this thread
+    QTcpSocket *socket = new QTcpSocket();
+
+    if (socket->setSocketDescriptor(socketDescriptor))
+    {
+        // Create the client, the notification about the disconnect is forwarded through this
+        // object so that it always comes after the notification about the new client
+        Client *client = new Client(this, socket);
+        client->setKeepAliveInterval(m_keepAliveInterval);
+        client->setMaxFrameSize(m_maxFrameSize);
+        client->setMaxInputBufferSize(m_maxInputBufferSize);
+        client->setCompressionThreshold(m_compressionThreshold);
+        connect(client, SIGNAL(disconnected(Client*)), this, SIGNAL(clientDisconnected(Client*)));
+        connect(client, SIGNAL(requestReceived(Client*,QSharedPointer<Packets::Packet>)),
+                this, SIGNAL(requestReceived(Client*,QSharedPointer<Packets::Packet>)));
+
+        emit clientAdded(client);
+        client = nullptr;
+    }
+    else
+    {
+        // Error, failed to take over the connection
+        delete socket;
+    }
+
+    socket = nullptr;
+}
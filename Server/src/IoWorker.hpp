@@ -0,0 +1,168 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_IOWORKER_HPP
+#define OPENTIMETRACKER_SERVER_IOWORKER_HPP
+
+#include <QtCore/QObject>
+#include "Client.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Creates and owns clients in the thread in which it lives
+ *
+ * Each I/O worker is moved to its own thread with its own event loop. All network I/O, packet
+ * parsing and packet writing of the clients owned by the worker is executed in that thread.
+ *
+ * Clients are only deleted by the server (with QObject::deleteLater()) or when the worker itself
+ * is deleted.
+ */
+class IoWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief   Constructor
+     *
+     * \param   parent  Pointer to the parent object
+     */
+    explicit IoWorker(QObject *parent = 0);
+
+    /*!
+     * \brief   Gets the keep-alive interval of new clients
+     *
+     * \return  Keep-alive interval (in milliseconds)
+     */
+    int keepAliveInterval() const;
+
+    /*!
+     * \brief   Sets the keep-alive interval of new clients
+     *
+     * \param   interval    Keep-alive interval (in milliseconds)
+     *
+     * \note    This must be set before the worker is moved to its thread
+     */
+    void setKeepAliveInterval(const int interval);
+
+    /*!
+     * \brief   Gets the maximum frame size of new clients
+     *
+     * \return  Maximum frame size (in bytes)
+     */
+    int maxFrameSize() const;
+
+    /*!
+     * \brief   Sets the maximum frame size of new clients
+     *
+     * \param   size    Maximum frame size (in bytes)
+     *
+     * \note    This must be set before the worker is moved to its thread
+     */
+    void setMaxFrameSize(const int size);
+
+    /*!
+     * \brief   Gets the maximum input buffer size of new clients
+     *
+     * \return  Maximum input buffer size (in bytes)
+     */
+    int maxInputBufferSize() const;
+
+    /*!
+     * \brief   Sets the maximum input buffer size of new clients
+     *
+     * \param   size    Maximum input buffer size (in bytes)
+     *
+     * \note    This must be set before the worker is moved to its thread
+     */
+    void setMaxInputBufferSize(const int size);
+
+    /*!
+     * \brief   Gets the compression threshold of new clients
+     *
+     * \return  Compression threshold (in bytes)
+     */
+    int compressionThreshold() const;
+
+    /*!
+     * \brief   Sets the compression threshold of new clients
+     *
+     * \param   size    Compression threshold (in bytes)
+     *
+     * \note    This must be set before the worker is moved to its thread
+     */
+    void setCompressionThreshold(const int size);
+
+signals:
+    /*!
+     * \brief   Notification that a new client was created
+     *
+     * \param   client  Pointer to the new client
+     */
+    void clientAdded(Client *client);
+
+    /*!
+     * \brief   Notification that the client's socket was disconnected
+     *
+     * \param   client  Pointer to the client that was disconnected
+     */
+    void clientDisconnected(Client *client);
+
+    /*!
+     * \brief   Notification that one of the clients received a request
+     *
+     * \param   client  Pointer to the client that received the request
+     * \param   request Request packet
+     */
+    void requestReceived(Client *client, QSharedPointer<Packets::Packet> request);
+
+public slots:
+    /*!
+     * \brief   Creates a client for the accepted connection
+     *
+     * \param   socketDescriptor    Socket descriptor of the accepted connection
+     */
+    void addClient(qintptr socketDescriptor);
+
+private:
+    /*!
+     * \brief   Holds the keep-alive interval of new clients (in milliseconds)
+     */
+    int m_keepAliveInterval;
+
+    /*!
+     * \brief   Holds the maximum frame size of new clients (in bytes)
+     */
+    int m_maxFrameSize;
+
+    /*!
+     * \brief   Holds the maximum input buffer size of new clients (in bytes)
+     */
+    int m_maxInputBufferSize;
+
+    /*!
+     * \brief   Holds the compression threshold of new clients (in bytes)
+     */
+    int m_compressionThreshold;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_IOWORKER_HPP
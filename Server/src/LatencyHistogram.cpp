@@ -0,0 +1,165 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LatencyHistogram.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+static const int BUCKET_COUNT = 17;
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(BUCKET_COUNT, 0ULL),
+      m_count(0ULL),
+      m_minimum(0LL),
+      m_maximum(0LL),
+      m_sum(0LL)
+{
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram &other)
+    : m_buckets(other.m_buckets),
+      m_count(other.m_count),
+      m_minimum(other.m_minimum),
+      m_maximum(other.m_maximum),
+      m_sum(other.m_sum)
+{
+}
+
+LatencyHistogram &LatencyHistogram::operator =(const LatencyHistogram &other)
+{
+    if (this != &other)
+    {
+        m_buckets = other.m_buckets;
+        m_count = other.m_count;
+        m_minimum = other.m_minimum;
+        m_maximum = other.m_maximum;
+        m_sum = other.m_sum;
+    }
+
+    return *this;
+}
+
+void LatencyHistogram::addSample(const qint64 &latency)
+{
+    const qint64 sample = qMax(latency, 0LL);
+
+    // Find the bucket: the index of the bucket is the number of significant bits of the sample
+    int index = 0;
+
+    while ((index < (BUCKET_COUNT - 1)) && ((sample >> index) > 0LL))
+    {
+        index++;
+    }
+
+    m_buckets[index]++;
+
+    // Update the statistics
+    if (m_count == 0ULL)
+    {
+        m_minimum = sample;
+        m_maximum = sample;
+    }
+    else
+    {
+        m_minimum = qMin(m_minimum, sample);
+        m_maximum = qMax(m_maximum, sample);
+    }
+
+    m_count++;
+    m_sum += sample;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    if (other.m_count > 0ULL)
+    {
+        for (int i = 0; i < BUCKET_COUNT; i++)
+        {
+            m_buckets[i] += other.m_buckets.at(i);
+        }
+
+        if (m_count == 0ULL)
+        {
+            m_minimum = other.m_minimum;
+            m_maximum = other.m_maximum;
+        }
+        else
+        {
+            m_minimum = qMin(m_minimum, other.m_minimum);
+            m_maximum = qMax(m_maximum, other.m_maximum);
+        }
+
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+    }
+}
+
+void LatencyHistogram::clear()
+{
+    m_buckets.fill(0ULL);
+    m_count = 0ULL;
+    m_minimum = 0LL;
+    m_maximum = 0LL;
+    m_sum = 0LL;
+}
+
+quint64 LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+qint64 LatencyHistogram::minimum() const
+{
+    return m_minimum;
+}
+
+qint64 LatencyHistogram::maximum() const
+{
+    return m_maximum;
+}
+
+double LatencyHistogram::average() const
+{
+    double value = 0.0;
+
+    if (m_count > 0ULL)
+    {
+        value = static_cast<double>(m_sum) / static_cast<double>(m_count);
+    }
+
+    return value;
+}
+
+int LatencyHistogram::bucketCount()
+{
+    return BUCKET_COUNT;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(const int index)
+{
+    qint64 upperBound = -1LL;
+
+    if ((index >= 0) && (index < (BUCKET_COUNT - 1)))
+    {
+        upperBound = 1LL << index;
+    }
+
+    return upperBound;
+}
+
+quint64 LatencyHistogram::bucketSampleCount(const int index) const
+{
+    return m_buckets.value(index, 0ULL);
+}
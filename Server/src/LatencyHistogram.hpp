@@ -0,0 +1,158 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_LATENCYHISTOGRAM_HPP
+#define OPENTIMETRACKER_SERVER_LATENCYHISTOGRAM_HPP
+
+#include <QtCore/QVector>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Histogram of latency samples
+ *
+ * Samples are counted in buckets with exponentially growing sizes: bucket 0 holds samples below
+ * 1 ms and bucket N holds samples from 2^(N-1) ms up to (but not including) 2^N ms. The last bucket
+ * also holds all larger samples.
+ */
+class LatencyHistogram
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    LatencyHistogram();
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    LatencyHistogram(const LatencyHistogram &other);
+
+    /*!
+     * \brief   operator =
+     * \param   other   Object to be copied
+     *
+     * \return  Reference to the this object
+     */
+    LatencyHistogram &operator =(const LatencyHistogram &other);
+
+    /*!
+     * \brief   Adds a sample to the histogram
+     *
+     * \param   latency Latency (in milliseconds)
+     */
+    void addSample(const qint64 &latency);
+
+    /*!
+     * \brief   Adds all samples of the other histogram to this histogram
+     *
+     * \param   other   Other histogram
+     */
+    void merge(const LatencyHistogram &other);
+
+    /*!
+     * \brief   Removes all samples from the histogram
+     */
+    void clear();
+
+    /*!
+     * \brief   Gets the number of samples
+     *
+     * \return  Number of samples
+     */
+    quint64 count() const;
+
+    /*!
+     * \brief   Gets the smallest sample
+     *
+     * \return  Smallest sample (in milliseconds) or zero if there are no samples
+     */
+    qint64 minimum() const;
+
+    /*!
+     * \brief   Gets the largest sample
+     *
+     * \return  Largest sample (in milliseconds) or zero if there are no samples
+     */
+    qint64 maximum() const;
+
+    /*!
+     * \brief   Gets the average of all samples
+     *
+     * \return  Average (in milliseconds) or zero if there are no samples
+     */
+    double average() const;
+
+    /*!
+     * \brief   Gets the number of buckets
+     *
+     * \return  Number of buckets
+     */
+    static int bucketCount();
+
+    /*!
+     * \brief   Gets the upper bound of the bucket
+     *
+     * \param   index   Index of the bucket
+     *
+     * \return  Upper bound of the bucket (in milliseconds) or a negative value for the last bucket
+     *          which has no upper bound
+     */
+    static qint64 bucketUpperBound(const int index);
+
+    /*!
+     * \brief   Gets the number of samples in the bucket
+     *
+     * \param   index   Index of the bucket
+     *
+     * \return  Number of samples
+     */
+    quint64 bucketSampleCount(const int index) const;
+
+private:
+    /*!
+     * \brief   Holds the number of samples in each bucket
+     */
+    QVector<quint64> m_buckets;
+
+    /*!
+     * \brief   Holds the number of samples
+     */
+    quint64 m_count;
+
+    /*!
+     * \brief   Holds the smallest sample
+     */
+    qint64 m_minimum;
+
+    /*!
+     * \brief   Holds the largest sample
+     */
+    qint64 m_maximum;
+
+    /*!
+     * \brief   Holds the sum of all samples
+     */
+    qint64 m_sum;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_LATENCYHISTOGRAM_HPP
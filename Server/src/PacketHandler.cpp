@@ -15,17 +15,23 @@
  */
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
 #include "PacketHandler.hpp"
 
 using namespace OpenTimeTracker::Server;
 
-quint32 PacketHandler::m_nextPacketId = 1U;
+QAtomicInteger<quint32> PacketHandler::m_nextPacketId(1U);
 
 PacketHandler::PacketHandler()
     : m_dataBuffer(),
+      m_scanIndex(1),
+      m_maxFrameSize(0),
+      m_maxBufferSize(0),
+      m_compressionThreshold(0),
       m_readPacket(nullptr),
       m_registeredPacketReaders(),
-      m_registeredPacketWriters()
+      m_registeredPacketWriters(),
+      m_jsonFormat(QJsonDocument::Indented)
 {
 }
 
@@ -40,9 +46,22 @@ PacketHandler::~PacketHandler()
     m_registeredPacketWriters.clear();
 }
 
-void PacketHandler::addData(const QByteArray &data)
+bool PacketHandler::addData(const QByteArray &data)
 {
-    m_dataBuffer.append(data);
+    bool success = false;
+
+    if ((m_maxBufferSize <= 0) || ((m_dataBuffer.size() + data.size()) <= m_maxBufferSize))
+    {
+        m_dataBuffer.append(data);
+        success = true;
+    }
+
+    return success;
+}
+
+int PacketHandler::bufferedDataSize() const
+{
+    return m_dataBuffer.size();
 }
 
 PacketHandler::Result PacketHandler::read()
@@ -66,6 +85,11 @@ PacketHandler::Result PacketHandler::read()
             // STX found
             stxFound = true;
         }
+        else if (m_dataBuffer.at(0) == '\x01')
+        {
+            // SOH found, read compressed frame
+            result = readCompressedFrame();
+        }
         else
         {
             // Error, invalid format
@@ -83,18 +107,36 @@ PacketHandler::Result PacketHandler::read()
         }
         else
         {
-            const int etxIndex = m_dataBuffer.indexOf('\x03', 1);
+            // Continue the search where the previous one stopped so that the same data is not
+            // scanned again
+            const int etxIndex = m_dataBuffer.indexOf('\x03', m_scanIndex);
 
             if (etxIndex < 0)
             {
-                // More data is needed
-                result = Result_NeedMoreData;
+                m_scanIndex = m_dataBuffer.size();
+
+                if ((m_maxFrameSize > 0) && ((m_dataBuffer.size() - 1) > m_maxFrameSize))
+                {
+                    // Error, the packet payload is already too large
+                    result = Result_Error;
+                }
+                else
+                {
+                    // More data is needed
+                    result = Result_NeedMoreData;
+                }
+            }
+            else if ((m_maxFrameSize > 0) && ((etxIndex - 1) > m_maxFrameSize))
+            {
+                // Error, the packet payload is too large
+                result = Result_Error;
             }
             else
             {
                 // ETX found, extract packet payload
                 const QByteArray packetPayload = m_dataBuffer.mid(1, etxIndex - 1);
                 m_dataBuffer.remove(0, etxIndex + 1);
+                m_scanIndex = 1;
 
                 // Convert the packet payload to a packet object
                 Packets::Packet *packet = fromPacketPayload(packetPayload);
@@ -118,6 +160,67 @@ PacketHandler::Result PacketHandler::read()
     return result;
 }
 
+int PacketHandler::maxFrameSize() const
+{
+    return m_maxFrameSize;
+}
+
+void PacketHandler::setMaxFrameSize(const int size)
+{
+    m_maxFrameSize = size;
+}
+
+int PacketHandler::maxBufferSize() const
+{
+    return m_maxBufferSize;
+}
+
+void PacketHandler::setMaxBufferSize(const int size)
+{
+    m_maxBufferSize = size;
+}
+
+int PacketHandler::compressionThreshold() const
+{
+    return m_compressionThreshold;
+}
+
+void PacketHandler::setCompressionThreshold(const int size)
+{
+    m_compressionThreshold = size;
+}
+
+QByteArray PacketHandler::compressFrame(const QByteArray &packetData) const
+{
+    QByteArray frameData = packetData;
+
+    // Only uncompressed frames with a payload larger than the threshold are compressed
+    const int payloadSize = packetData.size() - 2;
+
+    if ((m_compressionThreshold > 0) &&
+        (payloadSize > m_compressionThreshold) &&
+        packetData.startsWith('\x02') &&
+        packetData.endsWith('\x03'))
+    {
+        const QByteArray compressedPayload = qCompress(packetData.mid(1, payloadSize));
+
+        // Use the compressed frame only if it is smaller than the uncompressed one
+        if ((compressedPayload.size() + 5) < packetData.size())
+        {
+            uchar length[4];
+            qToBigEndian<quint32>(static_cast<quint32>(compressedPayload.size()), length);
+
+            frameData.clear();
+            frameData.reserve(compressedPayload.size() + 5);
+            frameData.append('\x01');
+            frameData.append(reinterpret_cast<const char *>(length), 4);
+            frameData.append(compressedPayload);
+        }
+    }
+
+    return frameData;
+}
+
 Packets::Packet *PacketHandler::takePacket()
 {
     return m_readPacket.take();
@@ -212,15 +315,118 @@ bool PacketHandler::registerPacketWriter(Packets::PacketWriter *writer)
     // Register writer
     if (success)
     {
+        writer->setJsonFormat(m_jsonFormat);
         m_registeredPacketWriters.append(writer);
     }
 
     return success;
 }
 
+QJsonDocument::JsonFormat PacketHandler::jsonFormat() const
+{
+    return m_jsonFormat;
+}
+
+void PacketHandler::setJsonFormat(const QJsonDocument::JsonFormat format)
+{
+    m_jsonFormat = format;
+
+    // Apply the format to all registered writers
+    foreach (Packets::PacketWriter *registeredWriter, m_registeredPacketWriters)
+    {
+        registeredWriter->setJsonFormat(format);
+    }
+}
+
 quint32 PacketHandler::createPacketId()
 {
-    return m_nextPacketId++;
+    quint32 packetId = 0U;
+
+    // Skip zero when the counter wraps around
+    do
+    {
+        packetId = m_nextPacketId.fetchAndAddRelaxed(1U);
+    }
+    while (packetId == 0U);
+
+    return packetId;
+}
+
+PacketHandler::Result PacketHandler::readCompressedFrame()
+{
+    Result result = Result_Error;
+
+    // Format: <SOH>[length of the compressed data (32-bit, big-endian)][compressed packet payload]
+    const int headerSize = 5;
+
+    if (m_dataBuffer.size() < headerSize)
+    {
+        // More data is needed
+        result = Result_NeedMoreData;
+    }
+    else
+    {
+        const quint32 length = qFromBigEndian<quint32>(
+                                   reinterpret_cast<const uchar *>(m_dataBuffer.constData() + 1));
+
+        if ((length < 4U) ||
+            ((m_maxFrameSize > 0) && (length > static_cast<quint32>(m_maxFrameSize))))
+        {
+            // Error, invalid length or the compressed packet payload is too large
+            result = Result_Error;
+        }
+        else if (static_cast<quint32>(m_dataBuffer.size() - headerSize) < length)
+        {
+            // More data is needed
+            result = Result_NeedMoreData;
+        }
+        else
+        {
+            // Extract compressed packet payload
+            const QByteArray compressedPayload = m_dataBuffer.mid(headerSize,
+                                                                  static_cast<int>(length));
+            m_dataBuffer.remove(0, headerSize + static_cast<int>(length));
+            m_scanIndex = 1;
+
+            // Check the size of the uncompressed packet payload (stored by qCompress() at the
+            // beginning of the compressed data) before it is uncompressed
+            const quint32 payloadSize = qFromBigEndian<quint32>(
+                                            reinterpret_cast<const uchar *>(
+                                                compressedPayload.constData()));
+
+            if ((m_maxFrameSize > 0) && (payloadSize > static_cast<quint32>(m_maxFrameSize)))
+            {
+                // Error, the packet payload is too large
+                result = Result_Error;
+            }
+            else
+            {
+                // Uncompress the packet payload and convert it to a packet object
+                const QByteArray packetPayload = qUncompress(compressedPayload);
+                Packets::Packet *packet = nullptr;
+
+                if (!packetPayload.isEmpty())
+                {
+                    packet = fromPacketPayload(packetPayload);
+                }
+
+                if (packet == nullptr)
+                {
+                    // Error, failed to uncompress or to convert the packet
+                    result = Result_Error;
+                }
+                else
+                {
+                    // Store the read packet
+                    m_readPacket.reset(packet);
+                    packet = nullptr;
+                    result = Result_Success;
+                }
+            }
+        }
+    }
+
+    return result;
 }
 
 Packets::Packet *PacketHandler::fromPacketPayload(const QByteArray &packetPayload) const
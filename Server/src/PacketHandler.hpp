@@ -16,7 +16,9 @@
 #ifndef OPENTIMETRACKER_SERVER_PACKETHANDLER_HPP
 #define OPENTIMETRACKER_SERVER_PACKETHANDLER_HPP
 
+#include <QtCore/QAtomicInteger>
 #include <QtCore/QByteArray>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QList>
 #include "Packets/Packet.hpp"
@@ -45,6 +47,16 @@ namespace Server
  *      "id": 12345
  *  }
  * \endcode
+ *
+ * Packets are framed as:
+ * \code{.unparsed}
+ *  <STX>[packet payload in UTF-8]<ETX>
+ * \endcode
+ *
+ * Large packets can also be sent in compressed frames (see Packets::CompressionRequestPacket):
+ * \code{.unparsed}
+ *  <SOH>[length of the compressed data (32-bit, big-endian)][compressed packet payload]
+ * \endcode
  */
 class PacketHandler
 {
@@ -73,8 +85,18 @@ public:
      * \brief   Adds data to the data buffer
      *
      * \param   data    New data to add to the data buffer
+     *
+     * \retval  true    Success
+     * \retval  false   Error, the data would exceed the maximum buffer size (data is not added)
      */
-    void addData(const QByteArray &data);
+    bool addData(const QByteArray &data);
+
+    /*!
+     * \brief   Gets the size of the data in the data buffer
+     *
+     * \return  Size of the buffered data (in bytes) that was not read yet
+     */
+    int bufferedDataSize() const;
 
     /*!
      * \brief   Reads the data buffer and tries to extract a packet from it
@@ -82,9 +104,68 @@ public:
      * \return  Result_Success      A packet was successfully read
      * \return  Result_NeedMoreData More data is needed to be able to read the packet
      * \return  Result_Error        Reading of a packet failed
+     *
+     * Reading also fails as soon as the packet payload exceeds the maximum frame size, even if the
+     * end of the packet was not received yet. For compressed frames the maximum frame size limits
+     * both the compressed and the uncompressed packet payload.
      */
     Result read();
 
+    /*!
+     * \brief   Gets the maximum frame size
+     *
+     * \return  Maximum size of the packet payload (in bytes) or zero if it is not limited
+     */
+    int maxFrameSize() const;
+
+    /*!
+     * \brief   Sets the maximum frame size
+     *
+     * \param   size    Maximum size of the packet payload (in bytes) or zero to not limit it
+     */
+    void setMaxFrameSize(const int size);
+
+    /*!
+     * \brief   Gets the maximum buffer size
+     *
+     * \return  Maximum size of the data buffer (in bytes) or zero if it is not limited
+     */
+    int maxBufferSize() const;
+
+    /*!
+     * \brief   Sets the maximum buffer size
+     *
+     * \param   size    Maximum size of the data buffer (in bytes) or zero to not limit it
+     */
+    void setMaxBufferSize(const int size);
+
+    /*!
+     * \brief   Gets the compression threshold
+     *
+     * \return  Packet payload size (in bytes) above which the packets are compressed or zero if
+     *          compression is disabled
+     */
+    int compressionThreshold() const;
+
+    /*!
+     * \brief   Sets the compression threshold
+     *
+     * \param   size    Packet payload size (in bytes) above which the packets are compressed or
+     *                  zero to disable compression
+     */
+    void setCompressionThreshold(const int size);
+
+    /*!
+     * \brief   Converts the packet data to a compressed frame
+     *
+     * \param   packetData  Packet data (uncompressed frame)
+     *
+     * \return  Compressed frame or unmodified packet data if compression is disabled, if the
+     *          packet payload doesn't exceed the compression threshold or if compression doesn't
+     *          reduce its size
+     */
+    QByteArray compressFrame(const QByteArray &packetData) const;
+
     /*!
      * \brief   Takes the last parsed packet and returns it
      *
@@ -122,17 +203,45 @@ public:
      */
     bool registerPacketWriter(Packets::PacketWriter *writer);
 
+    /*!
+     * \brief   Gets the JSON format used by the packet writers
+     *
+     * \return  JSON format
+     */
+    QJsonDocument::JsonFormat jsonFormat() const;
+
+    /*!
+     * \brief   Sets the JSON format used by the packet writers
+     *
+     * \param   format  JSON format
+     *
+     * The format is applied to all already registered packet writers and to all packet writers
+     * that will be registered afterwards.
+     */
+    void setJsonFormat(const QJsonDocument::JsonFormat format);
+
     /*!
      * \brief   Creates a packet ID
      *
      * \return  Packet ID
      *
      * This method shall be used for generation of packet IDs. Every time this method is called a
-     * new packet ID is generated.
+     * new packet ID is generated. Zero is never used as a packet ID.
+     *
+     * \note    This method is thread-safe and lock-free
      */
     static quint32 createPacketId();
 
 private:
+    /*!
+     * \brief   Reads a compressed frame from the data buffer
+     *
+     * \return  Result_Success      A packet was successfully read
+     * \return  Result_NeedMoreData More data is needed to be able to read the packet
+     * \return  Result_Error        Reading of a packet failed
+     */
+    Result readCompressedFrame();
+
     /*!
      * \brief   Converts the packet payload into a packet object
      *
@@ -147,6 +256,26 @@ private:
      */
     QByteArray m_dataBuffer;
 
+    /*!
+     * \brief   Holds the index in the data buffer from which the search for ETX continues
+     */
+    int m_scanIndex;
+
+    /*!
+     * \brief   Holds the maximum size of the packet payload (in bytes)
+     */
+    int m_maxFrameSize;
+
+    /*!
+     * \brief   Holds the maximum size of the data buffer (in bytes)
+     */
+    int m_maxBufferSize;
+
+    /*!
+     * \brief   Holds the packet payload size (in bytes) above which the packets are compressed
+     */
+    int m_compressionThreshold;
+
     /*!
      * \brief   Holds the read packet
      */
@@ -162,10 +291,15 @@ private:
      */
     QList<Packets::PacketWriter *> m_registeredPacketWriters;
 
+    /*!
+     * \brief   Holds the JSON format used by the packet writers
+     */
+    QJsonDocument::JsonFormat m_jsonFormat;
+
     /*!
      * \brief   Holds the next packet ID
      */
-    static quint32 m_nextPacketId;
+    static QAtomicInteger<quint32> m_nextPacketId;
 };
 
 }
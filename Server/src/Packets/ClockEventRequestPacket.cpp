@@ -0,0 +1,101 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ClockEventRequestPacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+ClockEventRequestPacket::ClockEventRequestPacket(const Event::Type eventType)
+    : Packet(),
+      m_eventType(eventType),
+      m_userId(0),
+      m_timestamp()
+{
+}
+
+ClockEventRequestPacket::~ClockEventRequestPacket()
+{
+}
+
+QString ClockEventRequestPacket::type() const
+{
+    return ClockEventRequestPacket::staticType(m_eventType);
+}
+
+QString ClockEventRequestPacket::staticType(const Event::Type eventType)
+{
+    QString type;
+
+    switch (eventType)
+    {
+        case Event::Type_Started:
+        {
+            type = QStringLiteral("StartWorkingRequest");
+            break;
+        }
+
+        case Event::Type_OnBreak:
+        {
+            type = QStringLiteral("StartBreakRequest");
+            break;
+        }
+
+        case Event::Type_FromBreak:
+        {
+            type = QStringLiteral("EndBreakRequest");
+            break;
+        }
+
+        case Event::Type_Finished:
+        {
+            type = QStringLiteral("StopWorkingRequest");
+            break;
+        }
+
+        case Event::Type_Invalid:
+        default:
+        {
+            break;
+        }
+    }
+
+    return type;
+}
+
+Event::Type ClockEventRequestPacket::eventType() const
+{
+    return m_eventType;
+}
+
+qint64 ClockEventRequestPacket::userId() const
+{
+    return m_userId;
+}
+
+void ClockEventRequestPacket::setUserId(const qint64 &userIdValue)
+{
+    m_userId = userIdValue;
+}
+
+QDateTime ClockEventRequestPacket::timestamp() const
+{
+    return m_timestamp;
+}
+
+void ClockEventRequestPacket::setTimestamp(const QDateTime &timestampValue)
+{
+    m_timestamp = timestampValue;
+}
@@ -0,0 +1,124 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_CLOCKEVENTREQUESTPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_CLOCKEVENTREQUESTPACKET_HPP
+
+#include <QtCore/QDateTime>
+#include "Packet.hpp"
+#include "../Event.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Clock Event Request
+ *
+ * Requests a change of the user's working state. The packet type depends on the event type:
+ * - Event::Type_Started: "StartWorkingRequest"
+ * - Event::Type_OnBreak: "StartBreakRequest"
+ * - Event::Type_FromBreak: "EndBreakRequest"
+ * - Event::Type_Finished: "StopWorkingRequest"
+ */
+class ClockEventRequestPacket : public Packet
+{
+public:
+    /*!
+     * \brief   Constructor
+     *
+     * \param   eventType   Event type
+     */
+    explicit ClockEventRequestPacket(const Event::Type eventType);
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~ClockEventRequestPacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \brief   Gets packet type for the event type
+     *
+     * \param   eventType   Event type
+     *
+     * \return  Packet type or an empty string for an invalid event type
+     */
+    static QString staticType(const Event::Type eventType);
+
+    /*!
+     * \brief   Gets the event type
+     *
+     * \return  Event type
+     */
+    Event::Type eventType() const;
+
+    /*!
+     * \brief   Gets the user ID
+     *
+     * \return  User ID
+     */
+    qint64 userId() const;
+
+    /*!
+     * \brief   Sets the user ID
+     *
+     * \param   userIdValue     User ID value
+     */
+    void setUserId(const qint64 &userIdValue);
+
+    /*!
+     * \brief   Gets the timestamp of the event
+     *
+     * \return  Timestamp or an invalid timestamp if the server shall use its current time
+     */
+    QDateTime timestamp() const;
+
+    /*!
+     * \brief   Sets the timestamp of the event
+     *
+     * \param   timestampValue  Timestamp value
+     */
+    void setTimestamp(const QDateTime &timestampValue);
+
+private:
+    /*!
+     * \brief   Holds the event type
+     */
+    Event::Type m_eventType;
+
+    /*!
+     * \brief   Holds the user ID
+     */
+    qint64 m_userId;
+
+    /*!
+     * \brief   Holds the timestamp of the event
+     */
+    QDateTime m_timestamp;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_CLOCKEVENTREQUESTPACKET_HPP
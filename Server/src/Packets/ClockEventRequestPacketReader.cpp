@@ -0,0 +1,109 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ClockEventRequestPacket.hpp"
+#include "ClockEventRequestPacketReader.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+ClockEventRequestPacketReader::ClockEventRequestPacketReader(const Event::Type eventType)
+    : PacketReader(),
+      m_eventType(eventType)
+{
+}
+
+ClockEventRequestPacketReader::~ClockEventRequestPacketReader()
+{
+}
+
+QString ClockEventRequestPacketReader::packetType() const
+{
+    return ClockEventRequestPacket::staticType(m_eventType);
+}
+
+Packet *ClockEventRequestPacketReader::createPacket() const
+{
+    return new ClockEventRequestPacket(m_eventType);
+}
+
+bool ClockEventRequestPacketReader::readBody(const QJsonObject &packetObject, Packet *packet) const
+{
+    bool success = false;
+
+    // Check input parameters
+    if ((!packetObject.isEmpty()) && (packet != nullptr))
+    {
+        success = true;
+    }
+
+    // Downcast packet pointer to the derived class
+    ClockEventRequestPacket *requestPacket = nullptr;
+
+    if (success)
+    {
+        requestPacket = dynamic_cast<ClockEventRequestPacket *>(packet);
+
+        if (requestPacket == nullptr)
+        {
+            success = false;
+        }
+    }
+
+    // Read user ID
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("userId"))
+        {
+            const QJsonValue value = packetObject["userId"];
+
+            if (value.isDouble())
+            {
+                const qint64 userId = qRound64(value.toDouble(-1.0));
+
+                if (userId > 0LL)
+                {
+                    requestPacket->setUserId(userId);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    // Read timestamp (optional)
+    if (success)
+    {
+        if (packetObject.contains("timestamp"))
+        {
+            success = false;
+            const QJsonValue value = packetObject["timestamp"];
+
+            if (value.isString())
+            {
+                const QDateTime timestamp = QDateTime::fromString(value.toString(), Qt::ISODate);
+
+                if (timestamp.isValid())
+                {
+                    requestPacket->setTimestamp(timestamp);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    return success;
+}
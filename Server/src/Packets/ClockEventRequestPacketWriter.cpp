@@ -0,0 +1,60 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ClockEventRequestPacket.hpp"
+#include "ClockEventRequestPacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+ClockEventRequestPacketWriter::ClockEventRequestPacketWriter(const Event::Type eventType)
+    : PacketWriter(),
+      m_eventType(eventType)
+{
+}
+
+ClockEventRequestPacketWriter::~ClockEventRequestPacketWriter()
+{
+}
+
+QString ClockEventRequestPacketWriter::packetType() const
+{
+    return ClockEventRequestPacket::staticType(m_eventType);
+}
+
+bool ClockEventRequestPacketWriter::writeBody(const Packet &packet, QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const ClockEventRequestPacket *requestPacket =
+            dynamic_cast<const ClockEventRequestPacket *>(&packet);
+
+    if (requestPacket != nullptr)
+    {
+        // Write user ID
+        packetObject["userId"] = static_cast<double>(requestPacket->userId());
+
+        // Write timestamp (optional)
+        if (requestPacket->timestamp().isValid())
+        {
+            packetObject["timestamp"] = requestPacket->timestamp().toUTC().toString(Qt::ISODate);
+        }
+
+        success = true;
+    }
+
+    return success;
+}
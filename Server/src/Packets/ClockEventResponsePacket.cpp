@@ -0,0 +1,101 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ClockEventResponsePacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+ClockEventResponsePacket::ClockEventResponsePacket(const Event::Type eventType)
+    : ResponsePacket(),
+      m_eventType(eventType),
+      m_accepted(false),
+      m_timestamp()
+{
+}
+
+ClockEventResponsePacket::~ClockEventResponsePacket()
+{
+}
+
+QString ClockEventResponsePacket::type() const
+{
+    return ClockEventResponsePacket::staticType(m_eventType);
+}
+
+QString ClockEventResponsePacket::staticType(const Event::Type eventType)
+{
+    QString type;
+
+    switch (eventType)
+    {
+        case Event::Type_Started:
+        {
+            type = QStringLiteral("StartWorkingResponse");
+            break;
+        }
+
+        case Event::Type_OnBreak:
+        {
+            type = QStringLiteral("StartBreakResponse");
+            break;
+        }
+
+        case Event::Type_FromBreak:
+        {
+            type = QStringLiteral("EndBreakResponse");
+            break;
+        }
+
+        case Event::Type_Finished:
+        {
+            type = QStringLiteral("StopWorkingResponse");
+            break;
+        }
+
+        case Event::Type_Invalid:
+        default:
+        {
+            break;
+        }
+    }
+
+    return type;
+}
+
+Event::Type ClockEventResponsePacket::eventType() const
+{
+    return m_eventType;
+}
+
+bool ClockEventResponsePacket::isAccepted() const
+{
+    return m_accepted;
+}
+
+void ClockEventResponsePacket::setAccepted(const bool accepted)
+{
+    m_accepted = accepted;
+}
+
+QDateTime ClockEventResponsePacket::timestamp() const
+{
+    return m_timestamp;
+}
+
+void ClockEventResponsePacket::setTimestamp(const QDateTime &timestampValue)
+{
+    m_timestamp = timestampValue;
+}
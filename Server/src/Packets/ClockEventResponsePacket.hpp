@@ -0,0 +1,125 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_CLOCKEVENTRESPONSEPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_CLOCKEVENTRESPONSEPACKET_HPP
+
+#include <QtCore/QDateTime>
+#include "ResponsePacket.hpp"
+#include "../Event.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Clock Event Response
+ *
+ * Response to the Clock Event Request packet. The packet type depends on the event type:
+ * - Event::Type_Started: "StartWorkingResponse"
+ * - Event::Type_OnBreak: "StartBreakResponse"
+ * - Event::Type_FromBreak: "EndBreakResponse"
+ * - Event::Type_Finished: "StopWorkingResponse"
+ */
+class ClockEventResponsePacket : public ResponsePacket
+{
+public:
+    /*!
+     * \brief   Constructor
+     *
+     * \param   eventType   Event type
+     */
+    explicit ClockEventResponsePacket(const Event::Type eventType);
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~ClockEventResponsePacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \brief   Gets packet type for the event type
+     *
+     * \param   eventType   Event type
+     *
+     * \return  Packet type or an empty string for an invalid event type
+     */
+    static QString staticType(const Event::Type eventType);
+
+    /*!
+     * \brief   Gets the event type
+     *
+     * \return  Event type
+     */
+    Event::Type eventType() const;
+
+    /*!
+     * \brief   Checks if the event was accepted
+     *
+     * \retval  true    Event was accepted
+     * \retval  false   Event was rejected (e.g. unknown user or invalid for the user's state)
+     */
+    bool isAccepted() const;
+
+    /*!
+     * \brief   Sets the flag that indicates if the event was accepted
+     *
+     * \param   accepted    Flag value
+     */
+    void setAccepted(const bool accepted);
+
+    /*!
+     * \brief   Gets the timestamp of the event
+     *
+     * \return  Timestamp
+     */
+    QDateTime timestamp() const;
+
+    /*!
+     * \brief   Sets the timestamp of the event
+     *
+     * \param   timestampValue  Timestamp value
+     */
+    void setTimestamp(const QDateTime &timestampValue);
+
+private:
+    /*!
+     * \brief   Holds the event type
+     */
+    Event::Type m_eventType;
+
+    /*!
+     * \brief   Holds the flag that indicates if the event was accepted
+     */
+    bool m_accepted;
+
+    /*!
+     * \brief   Holds the timestamp of the event
+     */
+    QDateTime m_timestamp;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_CLOCKEVENTRESPONSEPACKET_HPP
@@ -0,0 +1,56 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ClockEventResponsePacket.hpp"
+#include "ClockEventResponsePacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+ClockEventResponsePacketWriter::ClockEventResponsePacketWriter(const Event::Type eventType)
+    : PacketWriter(),
+      m_eventType(eventType)
+{
+}
+
+ClockEventResponsePacketWriter::~ClockEventResponsePacketWriter()
+{
+}
+
+QString ClockEventResponsePacketWriter::packetType() const
+{
+    return ClockEventResponsePacket::staticType(m_eventType);
+}
+
+bool ClockEventResponsePacketWriter::writeBody(const Packet &packet,
+                                               QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const ClockEventResponsePacket *responsePacket =
+            dynamic_cast<const ClockEventResponsePacket *>(&packet);
+
+    if (responsePacket != nullptr)
+    {
+        // Write reference ID, accepted flag and timestamp
+        packetObject["refId"] = static_cast<double>(responsePacket->referenceId());
+        packetObject["accepted"] = responsePacket->isAccepted();
+        packetObject["timestamp"] = responsePacket->timestamp().toUTC().toString(Qt::ISODate);
+        success = true;
+    }
+
+    return success;
+}
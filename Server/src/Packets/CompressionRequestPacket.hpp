@@ -0,0 +1,88 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_COMPRESSIONREQUESTPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_COMPRESSIONREQUESTPACKET_HPP
+
+#include "Packet.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Compression Request
+ *
+ * Requests compression of the packets sent to the client. The request is meant to be sent right
+ * after the connection is established. Only the "zlib" algorithm is supported, in which case the
+ * packets larger than the compression threshold are sent in compressed frames:
+ * \code{.unparsed}
+ *  <SOH>[length of the compressed data (32-bit, big-endian)][compressed packet payload]
+ * \endcode
+ *
+ * The compressed packet payload is in the format produced by qCompress().
+ */
+class CompressionRequestPacket : public Packet
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    CompressionRequestPacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~CompressionRequestPacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Gets the name of the compression algorithm
+     *
+     * \return  Compression algorithm
+     */
+    QString algorithm() const;
+
+    /*!
+     * \brief   Sets the name of the compression algorithm
+     *
+     * \param   algorithmValue  Compression algorithm
+     */
+    void setAlgorithm(const QString &algorithmValue);
+
+private:
+    /*!
+     * \brief   Holds the name of the compression algorithm
+     */
+    QString m_algorithm;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_COMPRESSIONREQUESTPACKET_HPP
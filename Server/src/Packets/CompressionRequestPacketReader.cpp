@@ -0,0 +1,82 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CompressionRequestPacket.hpp"
+#include "CompressionRequestPacketReader.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+CompressionRequestPacketReader::CompressionRequestPacketReader()
+    : PacketReader()
+{
+}
+
+CompressionRequestPacketReader::~CompressionRequestPacketReader()
+{
+}
+
+QString CompressionRequestPacketReader::packetType() const
+{
+    return CompressionRequestPacket::staticType();
+}
+
+Packet *CompressionRequestPacketReader::createPacket() const
+{
+    return new CompressionRequestPacket();
+}
+
+bool CompressionRequestPacketReader::readBody(const QJsonObject &packetObject, Packet *packet) const
+{
+    bool success = false;
+
+    // Check input parameters
+    if ((!packetObject.isEmpty()) && (packet != nullptr))
+    {
+        success = true;
+    }
+
+    // Downcast packet pointer to the derived class
+    CompressionRequestPacket *requestPacket = nullptr;
+
+    if (success)
+    {
+        requestPacket = dynamic_cast<CompressionRequestPacket *>(packet);
+
+        if (requestPacket == nullptr)
+        {
+            success = false;
+        }
+    }
+
+    // Read algorithm
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("algorithm"))
+        {
+            const QJsonValue value = packetObject["algorithm"];
+
+            if (value.isString())
+            {
+                requestPacket->setAlgorithm(value.toString());
+                success = true;
+            }
+        }
+    }
+
+    return success;
+}
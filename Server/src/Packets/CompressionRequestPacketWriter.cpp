@@ -0,0 +1,54 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CompressionRequestPacket.hpp"
+#include "CompressionRequestPacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+CompressionRequestPacketWriter::CompressionRequestPacketWriter()
+    : PacketWriter()
+{
+}
+
+CompressionRequestPacketWriter::~CompressionRequestPacketWriter()
+{
+}
+
+QString CompressionRequestPacketWriter::packetType() const
+{
+    return CompressionRequestPacket::staticType();
+}
+
+bool CompressionRequestPacketWriter::writeBody(const Packet &packet,
+                                               QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const CompressionRequestPacket *requestPacket =
+            dynamic_cast<const CompressionRequestPacket *>(&packet);
+
+    if (requestPacket != nullptr)
+    {
+        // Write algorithm
+        packetObject["algorithm"] = requestPacket->algorithm();
+
+        success = true;
+    }
+
+    return success;
+}
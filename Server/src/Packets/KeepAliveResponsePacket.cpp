@@ -18,8 +18,7 @@
 using namespace OpenTimeTracker::Server::Packets;
 
 KeepAliveResponsePacket::KeepAliveResponsePacket()
-    : Packet(),
-      m_referenceId(0)
+    : ResponsePacket()
 {
 }
 
@@ -36,13 +35,3 @@ QString KeepAliveResponsePacket::staticType()
 {
     return QStringLiteral("KeepAliveResponse");
 }
-
-quint32 KeepAliveResponsePacket::referenceId() const
-{
-    return m_referenceId;
-}
-
-void KeepAliveResponsePacket::setReferenceId(const quint32 &referenceIdValue)
-{
-    m_referenceId = referenceIdValue;
-}
@@ -16,7 +16,7 @@
 #ifndef OPENTIMETRACKER_SERVER_PACKETS_KEEPALIVERESPONSEPACKET_HPP
 #define OPENTIMETRACKER_SERVER_PACKETS_KEEPALIVERESPONSEPACKET_HPP
 
-#include "Packet.hpp"
+#include "ResponsePacket.hpp"
 
 namespace OpenTimeTracker
 {
@@ -28,7 +28,7 @@ namespace Packets
 /*!
  * \brief   Packet: Keep Alive Response
  */
-class KeepAliveResponsePacket : public Packet
+class KeepAliveResponsePacket : public ResponsePacket
 {
 public:
     /*!
@@ -50,26 +50,6 @@ public:
      * \copydoc Packet::type
      */
     static QString staticType();
-
-    /*!
-     * \brief   Gets the reference ID
-     *
-     * \return  Reference ID
-     */
-    quint32 referenceId() const;
-
-    /*!
-     * \brief   Sets reference ID
-     *
-     * \param   referenceIdValue    Reference ID value
-     */
-    void setReferenceId(const quint32 &referenceIdValue);
-
-private:
-    /*!
-     * \brief   Holds the reference packet ID of the request packet
-     */
-    quint32 m_referenceId;
 };
 
 }
@@ -18,6 +18,12 @@
 
 using namespace OpenTimeTracker::Server::Packets;
 
+// Keys are in the same (sorted) order as in a JSON document written by QJsonDocument
+const QByteArray KeepAliveResponsePacketWriter::m_templateHead("\x02{\"id\":");
+const QByteArray KeepAliveResponsePacketWriter::m_templateMiddle(",\"refId\":");
+const QByteArray KeepAliveResponsePacketWriter::m_templateTail(
+        ",\"type\":\"KeepAliveResponse\"}\x03");
+
 KeepAliveResponsePacketWriter::KeepAliveResponsePacketWriter()
     : PacketWriter()
 {
@@ -32,6 +38,24 @@ QString KeepAliveResponsePacketWriter::packetType() const
     return KeepAliveResponsePacket::staticType();
 }
 
+QByteArray KeepAliveResponsePacketWriter::writeFromTemplate(const quint32 id,
+                                                            const quint32 referenceId)
+{
+    // Reserve enough space for the template and the maximum length of both IDs (10 digits)
+    QByteArray packetData;
+    packetData.reserve(m_templateHead.size() + m_templateMiddle.size() + m_templateTail.size() +
+                       20);
+
+    // Patch the IDs into the template
+    packetData.append(m_templateHead);
+    packetData.append(QByteArray::number(id));
+    packetData.append(m_templateMiddle);
+    packetData.append(QByteArray::number(referenceId));
+    packetData.append(m_templateTail);
+
+    return packetData;
+}
+
 bool KeepAliveResponsePacketWriter::writeBody(const Packet &packet, QJsonObject &packetObject) const
 {
     bool success = false;
@@ -48,11 +48,40 @@ public:
      */
     virtual QString packetType() const;
 
+    /*!
+     * \brief   Writes a Keep Alive Response packet from a pre-built template
+     *
+     * \param   id          Packet ID
+     * \param   referenceId Reference ID
+     *
+     * \return  Packet data
+     *
+     * The result is equal to writing a KeepAliveResponsePacket object in the compact JSON format,
+     * but no packet object or JSON document needs to be built since only the IDs are patched into
+     * the template. This is intended for answering the "keep alive" requests.
+     */
+    static QByteArray writeFromTemplate(const quint32 id, const quint32 referenceId);
+
 private:
     /*!
      * \copydoc PacketWriter::writeBody
      */
     virtual bool writeBody(const Packet &packet, QJsonObject &packetObject) const;
+
+    /*!
+     * \brief   Holds the part of the template before the packet ID
+     */
+    static const QByteArray m_templateHead;
+
+    /*!
+     * \brief   Holds the part of the template between the packet ID and the reference ID
+     */
+    static const QByteArray m_templateMiddle;
+
+    /*!
+     * \brief   Holds the part of the template after the reference ID
+     */
+    static const QByteArray m_templateTail;
 };
 
 }
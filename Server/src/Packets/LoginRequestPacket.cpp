@@ -0,0 +1,60 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoginRequestPacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+LoginRequestPacket::LoginRequestPacket()
+    : Packet(),
+      m_userName(),
+      m_password()
+{
+}
+
+LoginRequestPacket::~LoginRequestPacket()
+{
+}
+
+QString LoginRequestPacket::type() const
+{
+    return LoginRequestPacket::staticType();
+}
+
+QString LoginRequestPacket::staticType()
+{
+    return QStringLiteral("LoginRequest");
+}
+
+QString LoginRequestPacket::userName() const
+{
+    return m_userName;
+}
+
+void LoginRequestPacket::setUserName(const QString &userNameValue)
+{
+    m_userName = userNameValue;
+}
+
+QString LoginRequestPacket::password() const
+{
+    return m_password;
+}
+
+void LoginRequestPacket::setPassword(const QString &passwordValue)
+{
+    m_password = passwordValue;
+}
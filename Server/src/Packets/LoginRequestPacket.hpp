@@ -0,0 +1,101 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_LOGINREQUESTPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_LOGINREQUESTPACKET_HPP
+
+#include "Packet.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Login Request
+ *
+ * Authenticates the client as the user. If the credentials are valid the connection is bound to
+ * the user, otherwise the connection's current user is kept.
+ */
+class LoginRequestPacket : public Packet
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    LoginRequestPacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~LoginRequestPacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Gets the user's name
+     *
+     * \return  User's name
+     */
+    QString userName() const;
+
+    /*!
+     * \brief   Sets the user's name
+     *
+     * \param   userNameValue   User's name
+     */
+    void setUserName(const QString &userNameValue);
+
+    /*!
+     * \brief   Gets the user's password
+     *
+     * \return  User's password
+     */
+    QString password() const;
+
+    /*!
+     * \brief   Sets the user's password
+     *
+     * \param   passwordValue   User's password
+     */
+    void setPassword(const QString &passwordValue);
+
+private:
+    /*!
+     * \brief   Holds the user's name
+     */
+    QString m_userName;
+
+    /*!
+     * \brief   Holds the user's password
+     */
+    QString m_password;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_LOGINREQUESTPACKET_HPP
@@ -0,0 +1,99 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoginRequestPacket.hpp"
+#include "LoginRequestPacketReader.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+LoginRequestPacketReader::LoginRequestPacketReader()
+    : PacketReader()
+{
+}
+
+LoginRequestPacketReader::~LoginRequestPacketReader()
+{
+}
+
+QString LoginRequestPacketReader::packetType() const
+{
+    return LoginRequestPacket::staticType();
+}
+
+Packet *LoginRequestPacketReader::createPacket() const
+{
+    return new LoginRequestPacket();
+}
+
+bool LoginRequestPacketReader::readBody(const QJsonObject &packetObject, Packet *packet) const
+{
+    bool success = false;
+
+    // Check input parameters
+    if ((!packetObject.isEmpty()) && (packet != nullptr))
+    {
+        success = true;
+    }
+
+    // Downcast packet pointer to the derived class
+    LoginRequestPacket *requestPacket = nullptr;
+
+    if (success)
+    {
+        requestPacket = dynamic_cast<LoginRequestPacket *>(packet);
+
+        if (requestPacket == nullptr)
+        {
+            success = false;
+        }
+    }
+
+    // Read user's name
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("userName"))
+        {
+            const QJsonValue value = packetObject["userName"];
+
+            if (value.isString())
+            {
+                requestPacket->setUserName(value.toString());
+                success = true;
+            }
+        }
+    }
+
+    // Read user's password
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("password"))
+        {
+            const QJsonValue value = packetObject["password"];
+
+            if (value.isString())
+            {
+                requestPacket->setPassword(value.toString());
+                success = true;
+            }
+        }
+    }
+
+    return success;
+}
@@ -0,0 +1,54 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoginRequestPacket.hpp"
+#include "LoginRequestPacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+LoginRequestPacketWriter::LoginRequestPacketWriter()
+    : PacketWriter()
+{
+}
+
+LoginRequestPacketWriter::~LoginRequestPacketWriter()
+{
+}
+
+QString LoginRequestPacketWriter::packetType() const
+{
+    return LoginRequestPacket::staticType();
+}
+
+bool LoginRequestPacketWriter::writeBody(const Packet &packet, QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const LoginRequestPacket *requestPacket =
+            dynamic_cast<const LoginRequestPacket *>(&packet);
+
+    if (requestPacket != nullptr)
+    {
+        // Write user's name and password
+        packetObject["userName"] = requestPacket->userName();
+        packetObject["password"] = requestPacket->password();
+
+        success = true;
+    }
+
+    return success;
+}
@@ -0,0 +1,60 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoginResponsePacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+LoginResponsePacket::LoginResponsePacket()
+    : ResponsePacket(),
+      m_accepted(false),
+      m_userId(0)
+{
+}
+
+LoginResponsePacket::~LoginResponsePacket()
+{
+}
+
+QString LoginResponsePacket::type() const
+{
+    return LoginResponsePacket::staticType();
+}
+
+QString LoginResponsePacket::staticType()
+{
+    return QStringLiteral("LoginResponse");
+}
+
+bool LoginResponsePacket::isAccepted() const
+{
+    return m_accepted;
+}
+
+void LoginResponsePacket::setAccepted(const bool accepted)
+{
+    m_accepted = accepted;
+}
+
+qint64 LoginResponsePacket::userId() const
+{
+    return m_userId;
+}
+
+void LoginResponsePacket::setUserId(const qint64 &userIdValue)
+{
+    m_userId = userIdValue;
+}
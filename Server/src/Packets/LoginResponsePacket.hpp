@@ -0,0 +1,99 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_LOGINRESPONSEPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_LOGINRESPONSEPACKET_HPP
+
+#include "ResponsePacket.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Login Response
+ */
+class LoginResponsePacket : public ResponsePacket
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    LoginResponsePacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~LoginResponsePacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Checks if the request was accepted
+     *
+     * \retval  true    Request was accepted
+     * \retval  false   Request was rejected (invalid credentials)
+     */
+    bool isAccepted() const;
+
+    /*!
+     * \brief   Sets the flag that indicates if the request was accepted
+     *
+     * \param   accepted    Flag value
+     */
+    void setAccepted(const bool accepted);
+
+    /*!
+     * \brief   Gets the ID of the authenticated user
+     *
+     * \return  User ID or zero if the request was rejected
+     */
+    qint64 userId() const;
+
+    /*!
+     * \brief   Sets the ID of the authenticated user
+     *
+     * \param   userIdValue     User ID
+     */
+    void setUserId(const qint64 &userIdValue);
+
+private:
+    /*!
+     * \brief   Holds the flag that indicates if the request was accepted
+     */
+    bool m_accepted;
+
+    /*!
+     * \brief   Holds the ID of the authenticated user
+     */
+    qint64 m_userId;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_LOGINRESPONSEPACKET_HPP
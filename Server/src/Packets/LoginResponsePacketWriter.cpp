@@ -0,0 +1,55 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoginResponsePacket.hpp"
+#include "LoginResponsePacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+LoginResponsePacketWriter::LoginResponsePacketWriter()
+    : PacketWriter()
+{
+}
+
+LoginResponsePacketWriter::~LoginResponsePacketWriter()
+{
+}
+
+QString LoginResponsePacketWriter::packetType() const
+{
+    return LoginResponsePacket::staticType();
+}
+
+bool LoginResponsePacketWriter::writeBody(const Packet &packet, QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const LoginResponsePacket *responsePacket =
+            dynamic_cast<const LoginResponsePacket *>(&packet);
+
+    if (responsePacket != nullptr)
+    {
+        // Write reference ID, accepted flag and user ID
+        packetObject["refId"] = static_cast<double>(responsePacket->referenceId());
+        packetObject["accepted"] = responsePacket->isAccepted();
+        packetObject["userId"] = static_cast<double>(responsePacket->userId());
+
+        success = true;
+    }
+
+    return success;
+}
@@ -19,6 +19,7 @@
 using namespace OpenTimeTracker::Server::Packets;
 
 PacketWriter::PacketWriter()
+    : m_jsonFormat(QJsonDocument::Indented)
 {
 }
 
@@ -46,13 +47,23 @@ QByteArray PacketWriter::toByteArray(const Packet &packet) const
     if (success)
     {
         packetData.append('\x02');
-        packetData.append(QJsonDocument(packetObject).toJson());
+        packetData.append(QJsonDocument(packetObject).toJson(m_jsonFormat));
         packetData.append('\x03');
     }
 
     return packetData;
 }
 
+QJsonDocument::JsonFormat PacketWriter::jsonFormat() const
+{
+    return m_jsonFormat;
+}
+
+void PacketWriter::setJsonFormat(const QJsonDocument::JsonFormat format)
+{
+    m_jsonFormat = format;
+}
+
 bool PacketWriter::writeHeader(const Packet &packet, QJsonObject &packetObject) const
 {
     bool success = false;
@@ -17,6 +17,7 @@
 #define OPENTIMETRACKER_SERVER_PACKETS_PACKETWRITER_HPP
 
 #include <QtCore/QString>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include "Packet.hpp"
 
@@ -59,6 +60,23 @@ public:
      */
     QByteArray toByteArray(const Packet &packet) const;
 
+    /*!
+     * \brief   Gets the JSON format used for writing the packet payload
+     *
+     * \return  JSON format
+     */
+    QJsonDocument::JsonFormat jsonFormat() const;
+
+    /*!
+     * \brief   Sets the JSON format used for writing the packet payload
+     *
+     * \param   format  JSON format
+     *
+     * The "compact" format omits all whitespace (new lines and indentation) from the packet
+     * payload, which significantly reduces the size of small packets like "keep alive" packets.
+     */
+    void setJsonFormat(const QJsonDocument::JsonFormat format);
+
 protected:
     /*!
      * \brief   Writes the packet body to the packet JSON object
@@ -82,6 +100,11 @@ private:
      * \retval  false   Error
      */
     bool writeHeader(const Packet &packet, QJsonObject &packetObject) const;
+
+    /*!
+     * \brief   Holds the JSON format used for writing the packet payload
+     */
+    QJsonDocument::JsonFormat m_jsonFormat;
 };
 
 }
@@ -0,0 +1,60 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SubscribeUserStatusRequestPacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+SubscribeUserStatusRequestPacket::SubscribeUserStatusRequestPacket()
+    : Packet(),
+      m_userIds(),
+      m_userGroupId(0)
+{
+}
+
+SubscribeUserStatusRequestPacket::~SubscribeUserStatusRequestPacket()
+{
+}
+
+QString SubscribeUserStatusRequestPacket::type() const
+{
+    return SubscribeUserStatusRequestPacket::staticType();
+}
+
+QString SubscribeUserStatusRequestPacket::staticType()
+{
+    return QStringLiteral("SubscribeUserStatusRequest");
+}
+
+QList<qint64> SubscribeUserStatusRequestPacket::userIds() const
+{
+    return m_userIds;
+}
+
+void SubscribeUserStatusRequestPacket::setUserIds(const QList<qint64> &userIdsValue)
+{
+    m_userIds = userIdsValue;
+}
+
+qint64 SubscribeUserStatusRequestPacket::userGroupId() const
+{
+    return m_userGroupId;
+}
+
+void SubscribeUserStatusRequestPacket::setUserGroupId(const qint64 &userGroupIdValue)
+{
+    m_userGroupId = userGroupIdValue;
+}
@@ -0,0 +1,103 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_SUBSCRIBEUSERSTATUSREQUESTPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_SUBSCRIBEUSERSTATUSREQUESTPACKET_HPP
+
+#include <QtCore/QList>
+#include "Packet.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Subscribe User Status Request
+ *
+ * Subscribes the client to the status changes of the selected users and of all members of the
+ * selected user group. The request replaces the client's previous subscription, a request without
+ * any users and without a user group cancels the subscription.
+ */
+class SubscribeUserStatusRequestPacket : public Packet
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    SubscribeUserStatusRequestPacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~SubscribeUserStatusRequestPacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Gets the IDs of the users
+     *
+     * \return  User IDs
+     */
+    QList<qint64> userIds() const;
+
+    /*!
+     * \brief   Sets the IDs of the users
+     *
+     * \param   userIdsValue    User IDs
+     */
+    void setUserIds(const QList<qint64> &userIdsValue);
+
+    /*!
+     * \brief   Gets the ID of the user group
+     *
+     * \return  User group ID or zero if no user group is selected
+     */
+    qint64 userGroupId() const;
+
+    /*!
+     * \brief   Sets the ID of the user group
+     *
+     * \param   userGroupIdValue    User group ID
+     */
+    void setUserGroupId(const qint64 &userGroupIdValue);
+
+private:
+    /*!
+     * \brief   Holds the IDs of the users
+     */
+    QList<qint64> m_userIds;
+
+    /*!
+     * \brief   Holds the ID of the user group
+     */
+    qint64 m_userGroupId;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_SUBSCRIBEUSERSTATUSREQUESTPACKET_HPP
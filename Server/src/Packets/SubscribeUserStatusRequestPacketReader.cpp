@@ -0,0 +1,124 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QJsonArray>
+#include "SubscribeUserStatusRequestPacket.hpp"
+#include "SubscribeUserStatusRequestPacketReader.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+SubscribeUserStatusRequestPacketReader::SubscribeUserStatusRequestPacketReader()
+    : PacketReader()
+{
+}
+
+SubscribeUserStatusRequestPacketReader::~SubscribeUserStatusRequestPacketReader()
+{
+}
+
+QString SubscribeUserStatusRequestPacketReader::packetType() const
+{
+    return SubscribeUserStatusRequestPacket::staticType();
+}
+
+Packet *SubscribeUserStatusRequestPacketReader::createPacket() const
+{
+    return new SubscribeUserStatusRequestPacket();
+}
+
+bool SubscribeUserStatusRequestPacketReader::readBody(const QJsonObject &packetObject,
+                                                      Packet *packet) const
+{
+    bool success = false;
+
+    // Check input parameters
+    if ((!packetObject.isEmpty()) && (packet != nullptr))
+    {
+        success = true;
+    }
+
+    // Downcast packet pointer to the derived class
+    SubscribeUserStatusRequestPacket *requestPacket = nullptr;
+
+    if (success)
+    {
+        requestPacket = dynamic_cast<SubscribeUserStatusRequestPacket *>(packet);
+
+        if (requestPacket == nullptr)
+        {
+            success = false;
+        }
+    }
+
+    // Read user IDs (optional)
+    if (success)
+    {
+        if (packetObject.contains("userIds"))
+        {
+            success = false;
+            const QJsonValue value = packetObject["userIds"];
+
+            if (value.isArray())
+            {
+                QList<qint64> userIds;
+                success = true;
+
+                foreach (const QJsonValue &item, value.toArray())
+                {
+                    const qint64 itemValue = qRound64(item.toDouble(-1.0));
+
+                    if (item.isDouble() && (itemValue > 0LL))
+                    {
+                        userIds.append(itemValue);
+                    }
+                    else
+                    {
+                        success = false;
+                        break;
+                    }
+                }
+
+                if (success)
+                {
+                    requestPacket->setUserIds(userIds);
+                }
+            }
+        }
+    }
+
+    // Read user group ID (optional)
+    if (success)
+    {
+        if (packetObject.contains("userGroupId"))
+        {
+            success = false;
+            const QJsonValue value = packetObject["userGroupId"];
+
+            if (value.isDouble())
+            {
+                const qint64 userGroupIdValue = qRound64(value.toDouble(-1.0));
+
+                if (userGroupIdValue > 0LL)
+                {
+                    requestPacket->setUserGroupId(userGroupIdValue);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    return success;
+}
@@ -0,0 +1,68 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QJsonArray>
+#include "SubscribeUserStatusRequestPacket.hpp"
+#include "SubscribeUserStatusRequestPacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+SubscribeUserStatusRequestPacketWriter::SubscribeUserStatusRequestPacketWriter()
+    : PacketWriter()
+{
+}
+
+SubscribeUserStatusRequestPacketWriter::~SubscribeUserStatusRequestPacketWriter()
+{
+}
+
+QString SubscribeUserStatusRequestPacketWriter::packetType() const
+{
+    return SubscribeUserStatusRequestPacket::staticType();
+}
+
+bool SubscribeUserStatusRequestPacketWriter::writeBody(const Packet &packet,
+                                                       QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const SubscribeUserStatusRequestPacket *requestPacket =
+            dynamic_cast<const SubscribeUserStatusRequestPacket *>(&packet);
+
+    if (requestPacket != nullptr)
+    {
+        // Write user IDs
+        QJsonArray userIds;
+
+        foreach (const qint64 userId, requestPacket->userIds())
+        {
+            userIds.append(static_cast<double>(userId));
+        }
+
+        packetObject["userIds"] = userIds;
+
+        // Write user group ID (optional)
+        if (requestPacket->userGroupId() > 0LL)
+        {
+            packetObject["userGroupId"] = static_cast<double>(requestPacket->userGroupId());
+        }
+
+        success = true;
+    }
+
+    return success;
+}
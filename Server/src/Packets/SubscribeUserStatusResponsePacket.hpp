@@ -0,0 +1,83 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_SUBSCRIBEUSERSTATUSRESPONSEPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_SUBSCRIBEUSERSTATUSRESPONSEPACKET_HPP
+
+#include "ResponsePacket.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: Subscribe User Status Response
+ *
+ * If the subscription is accepted the current status of each of the subscribed users is sent
+ * right after the response.
+ */
+class SubscribeUserStatusResponsePacket : public ResponsePacket
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    SubscribeUserStatusResponsePacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~SubscribeUserStatusResponsePacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Checks if the subscription was accepted
+     *
+     * \retval  true    Subscription was accepted
+     * \retval  false   Subscription was rejected (e.g. unknown user or user group)
+     */
+    bool isAccepted() const;
+
+    /*!
+     * \brief   Sets the flag that indicates if the subscription was accepted
+     *
+     * \param   accepted    Flag value
+     */
+    void setAccepted(const bool accepted);
+
+private:
+    /*!
+     * \brief   Holds the flag that indicates if the subscription was accepted
+     */
+    bool m_accepted;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_SUBSCRIBEUSERSTATUSRESPONSEPACKET_HPP
@@ -0,0 +1,54 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SubscribeUserStatusResponsePacket.hpp"
+#include "SubscribeUserStatusResponsePacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+SubscribeUserStatusResponsePacketWriter::SubscribeUserStatusResponsePacketWriter()
+    : PacketWriter()
+{
+}
+
+SubscribeUserStatusResponsePacketWriter::~SubscribeUserStatusResponsePacketWriter()
+{
+}
+
+QString SubscribeUserStatusResponsePacketWriter::packetType() const
+{
+    return SubscribeUserStatusResponsePacket::staticType();
+}
+
+bool SubscribeUserStatusResponsePacketWriter::writeBody(const Packet &packet,
+                                                        QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const SubscribeUserStatusResponsePacket *responsePacket =
+            dynamic_cast<const SubscribeUserStatusResponsePacket *>(&packet);
+
+    if (responsePacket != nullptr)
+    {
+        // Write reference ID and accepted flag
+        packetObject["refId"] = static_cast<double>(responsePacket->referenceId());
+        packetObject["accepted"] = responsePacket->isAccepted();
+        success = true;
+    }
+
+    return success;
+}
@@ -0,0 +1,71 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UserStatusPacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserStatusPacket::UserStatusPacket()
+    : Packet(),
+      m_userId(0),
+      m_state(TimeTracker::State_NotWorking),
+      m_timestamp()
+{
+}
+
+UserStatusPacket::~UserStatusPacket()
+{
+}
+
+QString UserStatusPacket::type() const
+{
+    return UserStatusPacket::staticType();
+}
+
+QString UserStatusPacket::staticType()
+{
+    return QStringLiteral("UserStatus");
+}
+
+qint64 UserStatusPacket::userId() const
+{
+    return m_userId;
+}
+
+void UserStatusPacket::setUserId(const qint64 &userIdValue)
+{
+    m_userId = userIdValue;
+}
+
+TimeTracker::State UserStatusPacket::state() const
+{
+    return m_state;
+}
+
+void UserStatusPacket::setState(const TimeTracker::State stateValue)
+{
+    m_state = stateValue;
+}
+
+QDateTime UserStatusPacket::timestamp() const
+{
+    return m_timestamp;
+}
+
+void UserStatusPacket::setTimestamp(const QDateTime &timestampValue)
+{
+    m_timestamp = timestampValue;
+}
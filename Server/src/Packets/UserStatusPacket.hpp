@@ -0,0 +1,121 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_USERSTATUSPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_USERSTATUSPACKET_HPP
+
+#include <QtCore/QDateTime>
+#include "Packet.hpp"
+#include "../TimeTracker.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: User Status
+ *
+ * Sent by the server to the subscribed clients when the state of a user changes.
+ */
+class UserStatusPacket : public Packet
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserStatusPacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~UserStatusPacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Gets the user ID
+     *
+     * \return  User ID
+     */
+    qint64 userId() const;
+
+    /*!
+     * \brief   Sets the user ID
+     *
+     * \param   userIdValue     User ID value
+     */
+    void setUserId(const qint64 &userIdValue);
+
+    /*!
+     * \brief   Gets the user's state
+     *
+     * \return  State
+     */
+    TimeTracker::State state() const;
+
+    /*!
+     * \brief   Sets the user's state
+     *
+     * \param   stateValue  State value
+     */
+    void setState(const TimeTracker::State stateValue);
+
+    /*!
+     * \brief   Gets the timestamp of the last state change
+     *
+     * \return  Timestamp or an invalid timestamp if the state didn't change yet
+     */
+    QDateTime timestamp() const;
+
+    /*!
+     * \brief   Sets the timestamp of the last state change
+     *
+     * \param   timestampValue  Timestamp value
+     */
+    void setTimestamp(const QDateTime &timestampValue);
+
+private:
+    /*!
+     * \brief   Holds the user ID
+     */
+    qint64 m_userId;
+
+    /*!
+     * \brief   Holds the user's state
+     */
+    TimeTracker::State m_state;
+
+    /*!
+     * \brief   Holds the timestamp of the last state change
+     */
+    QDateTime m_timestamp;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_USERSTATUSPACKET_HPP
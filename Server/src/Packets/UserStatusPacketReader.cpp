@@ -0,0 +1,132 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UserStatusPacket.hpp"
+#include "UserStatusPacketReader.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserStatusPacketReader::UserStatusPacketReader()
+    : PacketReader()
+{
+}
+
+UserStatusPacketReader::~UserStatusPacketReader()
+{
+}
+
+QString UserStatusPacketReader::packetType() const
+{
+    return UserStatusPacket::staticType();
+}
+
+Packet *UserStatusPacketReader::createPacket() const
+{
+    return new UserStatusPacket();
+}
+
+bool UserStatusPacketReader::readBody(const QJsonObject &packetObject, Packet *packet) const
+{
+    bool success = false;
+
+    // Check input parameters
+    if ((!packetObject.isEmpty()) && (packet != nullptr))
+    {
+        success = true;
+    }
+
+    // Downcast packet pointer to the derived class
+    UserStatusPacket *statusPacket = nullptr;
+
+    if (success)
+    {
+        statusPacket = dynamic_cast<UserStatusPacket *>(packet);
+
+        if (statusPacket == nullptr)
+        {
+            success = false;
+        }
+    }
+
+    // Read user ID
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("userId"))
+        {
+            const QJsonValue value = packetObject["userId"];
+
+            if (value.isDouble())
+            {
+                const qint64 userIdValue = qRound64(value.toDouble(-1.0));
+
+                if (userIdValue > 0LL)
+                {
+                    statusPacket->setUserId(userIdValue);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    // Read state
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("state"))
+        {
+            const QJsonValue value = packetObject["state"];
+
+            if (value.isDouble())
+            {
+                const int state = value.toInt(-1);
+
+                if ((state == TimeTracker::State_NotWorking) ||
+                    (state == TimeTracker::State_Working) ||
+                    (state == TimeTracker::State_OnBreak))
+                {
+                    statusPacket->setState(static_cast<TimeTracker::State>(state));
+                    success = true;
+                }
+            }
+        }
+    }
+
+    // Read timestamp (optional)
+    if (success)
+    {
+        if (packetObject.contains("timestamp"))
+        {
+            success = false;
+            const QJsonValue value = packetObject["timestamp"];
+
+            if (value.isString())
+            {
+                const QDateTime timestamp = QDateTime::fromString(value.toString(), Qt::ISODate);
+
+                if (timestamp.isValid())
+                {
+                    statusPacket->setTimestamp(timestamp);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    return success;
+}
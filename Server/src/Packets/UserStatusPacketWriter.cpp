@@ -0,0 +1,60 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UserStatusPacket.hpp"
+#include "UserStatusPacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserStatusPacketWriter::UserStatusPacketWriter()
+    : PacketWriter()
+{
+}
+
+UserStatusPacketWriter::~UserStatusPacketWriter()
+{
+}
+
+QString UserStatusPacketWriter::packetType() const
+{
+    return UserStatusPacket::staticType();
+}
+
+bool UserStatusPacketWriter::writeBody(const Packet &packet, QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const UserStatusPacket *statusPacket =
+            dynamic_cast<const UserStatusPacket *>(&packet);
+
+    if (statusPacket != nullptr)
+    {
+        // Write user ID and state
+        packetObject["userId"] = static_cast<double>(statusPacket->userId());
+        packetObject["state"] = static_cast<int>(statusPacket->state());
+
+        // Write timestamp (optional)
+        if (statusPacket->timestamp().isValid())
+        {
+            packetObject["timestamp"] = statusPacket->timestamp().toUTC().toString(Qt::ISODate);
+        }
+
+        success = true;
+    }
+
+    return success;
+}
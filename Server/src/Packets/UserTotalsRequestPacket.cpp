@@ -0,0 +1,71 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UserTotalsRequestPacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserTotalsRequestPacket::UserTotalsRequestPacket()
+    : Packet(),
+      m_userIds(),
+      m_userGroupId(0),
+      m_timestamp()
+{
+}
+
+UserTotalsRequestPacket::~UserTotalsRequestPacket()
+{
+}
+
+QString UserTotalsRequestPacket::type() const
+{
+    return UserTotalsRequestPacket::staticType();
+}
+
+QString UserTotalsRequestPacket::staticType()
+{
+    return QStringLiteral("UserTotalsRequest");
+}
+
+QList<qint64> UserTotalsRequestPacket::userIds() const
+{
+    return m_userIds;
+}
+
+void UserTotalsRequestPacket::setUserIds(const QList<qint64> &userIdsValue)
+{
+    m_userIds = userIdsValue;
+}
+
+qint64 UserTotalsRequestPacket::userGroupId() const
+{
+    return m_userGroupId;
+}
+
+void UserTotalsRequestPacket::setUserGroupId(const qint64 &userGroupIdValue)
+{
+    m_userGroupId = userGroupIdValue;
+}
+
+QDateTime UserTotalsRequestPacket::timestamp() const
+{
+    return m_timestamp;
+}
+
+void UserTotalsRequestPacket::setTimestamp(const QDateTime &timestampValue)
+{
+    m_timestamp = timestampValue;
+}
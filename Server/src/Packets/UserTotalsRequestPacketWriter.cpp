@@ -0,0 +1,73 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QJsonArray>
+#include "UserTotalsRequestPacket.hpp"
+#include "UserTotalsRequestPacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserTotalsRequestPacketWriter::UserTotalsRequestPacketWriter()
+    : PacketWriter()
+{
+}
+
+UserTotalsRequestPacketWriter::~UserTotalsRequestPacketWriter()
+{
+}
+
+QString UserTotalsRequestPacketWriter::packetType() const
+{
+    return UserTotalsRequestPacket::staticType();
+}
+
+bool UserTotalsRequestPacketWriter::writeBody(const Packet &packet, QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const UserTotalsRequestPacket *requestPacket =
+            dynamic_cast<const UserTotalsRequestPacket *>(&packet);
+
+    if (requestPacket != nullptr)
+    {
+        // Write user IDs
+        QJsonArray userIds;
+
+        foreach (const qint64 userId, requestPacket->userIds())
+        {
+            userIds.append(static_cast<double>(userId));
+        }
+
+        packetObject["userIds"] = userIds;
+
+        // Write user group ID (optional)
+        if (requestPacket->userGroupId() > 0LL)
+        {
+            packetObject["userGroupId"] = static_cast<double>(requestPacket->userGroupId());
+        }
+
+        // Write timestamp (optional)
+        if (requestPacket->timestamp().isValid())
+        {
+            packetObject["timestamp"] = requestPacket->timestamp().toUTC().toString(Qt::ISODate);
+        }
+
+        success = true;
+    }
+
+    return success;
+}
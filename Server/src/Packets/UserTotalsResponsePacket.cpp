@@ -0,0 +1,71 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UserTotalsResponsePacket.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserTotalsResponsePacket::UserTotalsResponsePacket()
+    : ResponsePacket(),
+      m_accepted(false),
+      m_timestamp(),
+      m_totals()
+{
+}
+
+UserTotalsResponsePacket::~UserTotalsResponsePacket()
+{
+}
+
+QString UserTotalsResponsePacket::type() const
+{
+    return UserTotalsResponsePacket::staticType();
+}
+
+QString UserTotalsResponsePacket::staticType()
+{
+    return QStringLiteral("UserTotalsResponse");
+}
+
+bool UserTotalsResponsePacket::isAccepted() const
+{
+    return m_accepted;
+}
+
+void UserTotalsResponsePacket::setAccepted(const bool accepted)
+{
+    m_accepted = accepted;
+}
+
+QDateTime UserTotalsResponsePacket::timestamp() const
+{
+    return m_timestamp;
+}
+
+void UserTotalsResponsePacket::setTimestamp(const QDateTime &timestampValue)
+{
+    m_timestamp = timestampValue;
+}
+
+QList<UserTotalsResponsePacket::UserTotals> UserTotalsResponsePacket::totals() const
+{
+    return m_totals;
+}
+
+void UserTotalsResponsePacket::addTotals(const UserTotals &totals)
+{
+    m_totals.append(totals);
+}
@@ -0,0 +1,131 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_PACKETS_USERTOTALSRESPONSEPACKET_HPP
+#define OPENTIMETRACKER_SERVER_PACKETS_USERTOTALSRESPONSEPACKET_HPP
+
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include "ResponsePacket.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+namespace Packets
+{
+
+/*!
+ * \brief   Packet: User Totals Response
+ */
+class UserTotalsResponsePacket : public ResponsePacket
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserTotalsResponsePacket();
+
+    /*!
+     * \brief   Destructor
+     */
+    virtual ~UserTotalsResponsePacket();
+
+    /*!
+     * \copydoc Packet::type
+     */
+    virtual QString type() const;
+
+    /*!
+     * \copydoc Packet::type
+     */
+    static QString staticType();
+
+    /*!
+     * \brief   Holds the totals of a single user
+     */
+    struct UserTotals
+    {
+        qint64 userId;              /*!< User ID */
+        qint32 workingTime;         /*!< Working time (in seconds) */
+        qint32 breakTime;           /*!< Break time (in seconds) */
+        qint32 totalWorkingTime;    /*!< Total working time (in seconds) */
+    };
+
+    /*!
+     * \brief   Checks if the request was accepted
+     *
+     * \retval  true    Request was accepted
+     * \retval  false   Request was rejected (e.g. unknown user or user group)
+     */
+    bool isAccepted() const;
+
+    /*!
+     * \brief   Sets the flag that indicates if the request was accepted
+     *
+     * \param   accepted    Flag value
+     */
+    void setAccepted(const bool accepted);
+
+    /*!
+     * \brief   Gets the timestamp for which the totals were calculated
+     *
+     * \return  Timestamp
+     */
+    QDateTime timestamp() const;
+
+    /*!
+     * \brief   Sets the timestamp for which the totals were calculated
+     *
+     * \param   timestampValue  Timestamp value
+     */
+    void setTimestamp(const QDateTime &timestampValue);
+
+    /*!
+     * \brief   Gets the totals of all users
+     *
+     * \return  Totals
+     */
+    QList<UserTotals> totals() const;
+
+    /*!
+     * \brief   Adds the totals of a user
+     *
+     * \param   totals  Totals
+     */
+    void addTotals(const UserTotals &totals);
+
+private:
+    /*!
+     * \brief   Holds the flag that indicates if the request was accepted
+     */
+    bool m_accepted;
+
+    /*!
+     * \brief   Holds the timestamp for which the totals were calculated
+     */
+    QDateTime m_timestamp;
+
+    /*!
+     * \brief   Holds the totals of all users
+     */
+    QList<UserTotals> m_totals;
+};
+
+}
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_PACKETS_USERTOTALSRESPONSEPACKET_HPP
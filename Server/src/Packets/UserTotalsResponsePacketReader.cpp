@@ -0,0 +1,168 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QJsonArray>
+#include "UserTotalsResponsePacket.hpp"
+#include "UserTotalsResponsePacketReader.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserTotalsResponsePacketReader::UserTotalsResponsePacketReader()
+    : PacketReader()
+{
+}
+
+UserTotalsResponsePacketReader::~UserTotalsResponsePacketReader()
+{
+}
+
+QString UserTotalsResponsePacketReader::packetType() const
+{
+    return UserTotalsResponsePacket::staticType();
+}
+
+Packet *UserTotalsResponsePacketReader::createPacket() const
+{
+    return new UserTotalsResponsePacket();
+}
+
+bool UserTotalsResponsePacketReader::readBody(const QJsonObject &packetObject, Packet *packet) const
+{
+    bool success = false;
+
+    // Check input parameters
+    if ((!packetObject.isEmpty()) && (packet != nullptr))
+    {
+        success = true;
+    }
+
+    // Downcast packet pointer to the derived class
+    UserTotalsResponsePacket *responsePacket = nullptr;
+
+    if (success)
+    {
+        responsePacket = dynamic_cast<UserTotalsResponsePacket *>(packet);
+
+        if (responsePacket == nullptr)
+        {
+            success = false;
+        }
+    }
+
+    // Read reference ID
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("refId"))
+        {
+            const QJsonValue value = packetObject["refId"];
+
+            if (value.isDouble())
+            {
+                const qint64 refIdValue = qRound64(value.toDouble(-1.0));
+
+                if ((0 <= refIdValue) && (refIdValue <= UINT32_MAX))
+                {
+                    const quint32 refId = static_cast<quint32>(refIdValue);
+                    responsePacket->setReferenceId(refId);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    // Read accepted flag
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("accepted"))
+        {
+            const QJsonValue value = packetObject["accepted"];
+
+            if (value.isBool())
+            {
+                responsePacket->setAccepted(value.toBool());
+                success = true;
+            }
+        }
+    }
+
+    // Read timestamp
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("timestamp"))
+        {
+            const QJsonValue value = packetObject["timestamp"];
+
+            if (value.isString())
+            {
+                const QDateTime timestamp = QDateTime::fromString(value.toString(), Qt::ISODate);
+
+                if (timestamp.isValid())
+                {
+                    responsePacket->setTimestamp(timestamp);
+                    success = true;
+                }
+            }
+        }
+    }
+
+    // Read totals
+    if (success)
+    {
+        success = false;
+
+        if (packetObject.contains("totals"))
+        {
+            const QJsonValue value = packetObject["totals"];
+
+            if (value.isArray())
+            {
+                success = true;
+
+                foreach (const QJsonValue &item, value.toArray())
+                {
+                    const QJsonObject totalsObject = item.toObject();
+
+                    if (totalsObject["userId"].isDouble() &&
+                        totalsObject["workingTime"].isDouble() &&
+                        totalsObject["breakTime"].isDouble() &&
+                        totalsObject["totalWorkingTime"].isDouble())
+                    {
+                        UserTotalsResponsePacket::UserTotals totals;
+                        totals.userId = qRound64(totalsObject["userId"].toDouble());
+                        totals.workingTime = totalsObject["workingTime"].toInt();
+                        totals.breakTime = totalsObject["breakTime"].toInt();
+                        totals.totalWorkingTime = totalsObject["totalWorkingTime"].toInt();
+
+                        responsePacket->addTotals(totals);
+                    }
+                    else
+                    {
+                        success = false;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return success;
+}
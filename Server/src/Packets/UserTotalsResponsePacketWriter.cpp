@@ -0,0 +1,73 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QJsonArray>
+#include "UserTotalsResponsePacket.hpp"
+#include "UserTotalsResponsePacketWriter.hpp"
+
+using namespace OpenTimeTracker::Server;
+using namespace OpenTimeTracker::Server::Packets;
+
+UserTotalsResponsePacketWriter::UserTotalsResponsePacketWriter()
+    : PacketWriter()
+{
+}
+
+UserTotalsResponsePacketWriter::~UserTotalsResponsePacketWriter()
+{
+}
+
+QString UserTotalsResponsePacketWriter::packetType() const
+{
+    return UserTotalsResponsePacket::staticType();
+}
+
+bool UserTotalsResponsePacketWriter::writeBody(const Packet &packet,
+                                               QJsonObject &packetObject) const
+{
+    bool success = false;
+
+    // Downcast to the derived class
+    const UserTotalsResponsePacket *responsePacket =
+            dynamic_cast<const UserTotalsResponsePacket *>(&packet);
+
+    if (responsePacket != nullptr)
+    {
+        // Write reference ID, accepted flag and timestamp
+        packetObject["refId"] = static_cast<double>(responsePacket->referenceId());
+        packetObject["accepted"] = responsePacket->isAccepted();
+        packetObject["timestamp"] = responsePacket->timestamp().toUTC().toString(Qt::ISODate);
+
+        // Write totals
+        QJsonArray totalsArray;
+
+        foreach (const UserTotalsResponsePacket::UserTotals &totals, responsePacket->totals())
+        {
+            QJsonObject totalsObject;
+            totalsObject["userId"] = static_cast<double>(totals.userId);
+            totalsObject["workingTime"] = totals.workingTime;
+            totalsObject["breakTime"] = totals.breakTime;
+            totalsObject["totalWorkingTime"] = totals.totalWorkingTime;
+
+            totalsArray.append(totalsObject);
+        }
+
+        packetObject["totals"] = totalsArray;
+
+        success = true;
+    }
+
+    return success;
+}
@@ -0,0 +1,237 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSet>
+#include "Roster.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+Roster::Roster()
+    : m_entries()
+{
+}
+
+Roster::Roster(const Roster &other)
+    : m_entries(other.m_entries)
+{
+}
+
+Roster &Roster::operator =(const Roster &other)
+{
+    if (this != &other)
+    {
+        m_entries = other.m_entries;
+    }
+
+    return *this;
+}
+
+bool Roster::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+int Roster::size() const
+{
+    return m_entries.size();
+}
+
+QList<Roster::Entry> Roster::entries() const
+{
+    return m_entries;
+}
+
+void Roster::addEntry(const Entry &entry)
+{
+    m_entries.append(entry);
+}
+
+QStringList Roster::userGroupNames() const
+{
+    QStringList userGroupNames;
+    QSet<QString> foundUserGroupNames;
+
+    foreach (const Entry &entry, m_entries)
+    {
+        foreach (const QString &userGroupName, entry.userGroupNames)
+        {
+            if (!foundUserGroupNames.contains(userGroupName))
+            {
+                foundUserGroupNames.insert(userGroupName);
+                userGroupNames.append(userGroupName);
+            }
+        }
+    }
+
+    return userGroupNames;
+}
+
+Roster Roster::fromCsv(const QByteArray &data, bool *ok)
+{
+    Roster roster;
+    bool success = true;
+
+    foreach (const QString &line, QString::fromUtf8(data).split('\n'))
+    {
+        const QString trimmedLine = line.trimmed();
+
+        // Skip empty lines and comments
+        if (trimmedLine.isEmpty() || trimmedLine.startsWith('#'))
+        {
+            continue;
+        }
+
+        // Parse the fields: name, password and user groups
+        const QStringList fields = trimmedLine.split(',');
+
+        if (fields.size() > 3)
+        {
+            // Error, too many fields
+            success = false;
+            break;
+        }
+
+        Entry entry;
+        entry.userName = fields.at(0).trimmed();
+
+        if (fields.size() > 1)
+        {
+            entry.password = fields.at(1).trimmed();
+        }
+
+        if (fields.size() > 2)
+        {
+            foreach (const QString &userGroupName, fields.at(2).split(';', QString::SkipEmptyParts))
+            {
+                entry.userGroupNames.append(userGroupName.trimmed());
+            }
+        }
+
+        roster.addEntry(entry);
+    }
+
+    if (!success)
+    {
+        roster = Roster();
+    }
+
+    if (ok != nullptr)
+    {
+        *ok = success;
+    }
+
+    return roster;
+}
+
+Roster Roster::fromJson(const QByteArray &data, bool *ok)
+{
+    Roster roster;
+    const QJsonDocument document = QJsonDocument::fromJson(data);
+    bool success = document.isArray();
+
+    if (success)
+    {
+        foreach (const QJsonValue &value, document.array())
+        {
+            const QJsonObject object = value.toObject();
+            success = false;
+
+            // Parse the user's name and password
+            Entry entry;
+
+            if (object.value("name").isString())
+            {
+                entry.userName = object.value("name").toString();
+                success = true;
+            }
+
+            if (success && object.contains("password"))
+            {
+                success = object.value("password").isString();
+                entry.password = object.value("password").toString();
+            }
+
+            // Parse the user groups
+            if (success && object.contains("groups"))
+            {
+                success = object.value("groups").isArray();
+
+                foreach (const QJsonValue &userGroupName, object.value("groups").toArray())
+                {
+                    if (!userGroupName.isString())
+                    {
+                        success = false;
+                        break;
+                    }
+
+                    entry.userGroupNames.append(userGroupName.toString());
+                }
+            }
+
+            if (!success)
+            {
+                // Error, invalid entry
+                break;
+            }
+
+            roster.addEntry(entry);
+        }
+    }
+
+    if (!success)
+    {
+        roster = Roster();
+    }
+
+    if (ok != nullptr)
+    {
+        *ok = success;
+    }
+
+    return roster;
+}
+
+Roster Roster::fromFile(const QString &filePath, bool *ok)
+{
+    Roster roster;
+    bool success = false;
+    QFile file(filePath);
+
+    if (file.open(QIODevice::ReadOnly))
+    {
+        const QByteArray data = file.readAll();
+
+        if (QFileInfo(filePath).suffix().compare("json", Qt::CaseInsensitive) == 0)
+        {
+            roster = fromJson(data, &success);
+        }
+        else
+        {
+            roster = fromCsv(data, &success);
+        }
+    }
+
+    if (ok != nullptr)
+    {
+        *ok = success;
+    }
+
+    return roster;
+}
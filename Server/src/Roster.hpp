@@ -0,0 +1,160 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_ROSTER_HPP
+#define OPENTIMETRACKER_SERVER_ROSTER_HPP
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   List of users (with their user groups) that shall be imported into the database
+ *
+ * A roster can be read from CSV or JSON data:
+ *
+ * - CSV: one user per line in the format "name,password,group1;group2". Empty lines and lines
+ *   starting with '#' are ignored and the password and the user groups are optional.
+ * - JSON: an array of objects with the keys "name", "password" (optional) and "groups" (optional
+ *   array of user group names).
+ */
+class Roster
+{
+public:
+    /*!
+     * \brief   Roster entry
+     */
+    struct Entry
+    {
+        /*!
+         * \brief   Name of the user
+         */
+        QString userName;
+
+        /*!
+         * \brief   Password of the user (empty for a disabled user)
+         */
+        QString password;
+
+        /*!
+         * \brief   Names of the user groups of the user
+         */
+        QStringList userGroupNames;
+    };
+
+    /*!
+     * \brief   Constructor
+     */
+    Roster();
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    Roster(const Roster &other);
+
+    /*!
+     * \brief   operator =
+     * \param   other   Object to be copied
+     *
+     * \return  Reference to the this object
+     */
+    Roster &operator =(const Roster &other);
+
+    /*!
+     * \brief   Checks if the roster is empty
+     *
+     * \retval  true    Empty
+     * \retval  false   Not empty
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief   Gets the number of entries
+     *
+     * \return  Number of entries
+     */
+    int size() const;
+
+    /*!
+     * \brief   Gets the entries
+     *
+     * \return  Entries
+     */
+    QList<Entry> entries() const;
+
+    /*!
+     * \brief   Adds an entry
+     *
+     * \param   entry   Entry
+     */
+    void addEntry(const Entry &entry);
+
+    /*!
+     * \brief   Gets the names of all user groups used in the roster
+     *
+     * \return  Names of the user groups in the order of their first appearance
+     */
+    QStringList userGroupNames() const;
+
+    /*!
+     * \brief   Creates a roster from CSV data
+     *
+     * \param       data    CSV data
+     * \param[out]  ok      Optional parameter for the parsing result
+     *
+     * \return  Roster (empty in case of an error)
+     */
+    static Roster fromCsv(const QByteArray &data, bool *ok = nullptr);
+
+    /*!
+     * \brief   Creates a roster from JSON data
+     *
+     * \param       data    JSON data
+     * \param[out]  ok      Optional parameter for the parsing result
+     *
+     * \return  Roster (empty in case of an error)
+     */
+    static Roster fromJson(const QByteArray &data, bool *ok = nullptr);
+
+    /*!
+     * \brief   Creates a roster from a file
+     *
+     * \param       filePath    Path to the file
+     * \param[out]  ok          Optional parameter for the parsing result
+     *
+     * \return  Roster (empty in case of an error)
+     *
+     * Files with the ".json" suffix are read as JSON and all other files as CSV.
+     */
+    static Roster fromFile(const QString &filePath, bool *ok = nullptr);
+
+private:
+    /*!
+     * \brief   Holds the entries
+     */
+    QList<Entry> m_entries;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_ROSTER_HPP
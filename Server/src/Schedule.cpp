@@ -14,50 +14,146 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Schedule.hpp"
+#include <QtCore/QSharedData>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of a schedule
+ */
+class ScheduleData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    ScheduleData()
+        : QSharedData(),
+          m_id(0LL),
+          m_scheduleTemplateId(0LL),
+          m_userId(0LL),
+          m_startTimestamp(),
+          m_endTimestamp()
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    ScheduleData(const ScheduleData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_scheduleTemplateId(other.m_scheduleTemplateId),
+          m_userId(other.m_userId),
+          m_startTimestamp(other.m_startTimestamp),
+          m_endTimestamp(other.m_endTimestamp)
+    {
+    }
+
+    /*!
+     * \brief   Holds the schedule's ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the ID of the schedule template that the schedule was expanded from
+     */
+    qint64 m_scheduleTemplateId;
+
+    /*!
+     * \brief   Holds the schedule's user ID
+     */
+    qint64 m_userId;
+
+    /*!
+     * \brief   Holds the schedule's start timestamp
+     */
+    QDateTime m_startTimestamp;
+
+    /*!
+     * \brief   Holds the schedule's end timestamp
+     */
+    QDateTime m_endTimestamp;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from schedules
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<ScheduleData> &defaultData()
+{
+    static const QSharedDataPointer<ScheduleData> data(new ScheduleData());
+
+    return data;
+}
+
+}
+}
 
 using namespace OpenTimeTracker::Server;
 
 Schedule::Schedule()
-    : m_id(0LL),
-      m_userId(0LL),
-      m_startTimestamp(),
-      m_endTimestamp()
+    : m_data(defaultData())
 {
 }
 
 Schedule::Schedule(const Schedule &other)
-    : m_id(other.m_id),
-      m_userId(other.m_userId),
-      m_startTimestamp(other.m_startTimestamp),
-      m_endTimestamp(other.m_endTimestamp)
+    : m_data(other.m_data)
+{
+}
+
+Schedule::Schedule(Schedule &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+Schedule::~Schedule()
 {
 }
 
 Schedule &Schedule::operator =(const Schedule &other)
 {
-    if (this != &other)
-    {
-        m_id = other.m_id;
-        m_userId = other.m_userId;
-        m_startTimestamp = other.m_startTimestamp;
-        m_endTimestamp = other.m_endTimestamp;
-    }
+    m_data = other.m_data;
 
     return *this;
 }
 
+Schedule &Schedule::operator =(Schedule &&other) noexcept
+{
+    m_data.swap(other.m_data);
+
+    return *this;
+}
+
+bool Schedule::operator ==(const Schedule &other) const
+{
+    return ((m_data->m_id == other.m_data->m_id) &&
+            (m_data->m_scheduleTemplateId == other.m_data->m_scheduleTemplateId) &&
+            (m_data->m_userId == other.m_data->m_userId) &&
+            (m_data->m_startTimestamp == other.m_data->m_startTimestamp) &&
+            (m_data->m_endTimestamp == other.m_data->m_endTimestamp));
+}
+
 bool Schedule::isValid() const
 {
     bool valid = true;
 
-    if ((m_id < 1LL) ||
-        (m_userId < 1LL) ||
-        (!m_startTimestamp.isValid()) ||
-        (!m_endTimestamp.isValid()))
+    if ((m_data->m_id < 0LL) ||
+        (m_data->m_scheduleTemplateId < 0LL) ||
+        ((m_data->m_id > 0LL) == (m_data->m_scheduleTemplateId > 0LL)) ||
+        (m_data->m_userId < 1LL) ||
+        (!m_data->m_startTimestamp.isValid()) ||
+        (!m_data->m_endTimestamp.isValid()))
     {
         valid = false;
     }
-    else if (m_startTimestamp >= m_endTimestamp)
+    else if (m_data->m_startTimestamp >= m_data->m_endTimestamp)
     {
         valid = false;
     }
@@ -71,42 +167,52 @@ bool Schedule::isValid() const
 
 qint64 Schedule::id() const
 {
-    return m_id;
+    return m_data->m_id;
 }
 
 void Schedule::setId(const qint64 &newId)
 {
-    m_id = newId;
+    m_data->m_id = newId;
+}
+
+qint64 Schedule::scheduleTemplateId() const
+{
+    return m_data->m_scheduleTemplateId;
+}
+
+void Schedule::setScheduleTemplateId(const qint64 &newScheduleTemplateId)
+{
+    m_data->m_scheduleTemplateId = newScheduleTemplateId;
 }
 
 qint64 Schedule::userId() const
 {
-    return m_userId;
+    return m_data->m_userId;
 }
 
 void Schedule::setUserId(const qint64 &newUserId)
 {
-    m_userId = newUserId;
+    m_data->m_userId = newUserId;
 }
 
 QDateTime Schedule::startTimestamp() const
 {
-    return m_startTimestamp;
+    return m_data->m_startTimestamp;
 }
 
 void Schedule::setStartTimestamp(const QDateTime &newStartTimestamp)
 {
-    m_startTimestamp = newStartTimestamp;
+    m_data->m_startTimestamp = newStartTimestamp;
 }
 
 QDateTime Schedule::endTimestamp() const
 {
-    return m_endTimestamp;
+    return m_data->m_endTimestamp;
 }
 
 void Schedule::setEndTimestamp(const QDateTime &newEndTimestamp)
 {
-    m_endTimestamp = newEndTimestamp;
+    m_data->m_endTimestamp = newEndTimestamp;
 }
 
 Schedule Schedule::fromMap(const QMap<QString, QVariant> &map)
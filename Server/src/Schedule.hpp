@@ -18,6 +18,7 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
@@ -26,6 +27,8 @@ namespace OpenTimeTracker
 namespace Server
 {
 
+class ScheduleData;
+
 /*!
  * \brief   Holds schedule entries
  */
@@ -43,6 +46,20 @@ public:
      */
     Schedule(const Schedule &other);
 
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    Schedule(Schedule &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~Schedule();
+
     /*!
      * \brief   operator =
      * \param   other   Object to be copied
@@ -51,11 +68,31 @@ public:
      */
     Schedule &operator =(const Schedule &other);
 
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    Schedule &operator =(Schedule &&other) noexcept;
+
+    /*!
+     * \brief   operator ==
+     * \param   other   Object to be compared
+     *
+     * \retval  true    Both schedules have the same IDs, user ID, start and end
+     * \retval  false   Schedules differ
+     */
+    bool operator ==(const Schedule &other) const;
+
     /*!
      * \brief   Checks if object is valid
      *
      * \retval  true    Valid
      * \retval  false   Invalid
+     *
+     * \note    A valid schedule has either an ID (stored schedule) or a schedule template ID
+     *          (expanded schedule), but not both.
      */
     bool isValid() const;
 
@@ -73,6 +110,20 @@ public:
      */
     void setId(const qint64 &newId);
 
+    /*!
+     * \brief   Gets the ID of the schedule template that the schedule was expanded from
+     *
+     * \return  Schedule template's ID or 0 if the schedule is stored in the database
+     */
+    qint64 scheduleTemplateId() const;
+
+    /*!
+     * \brief   Sets the ID of the schedule template that the schedule was expanded from
+     *
+     * \param   newScheduleTemplateId   Schedule template's new ID
+     */
+    void setScheduleTemplateId(const qint64 &newScheduleTemplateId);
+
     /*!
      * \brief   Gets schedule's user ID
      *
@@ -129,27 +180,14 @@ public:
 
 private:
     /*!
-     * \brief   Holds the schedule's ID
-     */
-    qint64 m_id;
-
-    /*!
-     * \brief   Holds the schedule's user ID
-     */
-    qint64 m_userId;
-
-    /*!
-     * \brief   Holds the schedule's start timestamp
+     * \brief   Holds the schedule's data, which is implicitly shared between the copies
      */
-    QDateTime m_startTimestamp;
-
-    /*!
-     * \brief   Holds the schedule's end timestamp
-     */
-    QDateTime m_endTimestamp;
+    QSharedDataPointer<ScheduleData> m_data;
 };
 
 }
 }
 
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::Schedule, Q_MOVABLE_TYPE);
+
 #endif // OPENTIMETRACKER_SERVER_SCHEDULE_HPP
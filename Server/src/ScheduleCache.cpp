@@ -0,0 +1,200 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QMap>
+#include "ScheduleCache.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+ScheduleCache::ScheduleCache()
+    : m_workingDays()
+{
+}
+
+void ScheduleCache::clear()
+{
+    m_workingDays.clear();
+}
+
+int ScheduleCache::workingDayCount() const
+{
+    return m_workingDays.size();
+}
+
+bool ScheduleCache::containsWorkingDay(const qint64 &workingDayId) const
+{
+    return m_workingDays.contains(workingDayId);
+}
+
+bool ScheduleCache::addWorkingDay(const qint64 &workingDayId,
+                                  const QDateTime &startTimestamp,
+                                  const QDateTime &endTimestamp,
+                                  const QList<Schedule> &schedules)
+{
+    bool success = false;
+
+    if ((workingDayId > 0LL) &&
+        startTimestamp.isValid() &&
+        endTimestamp.isValid() &&
+        (startTimestamp < endTimestamp))
+    {
+        success = true;
+
+        // Group the schedules by user, keeping the order of each user's schedules
+        QMap<qint64, QList<int> > userSchedules;
+
+        for (int i = 0; i < schedules.size(); i++)
+        {
+            if (schedules.at(i).isValid())
+            {
+                userSchedules[schedules.at(i).userId()].append(i);
+            }
+        }
+
+        // Store the valid schedules in the flat arrays
+        WorkingDay workingDay;
+        workingDay.startTimestamp = startTimestamp.toMSecsSinceEpoch();
+        workingDay.endTimestamp = endTimestamp.toMSecsSinceEpoch();
+        workingDay.scheduleIds.reserve(schedules.size());
+        workingDay.scheduleTemplateIds.reserve(schedules.size());
+        workingDay.intervals.reserve(schedules.size() * 2);
+        workingDay.userRanges.reserve(userSchedules.size());
+
+        for (QMap<qint64, QList<int> >::const_iterator it = userSchedules.constBegin();
+             it != userSchedules.constEnd();
+             ++it)
+        {
+            workingDay.userRanges.insert(it.key(),
+                                         qMakePair(workingDay.scheduleIds.size(),
+                                                   it.value().size()));
+
+            foreach (const int index, it.value())
+            {
+                const Schedule &schedule = schedules.at(index);
+
+                workingDay.scheduleIds.append(schedule.id());
+                workingDay.scheduleTemplateIds.append(schedule.scheduleTemplateId());
+                workingDay.intervals.append(schedule.startTimestamp().toMSecsSinceEpoch());
+                workingDay.intervals.append(schedule.endTimestamp().toMSecsSinceEpoch());
+            }
+        }
+
+        m_workingDays.insert(workingDayId, workingDay);
+    }
+
+    return success;
+}
+
+void ScheduleCache::removeWorkingDay(const qint64 &workingDayId)
+{
+    m_workingDays.remove(workingDayId);
+}
+
+void ScheduleCache::invalidate(const QDateTime &startTimestamp, const QDateTime &endTimestamp)
+{
+    const qint64 start = startTimestamp.toMSecsSinceEpoch();
+    const qint64 end = endTimestamp.toMSecsSinceEpoch();
+    QHash<qint64, WorkingDay>::iterator it = m_workingDays.begin();
+
+    while (it != m_workingDays.end())
+    {
+        if ((it.value().startTimestamp <= end) && (start <= it.value().endTimestamp))
+        {
+            it = m_workingDays.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ScheduleCache::invalidateSchedule(const qint64 &scheduleId)
+{
+    QHash<qint64, WorkingDay>::iterator it = m_workingDays.begin();
+
+    while (it != m_workingDays.end())
+    {
+        if (it.value().scheduleIds.contains(scheduleId))
+        {
+            it = m_workingDays.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+int ScheduleCache::scheduleCount(const qint64 &workingDayId, const qint64 &userId) const
+{
+    int count = 0;
+    const QHash<qint64, WorkingDay>::const_iterator it = m_workingDays.constFind(workingDayId);
+
+    if (it != m_workingDays.constEnd())
+    {
+        count = it.value().userRanges.value(userId, qMakePair(0, 0)).second;
+    }
+
+    return count;
+}
+
+QList<Schedule> ScheduleCache::schedules(const qint64 &workingDayId, const qint64 &userId) const
+{
+    QList<Schedule> scheduleList;
+    const QHash<qint64, WorkingDay>::const_iterator it = m_workingDays.constFind(workingDayId);
+
+    if (it != m_workingDays.constEnd())
+    {
+        const WorkingDay &workingDay = it.value();
+        const QPair<int, int> range = workingDay.userRanges.value(userId, qMakePair(0, 0));
+        scheduleList.reserve(range.second);
+
+        for (int i = range.first; i < (range.first + range.second); i++)
+        {
+            const qint64 start = workingDay.intervals.at(i * 2);
+            const qint64 end = workingDay.intervals.at((i * 2) + 1);
+
+            Schedule schedule;
+            schedule.setId(workingDay.scheduleIds.at(i));
+            schedule.setScheduleTemplateId(workingDay.scheduleTemplateIds.at(i));
+            schedule.setUserId(userId);
+            schedule.setStartTimestamp(QDateTime::fromMSecsSinceEpoch(start, Qt::UTC));
+            schedule.setEndTimestamp(QDateTime::fromMSecsSinceEpoch(end, Qt::UTC));
+            scheduleList.append(schedule);
+        }
+    }
+
+    return scheduleList;
+}
+
+qint32 ScheduleCache::scheduledTime(const qint64 &workingDayId, const qint64 &userId) const
+{
+    qint64 time = 0LL;
+    const QHash<qint64, WorkingDay>::const_iterator it = m_workingDays.constFind(workingDayId);
+
+    if (it != m_workingDays.constEnd())
+    {
+        const QPair<int, int> range = it.value().userRanges.value(userId, qMakePair(0, 0));
+        const qint64 *intervals = it.value().intervals.constData() + (range.first * 2);
+
+        for (int i = 0; i < range.second; i++)
+        {
+            time += intervals[(i * 2) + 1] - intervals[i * 2];
+        }
+    }
+
+    return static_cast<qint32>(time / 1000LL);
+}
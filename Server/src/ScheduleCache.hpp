@@ -0,0 +1,191 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_SCHEDULECACHE_HPP
+#define OPENTIMETRACKER_SERVER_SCHEDULECACHE_HPP
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QVector>
+#include "Schedule.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   In-memory cache of the schedules of all users per working day
+ *
+ * The cache is keyed by the ID of the working day. The schedules of a working day are stored as
+ * flat arrays (schedule IDs and start/end timestamps in milliseconds since the epoch) that are
+ * grouped by user, so each user's schedules are a contiguous range of the arrays.
+ *
+ * The cache doesn't access the database. The schedules of a working day are added with a single
+ * list (e.g. read for all users with one query) and the working day must be removed from the cache
+ * when its schedules are changed in the database.
+ */
+class ScheduleCache
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    ScheduleCache();
+
+    /*!
+     * \brief   Removes all working days from the cache
+     */
+    void clear();
+
+    /*!
+     * \brief   Gets the number of cached working days
+     *
+     * \return  Number of working days
+     */
+    int workingDayCount() const;
+
+    /*!
+     * \brief   Checks if the working day is cached
+     *
+     * \param   workingDayId    ID of the working day
+     *
+     * \retval  true    Working day is cached
+     * \retval  false   Working day is not cached
+     */
+    bool containsWorkingDay(const qint64 &workingDayId) const;
+
+    /*!
+     * \brief   Adds the working day and its schedules to the cache
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   startTimestamp  Start of the working day
+     * \param   endTimestamp    End of the working day
+     * \param   schedules       Schedules of all users for the working day
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid working day
+     *
+     * Schedules that are already cached for the working day are replaced. Invalid schedules are
+     * skipped so that they don't prevent the rest of the working day from being cached.
+     */
+    bool addWorkingDay(const qint64 &workingDayId,
+                       const QDateTime &startTimestamp,
+                       const QDateTime &endTimestamp,
+                       const QList<Schedule> &schedules);
+
+    /*!
+     * \brief   Removes the working day from the cache
+     *
+     * \param   workingDayId    ID of the working day
+     */
+    void removeWorkingDay(const qint64 &workingDayId);
+
+    /*!
+     * \brief   Removes the working days that overlap with the time range from the cache
+     *
+     * \param   startTimestamp  Start of the time range
+     * \param   endTimestamp    End of the time range
+     */
+    void invalidate(const QDateTime &startTimestamp, const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Removes the working days that contain the schedule from the cache
+     *
+     * \param   scheduleId  ID of the schedule
+     */
+    void invalidateSchedule(const qint64 &scheduleId);
+
+    /*!
+     * \brief   Gets the number of the user's schedules for the working day
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   userId          ID of the user
+     *
+     * \return  Number of schedules
+     */
+    int scheduleCount(const qint64 &workingDayId, const qint64 &userId) const;
+
+    /*!
+     * \brief   Gets the user's schedules for the working day
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   userId          ID of the user
+     *
+     * \return  Schedules ordered by their start timestamp
+     */
+    QList<Schedule> schedules(const qint64 &workingDayId, const qint64 &userId) const;
+
+    /*!
+     * \brief   Gets the user's total scheduled time for the working day
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   userId          ID of the user
+     *
+     * \return  Scheduled time (in seconds)
+     */
+    qint32 scheduledTime(const qint64 &workingDayId, const qint64 &userId) const;
+
+private:
+    /*!
+     * \brief   Schedules of a working day
+     */
+    struct WorkingDay
+    {
+        /*!
+         * \brief   Start of the working day (milliseconds since the epoch)
+         */
+        qint64 startTimestamp;
+
+        /*!
+         * \brief   End of the working day (milliseconds since the epoch)
+         */
+        qint64 endTimestamp;
+
+        /*!
+         * \brief   IDs of the schedules
+         */
+        QVector<qint64> scheduleIds;
+
+        /*!
+         * \brief   IDs of the schedule templates that the schedules were expanded from
+         */
+        QVector<qint64> scheduleTemplateIds;
+
+        /*!
+         * \brief   Start and end of each schedule (milliseconds since the epoch), the schedule at
+         *          index N is stored at indexes 2N and 2N+1
+         */
+        QVector<qint64> intervals;
+
+        /*!
+         * \brief   Range of each user's schedules in the arrays as a pair of the first index and
+         *          the number of schedules (by user ID)
+         */
+        QHash<qint64, QPair<int, int> > userRanges;
+    };
+
+    /*!
+     * \brief   Holds the cached working days (by working day ID)
+     */
+    QHash<qint64, WorkingDay> m_workingDays;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_SCHEDULECACHE_HPP
@@ -0,0 +1,108 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ScheduleIndex.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+ScheduleIndex::ScheduleIndex()
+    : m_intervals(),
+      m_size(0)
+{
+}
+
+void ScheduleIndex::clear()
+{
+    m_intervals.clear();
+    m_size = 0;
+}
+
+int ScheduleIndex::size() const
+{
+    return m_size;
+}
+
+bool ScheduleIndex::overlaps(const qint64 &userId,
+                             const QDateTime &startTimestamp,
+                             const QDateTime &endTimestamp) const
+{
+    bool overlapping = false;
+    const QHash<qint64, QVector<QPair<qint64, qint64> > >::const_iterator it =
+            m_intervals.constFind(userId);
+
+    if (it != m_intervals.constEnd())
+    {
+        const qint64 start = startTimestamp.toMSecsSinceEpoch();
+        const qint64 end = endTimestamp.toMSecsSinceEpoch();
+
+        // Only the last interval that starts before the end of the new interval can overlap
+        const int index = lowerBound(it.value(), end);
+
+        if (index > 0)
+        {
+            overlapping = (start < it.value().at(index - 1).second);
+        }
+    }
+
+    return overlapping;
+}
+
+bool ScheduleIndex::insert(const qint64 &userId,
+                           const QDateTime &startTimestamp,
+                           const QDateTime &endTimestamp)
+{
+    bool success = false;
+
+    if (startTimestamp.isValid() && endTimestamp.isValid() && (startTimestamp < endTimestamp))
+    {
+        if (!overlaps(userId, startTimestamp, endTimestamp))
+        {
+            // Insert the interval so that the intervals stay sorted
+            const qint64 start = startTimestamp.toMSecsSinceEpoch();
+            QVector<QPair<qint64, qint64> > &intervals = m_intervals[userId];
+
+            intervals.insert(lowerBound(intervals, start),
+                             qMakePair(start, endTimestamp.toMSecsSinceEpoch()));
+            m_size++;
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+int ScheduleIndex::lowerBound(const QVector<QPair<qint64, qint64> > &intervals,
+                              const qint64 timestamp)
+{
+    int first = 0;
+    int count = intervals.size();
+
+    while (count > 0)
+    {
+        const int step = count / 2;
+
+        if (intervals.at(first + step).first < timestamp)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
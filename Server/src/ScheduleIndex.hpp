@@ -0,0 +1,113 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_SCHEDULEINDEX_HPP
+#define OPENTIMETRACKER_SERVER_SCHEDULEINDEX_HPP
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include <QtCore/QVector>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Index of the users' schedule intervals used to detect overlapping schedules
+ *
+ * The intervals of each user are kept in an array sorted by their start. Since the intervals of a
+ * user never overlap, their ends are sorted too and a new interval can only overlap with the last
+ * interval that starts before the new interval ends, which is found with a binary search.
+ *
+ * Intervals are half-open: a schedule may start exactly when the previous schedule ends.
+ */
+class ScheduleIndex
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    ScheduleIndex();
+
+    /*!
+     * \brief   Removes all intervals from the index
+     */
+    void clear();
+
+    /*!
+     * \brief   Gets the number of intervals in the index
+     *
+     * \return  Number of intervals
+     */
+    int size() const;
+
+    /*!
+     * \brief   Checks if the interval overlaps with any of the user's intervals
+     *
+     * \param   userId          ID of the user
+     * \param   startTimestamp  Start of the interval
+     * \param   endTimestamp    End of the interval
+     *
+     * \retval  true    Interval overlaps
+     * \retval  false   Interval doesn't overlap
+     */
+    bool overlaps(const qint64 &userId,
+                  const QDateTime &startTimestamp,
+                  const QDateTime &endTimestamp) const;
+
+    /*!
+     * \brief   Adds the interval to the user's intervals
+     *
+     * \param   userId          ID of the user
+     * \param   startTimestamp  Start of the interval
+     * \param   endTimestamp    End of the interval
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid interval or it overlaps with one of the user's intervals
+     */
+    bool insert(const qint64 &userId,
+                const QDateTime &startTimestamp,
+                const QDateTime &endTimestamp);
+
+private:
+    /*!
+     * \brief   Finds the position of the first interval that starts at or after the timestamp
+     *
+     * \param   intervals   Intervals sorted by their start
+     * \param   timestamp   Timestamp (milliseconds since the epoch)
+     *
+     * \return  Index of the interval or size of the array if there is no such interval
+     */
+    static int lowerBound(const QVector<QPair<qint64, qint64> > &intervals,
+                          const qint64 timestamp);
+
+    /*!
+     * \brief   Holds the intervals (milliseconds since the epoch) of each user (by user ID) sorted
+     *          by their start
+     */
+    QHash<qint64, QVector<QPair<qint64, qint64> > > m_intervals;
+
+    /*!
+     * \brief   Holds the number of intervals in the index
+     */
+    int m_size;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_SCHEDULEINDEX_HPP
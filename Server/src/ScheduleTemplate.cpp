@@ -0,0 +1,448 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ScheduleTemplate.hpp"
+#include <QtCore/QSharedData>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of a schedule template
+ */
+class ScheduleTemplateData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    ScheduleTemplateData()
+        : QSharedData(),
+          m_id(0LL),
+          m_userId(0LL),
+          m_dayOfWeek(0),
+          m_startTime(),
+          m_duration(0),
+          m_validFrom(),
+          m_validUntil(),
+          m_exceptions()
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    ScheduleTemplateData(const ScheduleTemplateData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_userId(other.m_userId),
+          m_dayOfWeek(other.m_dayOfWeek),
+          m_startTime(other.m_startTime),
+          m_duration(other.m_duration),
+          m_validFrom(other.m_validFrom),
+          m_validUntil(other.m_validUntil),
+          m_exceptions(other.m_exceptions)
+    {
+    }
+
+    /*!
+     * \brief   Holds the schedule template's ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the schedule template's user ID
+     */
+    qint64 m_userId;
+
+    /*!
+     * \brief   Holds the day of the week on which the schedule takes place
+     */
+    int m_dayOfWeek;
+
+    /*!
+     * \brief   Holds the time of day at which the schedule starts
+     */
+    QTime m_startTime;
+
+    /*!
+     * \brief   Holds the duration of the schedule in seconds
+     */
+    qint32 m_duration;
+
+    /*!
+     * \brief   Holds the first date on which the template is valid
+     */
+    QDate m_validFrom;
+
+    /*!
+     * \brief   Holds the last date on which the template is valid
+     */
+    QDate m_validUntil;
+
+    /*!
+     * \brief   Holds the dates on which the schedule doesn't take place
+     */
+    QList<QDate> m_exceptions;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from schedule templates
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<ScheduleTemplateData> &defaultData()
+{
+    static const QSharedDataPointer<ScheduleTemplateData> data(new ScheduleTemplateData());
+
+    return data;
+}
+
+}
+}
+
+using namespace OpenTimeTracker::Server;
+
+ScheduleTemplate::ScheduleTemplate()
+    : m_data(defaultData())
+{
+}
+
+ScheduleTemplate::ScheduleTemplate(const ScheduleTemplate &other)
+    : m_data(other.m_data)
+{
+}
+
+ScheduleTemplate::ScheduleTemplate(ScheduleTemplate &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+ScheduleTemplate::~ScheduleTemplate()
+{
+}
+
+ScheduleTemplate &ScheduleTemplate::operator =(const ScheduleTemplate &other)
+{
+    m_data = other.m_data;
+
+    return *this;
+}
+
+ScheduleTemplate &ScheduleTemplate::operator =(ScheduleTemplate &&other) noexcept
+{
+    m_data.swap(other.m_data);
+
+    return *this;
+}
+
+bool ScheduleTemplate::isValid() const
+{
+    bool valid = true;
+
+    if ((m_data->m_id < 1LL) ||
+        (m_data->m_userId < 1LL) ||
+        (m_data->m_dayOfWeek < Qt::Monday) ||
+        (m_data->m_dayOfWeek > Qt::Sunday) ||
+        (!m_data->m_startTime.isValid()) ||
+        (!m_data->m_validFrom.isValid()))
+    {
+        valid = false;
+    }
+    else if ((m_data->m_duration < 1) || (m_data->m_duration > (24 * 3600)))
+    {
+        valid = false;
+    }
+    else if ((!m_data->m_validUntil.isNull()) && (m_data->m_validUntil < m_data->m_validFrom))
+    {
+        valid = false;
+    }
+    else
+    {
+        // Valid
+    }
+
+    return valid;
+}
+
+qint64 ScheduleTemplate::id() const
+{
+    return m_data->m_id;
+}
+
+void ScheduleTemplate::setId(const qint64 &newId)
+{
+    m_data->m_id = newId;
+}
+
+qint64 ScheduleTemplate::userId() const
+{
+    return m_data->m_userId;
+}
+
+void ScheduleTemplate::setUserId(const qint64 &newUserId)
+{
+    m_data->m_userId = newUserId;
+}
+
+int ScheduleTemplate::dayOfWeek() const
+{
+    return m_data->m_dayOfWeek;
+}
+
+void ScheduleTemplate::setDayOfWeek(const int newDayOfWeek)
+{
+    m_data->m_dayOfWeek = newDayOfWeek;
+}
+
+QTime ScheduleTemplate::startTime() const
+{
+    return m_data->m_startTime;
+}
+
+void ScheduleTemplate::setStartTime(const QTime &newStartTime)
+{
+    m_data->m_startTime = newStartTime;
+}
+
+qint32 ScheduleTemplate::duration() const
+{
+    return m_data->m_duration;
+}
+
+void ScheduleTemplate::setDuration(const qint32 newDuration)
+{
+    m_data->m_duration = newDuration;
+}
+
+QDate ScheduleTemplate::validFrom() const
+{
+    return m_data->m_validFrom;
+}
+
+void ScheduleTemplate::setValidFrom(const QDate &newValidFrom)
+{
+    m_data->m_validFrom = newValidFrom;
+}
+
+QDate ScheduleTemplate::validUntil() const
+{
+    return m_data->m_validUntil;
+}
+
+void ScheduleTemplate::setValidUntil(const QDate &newValidUntil)
+{
+    m_data->m_validUntil = newValidUntil;
+}
+
+QList<QDate> ScheduleTemplate::exceptions() const
+{
+    return m_data->m_exceptions;
+}
+
+void ScheduleTemplate::addException(const QDate &date)
+{
+    if (date.isValid() && (!m_data->m_exceptions.contains(date)))
+    {
+        m_data->m_exceptions.append(date);
+    }
+}
+
+bool ScheduleTemplate::occursOn(const QDate &date) const
+{
+    bool occurs = false;
+
+    if (isValid() && date.isValid() && (date.dayOfWeek() == m_data->m_dayOfWeek))
+    {
+        if ((m_data->m_validFrom <= date) &&
+            (m_data->m_validUntil.isNull() || (date <= m_data->m_validUntil)) &&
+            (!m_data->m_exceptions.contains(date)))
+        {
+            occurs = true;
+        }
+    }
+
+    return occurs;
+}
+
+QList<Schedule> ScheduleTemplate::expand(const QDateTime &startTimestamp,
+                                         const QDateTime &endTimestamp) const
+{
+    QList<Schedule> schedules;
+
+    if (isValid() && startTimestamp.isValid() && endTimestamp.isValid())
+    {
+        // Only the schedules that start within the time range are needed, so only the dates of the
+        // time range (in local time) have to be checked
+        const QDate firstDate = startTimestamp.toLocalTime().date();
+        const QDate lastDate = endTimestamp.toLocalTime().date();
+
+        for (QDate date = firstDate; date <= lastDate; date = date.addDays(1))
+        {
+            if (occursOn(date))
+            {
+                QDateTime scheduleStart(date, m_data->m_startTime, Qt::LocalTime);
+
+                if (!scheduleStart.isValid())
+                {
+                    // Start time falls into a daylight saving time gap, so the time elapsed since
+                    // the start of the day is used instead (this shifts it past the gap)
+                    scheduleStart = QDateTime(date, QTime(0, 0), Qt::LocalTime).addMSecs(
+                                        QTime(0, 0).msecsTo(m_data->m_startTime));
+                }
+
+                const QDateTime scheduleEnd = scheduleStart.addSecs(m_data->m_duration);
+
+                if (scheduleStart.isValid() &&
+                    (startTimestamp <= scheduleStart) &&
+                    (scheduleEnd <= endTimestamp))
+                {
+                    Schedule schedule;
+                    schedule.setScheduleTemplateId(m_data->m_id);
+                    schedule.setUserId(m_data->m_userId);
+                    schedule.setStartTimestamp(scheduleStart);
+                    schedule.setEndTimestamp(scheduleEnd);
+                    schedules.append(schedule);
+                }
+            }
+        }
+    }
+
+    return schedules;
+}
+
+ScheduleTemplate ScheduleTemplate::fromMap(const QMap<QString, QVariant> &map)
+{
+    ScheduleTemplate scheduleTemplate;
+
+    if (map.size() == 7)
+    {
+        bool success = false;
+
+        // Get schedule template ID
+        QVariant value = map["id"];
+
+        if (value.canConvert<qint64>())
+        {
+            scheduleTemplate.setId(value.toLongLong(&success));
+        }
+
+        // Get schedule template user ID
+        if (success)
+        {
+            value = map["userId"];
+
+            if (value.canConvert<qint64>())
+            {
+                scheduleTemplate.setUserId(value.toLongLong(&success));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        // Get day of the week
+        if (success)
+        {
+            value = map["dayOfWeek"];
+
+            if (value.canConvert<int>())
+            {
+                scheduleTemplate.setDayOfWeek(value.toInt(&success));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        // Get start time
+        if (success)
+        {
+            value = map["startTime"];
+
+            if (value.canConvert<QString>())
+            {
+                scheduleTemplate.setStartTime(QTime::fromString(value.toString(), Qt::ISODate));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        // Get duration
+        if (success)
+        {
+            value = map["duration"];
+
+            if (value.canConvert<qint32>())
+            {
+                scheduleTemplate.setDuration(value.toInt(&success));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        // Get first valid date
+        if (success)
+        {
+            value = map["validFrom"];
+
+            if (value.canConvert<QString>())
+            {
+                scheduleTemplate.setValidFrom(QDate::fromString(value.toString(), Qt::ISODate));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        // Get last valid date (optional)
+        if (success)
+        {
+            value = map["validUntil"];
+
+            if (value.isNull())
+            {
+                scheduleTemplate.setValidUntil(QDate());
+            }
+            else if (value.canConvert<QString>())
+            {
+                scheduleTemplate.setValidUntil(QDate::fromString(value.toString(), Qt::ISODate));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        // On error clear the object
+        if (!success)
+        {
+            scheduleTemplate = ScheduleTemplate();
+        }
+    }
+
+    return scheduleTemplate;
+}
@@ -0,0 +1,260 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_SCHEDULETEMPLATE_HPP
+#define OPENTIMETRACKER_SERVER_SCHEDULETEMPLATE_HPP
+
+#include <QtCore/QDate>
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
+#include <QtCore/QString>
+#include <QtCore/QTime>
+#include <QtCore/QVariant>
+#include "Schedule.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+class ScheduleTemplateData;
+
+/*!
+ * \brief   Holds a recurring schedule template
+ *
+ * A schedule template describes a schedule that repeats every week on the same day of the week at
+ * the same time of day (local time) for as long as the template is valid. Instead of storing a
+ * schedule for every week the template is expanded into schedules only for the time range that is
+ * needed, for example the working day that is being tracked.
+ *
+ * Dates on which the schedule doesn't take place are stored as the template's exceptions.
+ */
+class ScheduleTemplate
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    ScheduleTemplate();
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    ScheduleTemplate(const ScheduleTemplate &other);
+
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    ScheduleTemplate(ScheduleTemplate &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~ScheduleTemplate();
+
+    /*!
+     * \brief   operator =
+     * \param   other   Object to be copied
+     *
+     * \return  Reference to the this object
+     */
+    ScheduleTemplate &operator =(const ScheduleTemplate &other);
+
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    ScheduleTemplate &operator =(ScheduleTemplate &&other) noexcept;
+
+    /*!
+     * \brief   Checks if object is valid
+     *
+     * \retval  true    Valid
+     * \retval  false   Invalid
+     */
+    bool isValid() const;
+
+    /*!
+     * \brief   Gets schedule template's ID
+     *
+     * \return  Schedule template's ID
+     */
+    qint64 id() const;
+
+    /*!
+     * \brief   Sets schedule template's new ID
+     *
+     * \param   newId   Schedule template's new ID
+     */
+    void setId(const qint64 &newId);
+
+    /*!
+     * \brief   Gets schedule template's user ID
+     *
+     * \return  Schedule template's user ID
+     */
+    qint64 userId() const;
+
+    /*!
+     * \brief   Sets schedule template's user ID
+     *
+     * \param   newUserId   New schedule template's user ID
+     */
+    void setUserId(const qint64 &newUserId);
+
+    /*!
+     * \brief   Gets the day of the week on which the schedule takes place
+     *
+     * \return  Day of the week (Qt::DayOfWeek: 1 for Monday, 7 for Sunday)
+     */
+    int dayOfWeek() const;
+
+    /*!
+     * \brief   Sets the day of the week on which the schedule takes place
+     *
+     * \param   newDayOfWeek    New day of the week (Qt::DayOfWeek: 1 for Monday, 7 for Sunday)
+     */
+    void setDayOfWeek(const int newDayOfWeek);
+
+    /*!
+     * \brief   Gets the time of day (local time) at which the schedule starts
+     *
+     * \return  Start time
+     */
+    QTime startTime() const;
+
+    /*!
+     * \brief   Sets the time of day (local time) at which the schedule starts
+     *
+     * \param   newStartTime    New start time
+     */
+    void setStartTime(const QTime &newStartTime);
+
+    /*!
+     * \brief   Gets the duration of the schedule
+     *
+     * \return  Duration in seconds
+     */
+    qint32 duration() const;
+
+    /*!
+     * \brief   Sets the duration of the schedule
+     *
+     * \param   newDuration     New duration in seconds (at most one day)
+     */
+    void setDuration(const qint32 newDuration);
+
+    /*!
+     * \brief   Gets the first date on which the template is valid
+     *
+     * \return  First valid date
+     */
+    QDate validFrom() const;
+
+    /*!
+     * \brief   Sets the first date on which the template is valid
+     *
+     * \param   newValidFrom    New first valid date
+     */
+    void setValidFrom(const QDate &newValidFrom);
+
+    /*!
+     * \brief   Gets the last date on which the template is valid
+     *
+     * \return  Last valid date or a null date if the template is valid indefinitely
+     */
+    QDate validUntil() const;
+
+    /*!
+     * \brief   Sets the last date on which the template is valid
+     *
+     * \param   newValidUntil   New last valid date or a null date if the template is valid
+     *                          indefinitely
+     */
+    void setValidUntil(const QDate &newValidUntil);
+
+    /*!
+     * \brief   Gets the dates on which the schedule doesn't take place
+     *
+     * \return  Exception dates
+     */
+    QList<QDate> exceptions() const;
+
+    /*!
+     * \brief   Adds a date on which the schedule doesn't take place
+     *
+     * \param   date    Exception date
+     */
+    void addException(const QDate &date);
+
+    /*!
+     * \brief   Checks if the schedule takes place on the date
+     *
+     * \param   date    Date
+     *
+     * \retval  true    Schedule takes place on the date
+     * \retval  false   Schedule doesn't take place on the date
+     */
+    bool occursOn(const QDate &date) const;
+
+    /*!
+     * \brief   Expands the template into the schedules within the time range
+     *
+     * \param   startTimestamp  Start of the time range
+     * \param   endTimestamp    End of the time range
+     *
+     * \return  Schedules that start and end within the time range, ordered by their start
+     *
+     * \note    The expanded schedules are not stored in the database so they get no ID, instead
+     *          they reference the template with their schedule template ID. An occurrence whose
+     *          start time doesn't exist on its date (daylight saving time gap) is shifted forward
+     *          by the length of the gap.
+     */
+    QList<Schedule> expand(const QDateTime &startTimestamp, const QDateTime &endTimestamp) const;
+
+    /*!
+     * \brief   Creates an object from a map
+     *
+     * \param   map     Map that contains the object's values
+     *
+     * \return  A new object
+     *
+     * \note    Created object is invalid if the values in the map cannot be used to create a valid
+     *          object. The exceptions are not part of the map.
+     */
+    static ScheduleTemplate fromMap(const QMap<QString, QVariant> &map);
+
+private:
+    /*!
+     * \brief   Holds the schedule template's data, which is implicitly shared between the copies
+     */
+    QSharedDataPointer<ScheduleTemplateData> m_data;
+};
+
+}
+}
+
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::ScheduleTemplate, Q_MOVABLE_TYPE);
+
+#endif // OPENTIMETRACKER_SERVER_SCHEDULETEMPLATE_HPP
@@ -13,22 +13,119 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QtAlgorithms>
 #include "Server.hpp"
+#include "Database/ChangeNotifier.hpp"
 #include "Database/DatabaseManagement.hpp"
+#include "Database/ScheduleManagement.hpp"
 #include "Database/UserManagement.hpp"
+#include "Packets/ClockEventRequestPacket.hpp"
+#include "Packets/ClockEventResponsePacket.hpp"
+#include "Packets/LoginRequestPacket.hpp"
+#include "Packets/LoginResponsePacket.hpp"
+#include "Packets/SubscribeUserStatusRequestPacket.hpp"
+#include "Packets/SubscribeUserStatusResponsePacket.hpp"
+#include "Packets/UserStatusPacket.hpp"
+#include "Packets/UserStatusPacketWriter.hpp"
+#include "Packets/UserTotalsRequestPacket.hpp"
+#include "Packets/UserTotalsResponsePacket.hpp"
+#include "Settings.hpp"
 
 using namespace OpenTimeTracker::Server;
 
 Server::Server(QObject *parent)
     : QObject(parent),
       m_tcpServer(nullptr),
+      m_ioThreadCount(Settings::defaultValue(Settings::Key_IoThreadCount)),
+      m_ioThreads(),
+      m_ioWorkers(),
+      m_nextIoWorker(0),
       m_clients(),
-      m_users(),
-      m_timeTrackers()
+      m_clientUserIds(),
+      m_userClients(),
+      m_statusSubscribers(),
+      m_clientSubscriptions(),
+      m_packetHandler(),
+      m_requestHandlers(),
+      m_idleTimeout(Settings::defaultValue(Settings::Key_IdleTimeout)),
+      m_keepAliveInterval(Settings::defaultValue(Settings::Key_KeepAliveInterval)),
+      m_maxFrameSize(Settings::defaultValue(Settings::Key_MaxFrameSize)),
+      m_maxInputBufferSize(Settings::defaultValue(Settings::Key_MaxInputBufferSize)),
+      m_compressionThreshold(Settings::defaultValue(Settings::Key_CompressionThreshold)),
+      m_idleTimer(),
+      m_idleTimerWheel(),
+      m_userDirectory(),
+      m_credentialCache(),
+      m_timeTrackers(),
+      m_workingDayCache(),
+      m_scheduleCache(),
+      m_workingDayId(0LL),
+      m_workingDay(),
+      m_workdayTimer(),
+      m_workdayRefreshScheduled(false),
+      m_eventRecorder()
 {
-    m_tcpServer = new QTcpServer(this);
+    // Register types that are passed between the threads
+    qRegisterMetaType<qintptr>("qintptr");
+    qRegisterMetaType<Client *>("Client*");
+    qRegisterMetaType<QSharedPointer<Packets::Packet> >("QSharedPointer<Packets::Packet>");
 
-    connect(m_tcpServer, SIGNAL(newConnection()), this, SLOT(addNewClient()));
+    m_tcpServer = new TcpServer(this);
+
+    connect(m_tcpServer, SIGNAL(newSocketDescriptor(qintptr)),
+            this, SLOT(dispatchConnection(qintptr)));
+    connect(&m_idleTimer, SIGNAL(timeout()), this, SLOT(checkIdleClients()));
+
+    m_workdayTimer.setSingleShot(true);
+    m_workdayTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_workdayTimer, SIGNAL(timeout()), this, SLOT(advanceWorkday()));
+
+    // Keep the cached users and schedules up to date with the changes committed to the database
+    Database::ChangeNotifier *changeNotifier = Database::ChangeNotifier::instance();
+
+    connect(changeNotifier, SIGNAL(userAdded(qint64,QString,QString)),
+            this, SLOT(applyUserAdded(qint64,QString,QString)));
+    connect(changeNotifier, SIGNAL(userNameChanged(qint64,QString)),
+            this, SLOT(applyUserNameChanged(qint64,QString)));
+    connect(changeNotifier, SIGNAL(userPasswordChanged(qint64,QString)),
+            this, SLOT(applyUserPasswordChanged(qint64,QString)));
+    connect(changeNotifier, SIGNAL(userGroupAdded(qint64,QString)),
+            this, SLOT(applyUserGroupAdded(qint64,QString)));
+    connect(changeNotifier, SIGNAL(userGroupNameChanged(qint64,QString)),
+            this, SLOT(applyUserGroupNameChanged(qint64,QString)));
+    connect(changeNotifier, SIGNAL(userMappingAdded(qint64,qint64,qint64)),
+            this, SLOT(applyUserMappingAdded(qint64,qint64,qint64)));
+    connect(changeNotifier, SIGNAL(userMappingRemoved(qint64)),
+            this, SLOT(applyUserMappingRemoved(qint64)));
+    connect(changeNotifier, SIGNAL(workingDayAdded(qint64,QDateTime,QDateTime)),
+            this, SLOT(applyWorkingDayAdded(qint64,QDateTime,QDateTime)));
+    connect(changeNotifier, SIGNAL(scheduleAdded(qint64,qint64,QDateTime,QDateTime)),
+            this, SLOT(applyScheduleAdded(qint64,qint64,QDateTime,QDateTime)));
+    connect(changeNotifier, SIGNAL(scheduleRemoved(qint64)),
+            this, SLOT(applyScheduleRemoved(qint64)));
+    connect(changeNotifier, SIGNAL(scheduleTemplateChanged(qint64)),
+            this, SLOT(applyScheduleTemplateChanged(qint64)));
+
+    // Register request handlers
+    registerRequestHandler(Packets::ClockEventRequestPacket::staticType(Event::Type_Started),
+                           &Server::processClockEventRequest);
+    registerRequestHandler(Packets::ClockEventRequestPacket::staticType(Event::Type_OnBreak),
+                           &Server::processClockEventRequest);
+    registerRequestHandler(Packets::ClockEventRequestPacket::staticType(Event::Type_FromBreak),
+                           &Server::processClockEventRequest);
+    registerRequestHandler(Packets::ClockEventRequestPacket::staticType(Event::Type_Finished),
+                           &Server::processClockEventRequest);
+    registerRequestHandler(Packets::LoginRequestPacket::staticType(),
+                           &Server::processLoginRequest);
+    registerRequestHandler(Packets::SubscribeUserStatusRequestPacket::staticType(),
+                           &Server::processSubscribeUserStatusRequest);
+    registerRequestHandler(Packets::UserTotalsRequestPacket::staticType(),
+                           &Server::processUserTotalsRequest);
+
+    // Register packet writers for the packets that are pushed to the clients
+    m_packetHandler.registerPacketWriter(new Packets::UserStatusPacketWriter());
+    m_packetHandler.setJsonFormat(QJsonDocument::Compact);
 }
 
 Server::~Server()
@@ -36,6 +133,9 @@ Server::~Server()
     // Remove all clients
     removeAllClients();
 
+    // Stop all I/O threads
+    stopIoThreads();
+
     // Delete TCP server
     m_tcpServer->deleteLater();
 }
@@ -68,10 +168,42 @@ bool Server::start(const quint16 port)
         initializeTimeTrackers();
     }
 
+    // Start the current workday (a working day doesn't need to be defined)
+    if (success)
+    {
+        readWorkingDays();
+        m_scheduleCache.clear();
+        startWorkday(QDateTime::currentDateTimeUtc());
+    }
+
+    // Start the I/O threads
+    if (success)
+    {
+        startIoThreads();
+    }
+
     // Start the TCP server
     if (success)
     {
         success = m_tcpServer->listen(QHostAddress::Any, port);
+
+        if (!success)
+        {
+            stopIoThreads();
+        }
+    }
+
+    // Start the idle timer, the idle timeout is checked with a resolution of 1/8 of the timeout
+    // (at most 1 second)
+    if (success && (m_idleTimeout > 0))
+    {
+        m_idleTimer.start(qBound(10, m_idleTimeout / 8, 1000));
+    }
+
+    // Start the next working day when the working day changes
+    if (success)
+    {
+        scheduleWorkdayTimer(QDateTime::currentDateTimeUtc());
     }
 
     return success;
@@ -81,62 +213,1010 @@ void Server::stop()
 {
     if (isStarted())
     {
-        // Close the TCP server and remove all clients
+        // Close the TCP server, remove all clients and stop the I/O threads
+        m_idleTimer.stop();
+        m_workdayTimer.stop();
         m_tcpServer->close();
         removeAllClients();
+        stopIoThreads();
+
+        // Write all recorded events to the database
+        m_eventRecorder.flush();
+    }
+}
+
+int Server::ioThreadCount() const
+{
+    return m_ioThreadCount;
+}
+
+void Server::setIoThreadCount(const int threadCount)
+{
+    m_ioThreadCount = threadCount;
+}
+
+int Server::idleTimeout() const
+{
+    return m_idleTimeout;
+}
+
+void Server::setIdleTimeout(const int timeout)
+{
+    m_idleTimeout = timeout;
+}
+
+int Server::keepAliveInterval() const
+{
+    return m_keepAliveInterval;
+}
+
+void Server::setKeepAliveInterval(const int interval)
+{
+    m_keepAliveInterval = interval;
+}
+
+int Server::maxFrameSize() const
+{
+    return m_maxFrameSize;
+}
+
+void Server::setMaxFrameSize(const int size)
+{
+    m_maxFrameSize = size;
+}
+
+int Server::maxInputBufferSize() const
+{
+    return m_maxInputBufferSize;
+}
+
+void Server::setMaxInputBufferSize(const int size)
+{
+    m_maxInputBufferSize = size;
+}
+
+int Server::compressionThreshold() const
+{
+    return m_compressionThreshold;
+}
+
+void Server::setCompressionThreshold(const int size)
+{
+    m_compressionThreshold = size;
+}
+
+QHash<QString, LatencyHistogram> Server::roundTripHistograms() const
+{
+    QHash<QString, LatencyHistogram> histograms;
+
+    foreach (Client *client, m_clients)
+    {
+        histograms[client->peerAddress()].merge(client->roundTripHistogram());
     }
+
+    return histograms;
+}
+
+int Server::clientCount() const
+{
+    return m_clients.size();
 }
 
-void Server::addNewClient()
+bool Server::setClientUserId(Client *client, const qint64 &userId)
 {
-    // For each pending connection (TCP socket) create a client and add it to the client list
-    while (m_tcpServer->hasPendingConnections() && m_tcpServer->isListening())
+    bool success = false;
+
+    if (m_clients.contains(client) && (userId >= 0LL))
     {
-        Client *client = new Client(this, m_tcpServer->nextPendingConnection());
-        connect(client, SIGNAL(disconnected(Client*)), this, SLOT(removeClient(Client*)));
-        m_clients.append(client);
-        client = nullptr;
+        // Unbind the client from its current user
+        if (m_clientUserIds.contains(client))
+        {
+            const qint64 oldUserId = m_clientUserIds.take(client);
+            QSet<Client *> &userClients = m_userClients[oldUserId];
+            userClients.remove(client);
+
+            if (userClients.isEmpty())
+            {
+                m_userClients.remove(oldUserId);
+            }
+        }
+
+        // Bind the client to the new user
+        if (userId > 0LL)
+        {
+            m_clientUserIds[client] = userId;
+            m_userClients[userId].insert(client);
+        }
+
+        success = true;
+    }
+
+    return success;
+}
+
+QList<Client *> Server::clientsOfUser(const qint64 &userId) const
+{
+    return m_userClients.value(userId).toList();
+}
+
+bool Server::sendToUser(const qint64 &userId, const QByteArray &packetData)
+{
+    bool success = false;
+    const QHash<qint64, QSet<Client *> >::const_iterator it = m_userClients.constFind(userId);
+
+    if (it != m_userClients.constEnd())
+    {
+        // Clients live in the I/O threads so the packet data is passed through their event queues
+        foreach (Client *client, it.value())
+        {
+            QMetaObject::invokeMethod(client,
+                                      "pushPacketData",
+                                      Qt::QueuedConnection,
+                                      Q_ARG(QByteArray, packetData));
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+bool Server::changeUserPassword(const qint64 &userId, const QString &newPassword)
+{
+    // The cached credentials are replaced by the change notification
+    return Database::UserManagement::changeUserPassword(userId, newPassword);
+}
+
+bool Server::startWorkday(const QDateTime &timestamp)
+{
+    qint64 workingDayId = 0LL;
+    const QPair<QDateTime, QDateTime> workingDay =
+            m_workingDayCache.findWorkingDay(timestamp, &workingDayId);
+    bool success = (workingDayId > 0LL);
+
+    // Read the schedules of all users (with the expanded schedule templates) for the working day if
+    // they are not cached yet
+    if (success && (!m_scheduleCache.containsWorkingDay(workingDayId)))
+    {
+        success = m_scheduleCache.addWorkingDay(
+                      workingDayId,
+                      workingDay.first,
+                      workingDay.second,
+                      Database::ScheduleManagement::readExpandedSchedules(workingDay.first,
+                                                                          workingDay.second));
+    }
+
+    // Remember the started working day
+    if (success)
+    {
+        m_workingDayId = workingDayId;
+        m_workingDay = workingDay;
+    }
+    else
+    {
+        m_workingDayId = 0LL;
+        m_workingDay = QPair<QDateTime, QDateTime>();
+    }
+
+    // Start the workday of each time tracker with its cached schedules
+    if (success)
+    {
+        for (QHash<qint64, TimeTracker>::iterator it = m_timeTrackers.begin();
+             it != m_timeTrackers.end();
+             ++it)
+        {
+            if (!it.value().startWorkday(BreakTimeCalculator(),
+                                         m_scheduleCache.schedules(workingDayId, it.key())))
+            {
+                success = false;
+            }
+        }
+    }
+
+    return success;
+}
+
+void Server::dispatchConnection(qintptr socketDescriptor)
+{
+    if (!m_ioWorkers.isEmpty())
+    {
+        // Hand over the connection to the next I/O worker (round-robin)
+        IoWorker *ioWorker = m_ioWorkers.at(m_nextIoWorker);
+        m_nextIoWorker = (m_nextIoWorker + 1) % m_ioWorkers.size();
+
+        QMetaObject::invokeMethod(ioWorker,
+                                  "addClient",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(qintptr, socketDescriptor));
+    }
+}
+
+void Server::addClient(Client *client)
+{
+    // Ignore clients that were added while the server was stopped or while its I/O workers were
+    // stopped, such clients are owned and deleted by their I/O worker
+    if (isStarted() && (!m_ioWorkers.isEmpty()))
+    {
+        // Add the client to the registry
+        m_clients.insert(client);
+
+        // Schedule the check for idle connection
+        if (m_idleTimer.isActive())
+        {
+            m_idleTimerWheel.add(client, toIdleTimerTicks(m_idleTimeout));
+        }
     }
 }
 
 void Server::removeClient(Client *client)
 {
-    // Take the client from the list, disconnect all signals that are connecting this class and the
-    // client, and delete the client object
-    m_clients.removeAll(client);
-    client->disconnect(this);
-    client->deleteLater();
+    // Ignore clients that were already removed
+    if (m_clients.contains(client))
+    {
+        // Unbind the client from its user
+        setClientUserId(client, 0LL);
+
+        // Cancel its subscriptions
+        unsubscribeUserStatus(client);
+
+        // Take the client from the registry, disconnect all signals that are connecting this class
+        // and the client, and delete the client object
+        m_clients.remove(client);
+        m_idleTimerWheel.remove(client);
+        client->disconnect(this);
+        client->deleteLater();
+    }
+}
+
+void Server::processRequest(Client *client, QSharedPointer<Packets::Packet> request)
+{
+    // Ignore requests of clients that were already removed
+    if (m_clients.contains(client) && (!request.isNull()))
+    {
+        // Dispatch the request to its handler
+        bool success = false;
+        const RequestHandler handler = m_requestHandlers.value(request->type(), nullptr);
+
+        if (handler != nullptr)
+        {
+            success = (this->*handler)(client, request);
+        }
+
+        if (!success)
+        {
+            // Error, invalid request, terminate the connection
+            QMetaObject::invokeMethod(client, "closeConnection", Qt::QueuedConnection);
+        }
+    }
+}
+
+void Server::checkIdleClients()
+{
+    foreach (QObject *object, m_idleTimerWheel.advance())
+    {
+        Client *client = static_cast<Client *>(object);
+        const qint64 idleTime = client->idleTime();
+
+        if (idleTime >= m_idleTimeout)
+        {
+            // Client was idle for too long, abort its connection in its own thread (client will be
+            // removed when it notifies that it was disconnected). The connection is not closed
+            // gracefully since the peer may be gone and its unsent data would keep the socket open.
+            QMetaObject::invokeMethod(client, "abortConnection", Qt::QueuedConnection);
+
+            // Check it again in case the connection could not be closed
+            m_idleTimerWheel.add(client, toIdleTimerTicks(m_idleTimeout));
+        }
+        else
+        {
+            // Client was active in the meantime, check it again when it could become idle
+            m_idleTimerWheel.add(client, toIdleTimerTicks(m_idleTimeout - idleTime));
+        }
+    }
+}
+
+void Server::applyUserAdded(const qint64 &userId, const QString &name, const QString &password)
+{
+    User user;
+    user.setId(userId);
+    user.setName(name);
+    user.setPassword(password);
+
+    if (m_userDirectory.addUser(user))
+    {
+        m_credentialCache.addUser(user);
+
+        // Create a time tracker for the new user and start its workday
+        TimeTracker timeTracker;
+        timeTracker.setUserId(userId);
+
+        if (m_workingDayId > 0LL)
+        {
+            timeTracker.startWorkday(BreakTimeCalculator(),
+                                     m_scheduleCache.schedules(m_workingDayId, userId));
+        }
+
+        m_timeTrackers.insert(userId, timeTracker);
+    }
+}
+
+void Server::applyUserNameChanged(const qint64 &userId, const QString &newName)
+{
+    // Re-index the user's cached credentials under the new name
+    if (m_userDirectory.changeUserName(userId, newName))
+    {
+        m_credentialCache.addUser(m_userDirectory.user(userId));
+    }
+}
+
+void Server::applyUserPasswordChanged(const qint64 &userId, const QString &newPassword)
+{
+    // Replace the user's cached credentials
+    if (m_userDirectory.changeUserPassword(userId, newPassword))
+    {
+        m_credentialCache.addUser(m_userDirectory.user(userId));
+    }
+}
+
+void Server::applyUserGroupAdded(const qint64 &userGroupId, const QString &name)
+{
+    UserGroup userGroup;
+    userGroup.setId(userGroupId);
+    userGroup.setName(name);
+
+    m_userDirectory.addUserGroup(userGroup);
+}
+
+void Server::applyUserGroupNameChanged(const qint64 &userGroupId, const QString &newName)
+{
+    m_userDirectory.changeUserGroupName(userGroupId, newName);
+}
+
+void Server::applyUserMappingAdded(const qint64 &userMappingId,
+                                   const qint64 &userGroupId,
+                                   const qint64 &userId)
+{
+    UserMapping userMapping;
+    userMapping.setId(userMappingId);
+    userMapping.setUserGroupId(userGroupId);
+    userMapping.setUserId(userId);
+
+    m_userDirectory.addUserMapping(userMapping);
+}
+
+void Server::applyUserMappingRemoved(const qint64 &userMappingId)
+{
+    m_userDirectory.removeUserMapping(userMappingId);
+}
+
+void Server::applyWorkingDayAdded(const qint64 &workingDayId,
+                                  const QDateTime &startTimestamp,
+                                  const QDateTime &endTimestamp)
+{
+    m_workingDayCache.addWorkingDay(workingDayId, startTimestamp, endTimestamp);
+
+    // The working day can start now or it can change the time of the next working day change
+    if (isStarted())
+    {
+        advanceWorkday();
+    }
+}
+
+void Server::applyScheduleAdded(const qint64 &scheduleId,
+                                const qint64 &userId,
+                                const QDateTime &startTimestamp,
+                                const QDateTime &endTimestamp)
+{
+    Q_UNUSED(scheduleId);
+    Q_UNUSED(userId);
+
+    m_scheduleCache.invalidate(startTimestamp, endTimestamp);
+    scheduleWorkdayRefresh();
+}
+
+void Server::applyScheduleRemoved(const qint64 &scheduleId)
+{
+    m_scheduleCache.invalidateSchedule(scheduleId);
+    scheduleWorkdayRefresh();
+}
+
+void Server::applyScheduleTemplateChanged(const qint64 &scheduleTemplateId)
+{
+    Q_UNUSED(scheduleTemplateId);
+
+    // A schedule template can affect any of the cached working days
+    m_scheduleCache.clear();
+    scheduleWorkdayRefresh();
+}
+
+void Server::advanceWorkday()
+{
+    const QDateTime currentTime = QDateTime::currentDateTimeUtc();
+
+    // Start the working day that contains the current time if it is not started yet
+    qint64 workingDayId = 0LL;
+    m_workingDayCache.findWorkingDay(currentTime, &workingDayId);
+
+    if (workingDayId != m_workingDayId)
+    {
+        startWorkday(currentTime);
+    }
+
+    scheduleWorkdayTimer(currentTime);
+}
+
+void Server::refreshWorkday()
+{
+    m_workdayRefreshScheduled = false;
+
+    if ((m_workingDayId > 0LL) && (!m_scheduleCache.containsWorkingDay(m_workingDayId)))
+    {
+        // Read the schedules of the started working day again
+        const bool success = m_scheduleCache.addWorkingDay(
+                                 m_workingDayId,
+                                 m_workingDay.first,
+                                 m_workingDay.second,
+                                 Database::ScheduleManagement::readExpandedSchedules(
+                                     m_workingDay.first,
+                                     m_workingDay.second));
+
+        // Replace the schedules of the affected time trackers without resetting their times
+        if (success)
+        {
+            for (QHash<qint64, TimeTracker>::iterator it = m_timeTrackers.begin();
+                 it != m_timeTrackers.end();
+                 ++it)
+            {
+                const QList<Schedule> schedules = m_scheduleCache.schedules(m_workingDayId,
+                                                                            it.key());
+
+                if (it.value().schedules() != schedules)
+                {
+                    it.value().changeSchedules(schedules);
+                }
+            }
+        }
+    }
+}
+
+void Server::registerRequestHandler(const QString &packetType, RequestHandler handler)
+{
+    m_requestHandlers[packetType] = handler;
+}
+
+bool Server::sendResponse(Client *client, const QSharedPointer<Packets::Packet> &response)
+{
+    bool success = false;
+
+    if (m_clients.contains(client))
+    {
+        // Client lives in an I/O thread so the response is passed through its event queue
+        QMetaObject::invokeMethod(client,
+                                  "sendResponse",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(QSharedPointer<Packets::Packet>, response));
+        success = true;
+    }
+
+    return success;
+}
+
+bool Server::processClockEventRequest(Client *client,
+                                      const QSharedPointer<Packets::Packet> &request)
+{
+    bool success = false;
+
+    // Downcast to derived class
+    const Packets::ClockEventRequestPacket *requestPacket =
+            dynamic_cast<const Packets::ClockEventRequestPacket *>(request.data());
+
+    if (requestPacket != nullptr)
+    {
+        // Use the server's time if the client didn't provide the timestamp
+        QDateTime timestamp = requestPacket->timestamp();
+
+        if (!timestamp.isValid())
+        {
+            timestamp = QDateTime::currentDateTimeUtc();
+        }
+
+        // Update the user's time tracker, only the user that is logged in with the client can be
+        // clocked in or out through it
+        bool accepted = false;
+        const qint64 clientUserId = m_clientUserIds.value(client, 0LL);
+        const QHash<qint64, TimeTracker>::iterator it =
+                m_timeTrackers.find(requestPacket->userId());
+
+        if ((clientUserId > 0LL) &&
+            (requestPacket->userId() == clientUserId) &&
+            (it != m_timeTrackers.end()))
+        {
+            switch (requestPacket->eventType())
+            {
+                case Event::Type_Started:
+                {
+                    accepted = it.value().startWorking(timestamp);
+                    break;
+                }
+
+                case Event::Type_OnBreak:
+                {
+                    accepted = it.value().startBreak(timestamp);
+                    break;
+                }
+
+                case Event::Type_FromBreak:
+                {
+                    accepted = it.value().endBreak(timestamp);
+                    break;
+                }
+
+                case Event::Type_Finished:
+                {
+                    accepted = it.value().stopWorking(timestamp);
+                    break;
+                }
+
+                case Event::Type_Invalid:
+                default:
+                {
+                    break;
+                }
+            }
+        }
+
+        if (accepted)
+        {
+            // Write the event to the database in the background
+            m_eventRecorder.addEvent(timestamp,
+                                     requestPacket->userId(),
+                                     requestPacket->eventType());
+
+            // Notify the subscribed clients about the status change
+            publishUserStatus(requestPacket->userId(),
+                              m_statusSubscribers.value(requestPacket->userId()));
+        }
+
+        // Send the response
+        Packets::ClockEventResponsePacket *responsePacket =
+                new Packets::ClockEventResponsePacket(requestPacket->eventType());
+        responsePacket->setId(PacketHandler::createPacketId());
+        responsePacket->setReferenceId(requestPacket->id());
+        responsePacket->setAccepted(accepted);
+        responsePacket->setTimestamp(timestamp);
+
+        success = sendResponse(client, QSharedPointer<Packets::Packet>(responsePacket));
+    }
+
+    return success;
+}
+
+bool Server::processSubscribeUserStatusRequest(Client *client,
+                                               const QSharedPointer<Packets::Packet> &request)
+{
+    bool success = false;
+
+    // Downcast to derived class
+    const Packets::SubscribeUserStatusRequestPacket *requestPacket =
+            dynamic_cast<const Packets::SubscribeUserStatusRequestPacket *>(request.data());
+
+    if (requestPacket != nullptr)
+    {
+        // Collect the selected users and the members of the selected user group (only for clients
+        // that are logged in)
+        QSet<qint64> userIds;
+        const bool accepted = m_clientUserIds.contains(client) &&
+                              selectUsers(requestPacket->userIds(),
+                                          requestPacket->userGroupId(),
+                                          &userIds);
+
+        // Replace the client's subscription
+        if (accepted)
+        {
+            unsubscribeUserStatus(client);
+
+            if (!userIds.isEmpty())
+            {
+                m_clientSubscriptions[client] = userIds;
+
+                foreach (const qint64 userId, userIds)
+                {
+                    m_statusSubscribers[userId].insert(client);
+                }
+            }
+        }
+
+        // Send the response
+        Packets::SubscribeUserStatusResponsePacket *responsePacket =
+                new Packets::SubscribeUserStatusResponsePacket();
+        responsePacket->setId(PacketHandler::createPacketId());
+        responsePacket->setReferenceId(requestPacket->id());
+        responsePacket->setAccepted(accepted);
+
+        success = sendResponse(client, QSharedPointer<Packets::Packet>(responsePacket));
+
+        // Send the current status of the subscribed users (it is queued after the response)
+        if (success && accepted)
+        {
+            QSet<Client *> clients;
+            clients.insert(client);
+
+            foreach (const qint64 userId, userIds)
+            {
+                publishUserStatus(userId, clients);
+            }
+        }
+    }
+
+    return success;
+}
+
+bool Server::processUserTotalsRequest(Client *client,
+                                      const QSharedPointer<Packets::Packet> &request)
+{
+    bool success = false;
+
+    // Downcast to derived class
+    const Packets::UserTotalsRequestPacket *requestPacket =
+            dynamic_cast<const Packets::UserTotalsRequestPacket *>(request.data());
+
+    if (requestPacket != nullptr)
+    {
+        // Use the server's time if the client didn't provide the timestamp
+        QDateTime timestamp = requestPacket->timestamp();
+
+        if (!timestamp.isValid())
+        {
+            timestamp = QDateTime::currentDateTimeUtc();
+        }
+
+        // Collect the selected users and the members of the selected user group (only for clients
+        // that are logged in)
+        QSet<qint64> userIds;
+        const bool accepted = m_clientUserIds.contains(client) &&
+                              selectUsers(requestPacket->userIds(),
+                                          requestPacket->userGroupId(),
+                                          &userIds);
+
+        // Calculate the totals of all selected users into a single response
+        Packets::UserTotalsResponsePacket *responsePacket =
+                new Packets::UserTotalsResponsePacket();
+        responsePacket->setId(PacketHandler::createPacketId());
+        responsePacket->setReferenceId(requestPacket->id());
+        responsePacket->setAccepted(accepted);
+        responsePacket->setTimestamp(timestamp);
+
+        if (accepted)
+        {
+            QList<qint64> sortedUserIds = userIds.toList();
+            qSort(sortedUserIds);
+
+            foreach (const qint64 userId, sortedUserIds)
+            {
+                const TimeTracker &timeTracker = m_timeTrackers[userId];
+
+                Packets::UserTotalsResponsePacket::UserTotals totals;
+                totals.userId = userId;
+                totals.workingTime = timeTracker.calculateWorkingTime(timestamp);
+                totals.breakTime = timeTracker.calculateBreakTime(timestamp);
+                totals.totalWorkingTime = timeTracker.calculateTotalWorkingTime(timestamp);
+
+                responsePacket->addTotals(totals);
+            }
+        }
+
+        // Send the response
+        success = sendResponse(client, QSharedPointer<Packets::Packet>(responsePacket));
+    }
+
+    return success;
+}
+
+bool Server::selectUsers(const QList<qint64> &userIds,
+                         const qint64 &userGroupId,
+                         QSet<qint64> *selectedUserIds) const
+{
+    bool success = true;
+
+    // Collect the selected users
+    foreach (const qint64 userId, userIds)
+    {
+        if (m_timeTrackers.contains(userId))
+        {
+            selectedUserIds->insert(userId);
+        }
+        else
+        {
+            // Error, unknown user
+            success = false;
+        }
+    }
+
+    // Collect the members of the selected user group
+    if (success && (userGroupId > 0LL))
+    {
+        success = m_userDirectory.containsUserGroup(userGroupId);
+
+        if (success)
+        {
+            foreach (const qint64 userId, m_userDirectory.userGroupMembers(userGroupId))
+            {
+                if (m_timeTrackers.contains(userId))
+                {
+                    selectedUserIds->insert(userId);
+                }
+            }
+        }
+    }
+
+    return success;
+}
+
+bool Server::processLoginRequest(Client *client, const QSharedPointer<Packets::Packet> &request)
+{
+    bool success = false;
+
+    // Downcast to derived class
+    const Packets::LoginRequestPacket *requestPacket =
+            dynamic_cast<const Packets::LoginRequestPacket *>(request.data());
+
+    if (requestPacket != nullptr)
+    {
+        // Verify the credentials and bind the client to the authenticated user
+        const qint64 userId = m_credentialCache.verify(requestPacket->userName(),
+                                                       requestPacket->password());
+        bool accepted = false;
+
+        if (userId > 0LL)
+        {
+            accepted = setClientUserId(client, userId);
+        }
+
+        // Send the response
+        Packets::LoginResponsePacket *responsePacket = new Packets::LoginResponsePacket();
+        responsePacket->setId(PacketHandler::createPacketId());
+        responsePacket->setReferenceId(requestPacket->id());
+        responsePacket->setAccepted(accepted);
+        responsePacket->setUserId(accepted ? userId : 0LL);
+
+        success = sendResponse(client, QSharedPointer<Packets::Packet>(responsePacket));
+    }
+
+    return success;
+}
+
+void Server::unsubscribeUserStatus(Client *client)
+{
+    foreach (const qint64 userId, m_clientSubscriptions.take(client))
+    {
+        QSet<Client *> &subscribers = m_statusSubscribers[userId];
+        subscribers.remove(client);
+
+        if (subscribers.isEmpty())
+        {
+            m_statusSubscribers.remove(userId);
+        }
+    }
+}
+
+void Server::publishUserStatus(const qint64 &userId, const QSet<Client *> &clients)
+{
+    const QHash<qint64, TimeTracker>::const_iterator it = m_timeTrackers.constFind(userId);
+
+    if ((!clients.isEmpty()) && (it != m_timeTrackers.constEnd()))
+    {
+        // Write the status packet only once for all clients
+        Packets::UserStatusPacket statusPacket;
+        statusPacket.setId(PacketHandler::createPacketId());
+        statusPacket.setUserId(userId);
+        statusPacket.setState(it.value().state());
+        statusPacket.setTimestamp(it.value().lastEventTimestamp());
+
+        const QByteArray packetData = m_packetHandler.toByteArray(statusPacket);
+
+        // Clients live in the I/O threads so the packet data is passed through their event queues
+        foreach (Client *client, clients)
+        {
+            QMetaObject::invokeMethod(client,
+                                      "pushPacketData",
+                                      Qt::QueuedConnection,
+                                      Q_ARG(QByteArray, packetData));
+        }
+    }
+}
+
+int Server::toIdleTimerTicks(const qint64 &time) const
+{
+    const qint64 interval = qMax(m_idleTimer.interval(), 1);
+
+    return static_cast<int>((time + interval - 1LL) / interval);
+}
+
+void Server::scheduleWorkdayTimer(const QDateTime &currentTime)
+{
+    // The working day can change right after the started working day ends (its end is still a part
+    // of it) or when the next working day starts
+    QDateTime changeTimestamp;
+    qint64 workingDayId = 0LL;
+    const QPair<QDateTime, QDateTime> workingDay =
+            m_workingDayCache.findWorkingDay(currentTime, &workingDayId);
+
+    if (workingDayId > 0LL)
+    {
+        changeTimestamp = workingDay.second.addMSecs(1LL);
+    }
+
+    const QDateTime nextWorkingDayStart = m_workingDayCache.nextWorkingDayStart(currentTime);
+
+    if (nextWorkingDayStart.isValid() &&
+        ((!changeTimestamp.isValid()) || (nextWorkingDayStart < changeTimestamp)))
+    {
+        changeTimestamp = nextWorkingDayStart;
+    }
+
+    if (changeTimestamp.isValid())
+    {
+        // Check at least once per hour so that changes of the system time are picked up
+        const qint64 interval = qBound(0LL, currentTime.msecsTo(changeTimestamp), 3600000LL);
+        m_workdayTimer.start(static_cast<int>(interval));
+    }
+    else
+    {
+        m_workdayTimer.stop();
+    }
+}
+
+void Server::scheduleWorkdayRefresh()
+{
+    if (!m_workdayRefreshScheduled)
+    {
+        m_workdayRefreshScheduled = true;
+        QMetaObject::invokeMethod(this, "refreshWorkday", Qt::QueuedConnection);
+    }
 }
 
 void Server::removeAllClients()
 {
-    // Delete all clients and remove them from the list
-    while (!m_clients.isEmpty())
+    // Delete all clients, disconnect all signals that are connecting this class and the clients,
+    // and delete the client objects
+    foreach (Client *client, m_clients)
     {
-        // Take the client from the list, disconnect all signals that are connecting this class and
-        // the client, and delete the client object
-        Client *client = m_clients.takeFirst();
         client->disconnect(this);
         client->deleteLater();
-    };
+    }
+
+    // Clear the registry
+    m_clients.clear();
+    m_idleTimerWheel.clear();
+    m_clientUserIds.clear();
+    m_userClients.clear();
+    m_statusSubscribers.clear();
+    m_clientSubscriptions.clear();
+}
+
+void Server::startIoThreads()
+{
+    // Make sure the old I/O threads are stopped
+    stopIoThreads();
+
+    if (m_ioThreadCount < 1)
+    {
+        // Handle all clients in the thread of the server
+        IoWorker *ioWorker = new IoWorker(this);
+        ioWorker->setKeepAliveInterval(m_keepAliveInterval);
+        ioWorker->setMaxFrameSize(m_maxFrameSize);
+        ioWorker->setMaxInputBufferSize(m_maxInputBufferSize);
+        ioWorker->setCompressionThreshold(m_compressionThreshold);
+
+        m_ioWorkers.append(ioWorker);
+    }
+    else
+    {
+        // Create the I/O workers and move each of them to its own thread
+        for (int i = 0; i < m_ioThreadCount; i++)
+        {
+            QThread *ioThread = new QThread(this);
+            IoWorker *ioWorker = new IoWorker();
+            ioWorker->setKeepAliveInterval(m_keepAliveInterval);
+            ioWorker->setMaxFrameSize(m_maxFrameSize);
+            ioWorker->setMaxInputBufferSize(m_maxInputBufferSize);
+            ioWorker->setCompressionThreshold(m_compressionThreshold);
+            ioWorker->moveToThread(ioThread);
+
+            // I/O worker (and all of its clients) is deleted in its own thread when it finishes
+            connect(ioThread, SIGNAL(finished()), ioWorker, SLOT(deleteLater()));
+
+            m_ioThreads.append(ioThread);
+            m_ioWorkers.append(ioWorker);
+        }
+    }
+
+    // Connect the I/O workers and start the I/O threads
+    foreach (IoWorker *ioWorker, m_ioWorkers)
+    {
+        connect(ioWorker, SIGNAL(clientAdded(Client*)), this, SLOT(addClient(Client*)));
+        connect(ioWorker, SIGNAL(clientDisconnected(Client*)), this, SLOT(removeClient(Client*)));
+        connect(ioWorker, SIGNAL(requestReceived(Client*,QSharedPointer<Packets::Packet>)),
+                this, SLOT(processRequest(Client*,QSharedPointer<Packets::Packet>)));
+    }
+
+    foreach (QThread *ioThread, m_ioThreads)
+    {
+        ioThread->start();
+    }
+}
+
+void Server::stopIoThreads()
+{
+    if (m_ioThreads.isEmpty())
+    {
+        // I/O workers live in the thread of the server, delete them directly
+        qDeleteAll(m_ioWorkers);
+    }
+    else
+    {
+        // Stop all I/O threads (I/O workers are deleted in their threads when they finish)
+        foreach (QThread *ioThread, m_ioThreads)
+        {
+            ioThread->quit();
+        }
+
+        foreach (QThread *ioThread, m_ioThreads)
+        {
+            ioThread->wait();
+            delete ioThread;
+        }
+    }
+
+    m_ioThreads.clear();
+    m_ioWorkers.clear();
+    m_nextIoWorker = 0;
+
+    // Deliver the queued notifications from the I/O workers that were not processed yet so that
+    // they can't be delivered after the server is started again. They can refer to clients that no
+    // longer exist, but none of them is dereferenced since the client registry and the I/O worker
+    // list are empty at this point. Other queued calls to the server are delivered as well.
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
 }
 
 void Server::readUsers()
 {
-    m_users = Database::UserManagement::readUsers();
-    //Database::UserManagement::readUserGroups();
-    //Database::UserManagement::readUserMappings();
+    m_userDirectory.load(Database::UserManagement::readUsers(),
+                         Database::UserManagement::readUserGroups(),
+                         Database::UserManagement::readUserMappings());
+
+    // Rebuild the credential cache
+    m_credentialCache.clear();
+
+    foreach (const User &user, m_userDirectory.users())
+    {
+        m_credentialCache.addUser(user);
+    }
+}
+
+void Server::readWorkingDays()
+{
+    m_workingDayCache.clear();
+
+    const QMap<qint64, QPair<QDateTime, QDateTime> > workingDays =
+            Database::ScheduleManagement::readWorkingDays();
+
+    for (QMap<qint64, QPair<QDateTime, QDateTime> >::const_iterator it = workingDays.constBegin();
+         it != workingDays.constEnd();
+         ++it)
+    {
+        m_workingDayCache.addWorkingDay(it.key(), it.value().first, it.value().second);
+    }
 }
 
 void Server::initializeTimeTrackers()
 {
     m_timeTrackers.clear();
 
-    foreach (const User &user, m_users)
+    foreach (const User &user, m_userDirectory.users())
     {
         TimeTracker timeTracker;
         timeTracker.setUserId(user.id());
 
-        m_timeTrackers.append(timeTracker);
+        m_timeTrackers.insert(user.id(), timeTracker);
     }
 }
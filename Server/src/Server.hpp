@@ -17,12 +17,28 @@
 #define OPENTIMETRACKER_SERVER_SERVER_HPP
 
 #include <QtCore/QObject>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
 #include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
 #include <QtCore/QScopedPointer>
-#include <QtNetwork/QTcpServer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include "Client.hpp"
+#include "CredentialCache.hpp"
+#include "EventRecorder.hpp"
+#include "IoWorker.hpp"
+#include "LatencyHistogram.hpp"
+#include "PacketHandler.hpp"
+#include "Packets/Packet.hpp"
+#include "ScheduleCache.hpp"
+#include "TcpServer.hpp"
 #include "TimeTracker.hpp"
-#include "User.hpp"
+#include "TimerWheel.hpp"
+#include "UserDirectory.hpp"
+#include "WorkingDayCache.hpp"
 
 namespace OpenTimeTracker
 {
@@ -31,6 +47,14 @@ namespace Server
 
 /*!
  * \brief   Central object for managing time tracking of all users
+ *
+ * Accepted connections are distributed over a pool of I/O threads. Each I/O thread runs its own
+ * event loop in which the sockets of its clients are read and written and in which the packets are
+ * parsed and written.
+ *
+ * The time trackers and the database connection are owned by the thread of the server. Clients
+ * must only reach them through queued signal/slot connections (i.e. through the event queue of the
+ * server's thread), never by direct calls.
  */
 class Server : public QObject
 {
@@ -72,11 +96,216 @@ public:
      */
     void stop();
 
+    /*!
+     * \brief   Gets the number of I/O threads
+     *
+     * \return  Number of I/O threads
+     */
+    int ioThreadCount() const;
+
+    /*!
+     * \brief   Sets the number of I/O threads
+     *
+     * \param   threadCount Number of I/O threads
+     *
+     * If the number of I/O threads is zero then all clients are handled in the thread of the
+     * server.
+     *
+     * \note    The new value is applied the next time the server is started
+     */
+    void setIoThreadCount(const int threadCount);
+
+    /*!
+     * \brief   Gets the idle timeout
+     *
+     * \return  Idle timeout (in milliseconds)
+     */
+    int idleTimeout() const;
+
+    /*!
+     * \brief   Sets the idle timeout
+     *
+     * \param   timeout Idle timeout (in milliseconds)
+     *
+     * Connection of a client that doesn't send any data for the idle timeout is closed. Closing of
+     * idle connections is disabled if the idle timeout is zero.
+     *
+     * \note    The new value is applied the next time the server is started
+     */
+    void setIdleTimeout(const int timeout);
+
+    /*!
+     * \brief   Gets the keep-alive interval
+     *
+     * \return  Keep-alive interval (in milliseconds)
+     */
+    int keepAliveInterval() const;
+
+    /*!
+     * \brief   Sets the keep-alive interval
+     *
+     * \param   interval    Keep-alive interval (in milliseconds)
+     *
+     * The server sends a "keep alive" request to each client in the specified interval and uses the
+     * responses to measure the round-trip times. Sending of "keep alive" requests is disabled if
+     * the interval is zero.
+     *
+     * \note    The new value is applied the next time the server is started
+     */
+    void setKeepAliveInterval(const int interval);
+
+    /*!
+     * \brief   Gets the maximum frame size
+     *
+     * \return  Maximum size of a packet received from a client (in bytes)
+     */
+    int maxFrameSize() const;
+
+    /*!
+     * \brief   Sets the maximum frame size
+     *
+     * \param   size    Maximum size of a packet received from a client (in bytes) or zero to not
+     *                  limit it
+     *
+     * Connection of a client that sends a larger packet is closed as soon as the limit is
+     * exceeded.
+     *
+     * \note    The new value is applied the next time the server is started
+     */
+    void setMaxFrameSize(const int size);
+
+    /*!
+     * \brief   Gets the maximum input buffer size
+     *
+     * \return  Maximum amount of data received from a client that is buffered (in bytes)
+     */
+    int maxInputBufferSize() const;
+
+    /*!
+     * \brief   Sets the maximum input buffer size
+     *
+     * \param   size    Maximum amount of data received from a client that is buffered (in bytes)
+     *                  or zero to not limit it
+     *
+     * \note    The new value is applied the next time the server is started
+     */
+    void setMaxInputBufferSize(const int size);
+
+    /*!
+     * \brief   Gets the compression threshold
+     *
+     * \return  Packet payload size (in bytes) above which the packets sent to the clients are
+     *          compressed
+     */
+    int compressionThreshold() const;
+
+    /*!
+     * \brief   Sets the compression threshold
+     *
+     * \param   size    Packet payload size (in bytes) above which the packets sent to the clients
+     *                  are compressed or zero to reject compression requests
+     *
+     * Packets are compressed only for the clients that requested compression.
+     *
+     * \note    The new value is applied the next time the server is started
+     */
+    void setCompressionThreshold(const int size);
+
+    /*!
+     * \brief   Gets the round-trip time histograms of the connected clients
+     *
+     * \return  Round-trip time histograms by peer address
+     *
+     * Histograms of all clients connected from the same address are merged.
+     */
+    QHash<QString, LatencyHistogram> roundTripHistograms() const;
+
+    /*!
+     * \brief   Gets the number of connected clients
+     *
+     * \return  Number of clients
+     */
+    int clientCount() const;
+
+    /*!
+     * \brief   Binds a client to an (authenticated) user
+     *
+     * \param   client  Client
+     * \param   userId  ID of the user or zero to unbind the client from its user
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * A user can be bound to multiple clients, but a client can only be bound to a single user.
+     */
+    bool setClientUserId(Client *client, const qint64 &userId);
+
+    /*!
+     * \brief   Gets the clients bound to the user
+     *
+     * \param   userId  ID of the user
+     *
+     * \return  Clients bound to the user
+     */
+    QList<Client *> clientsOfUser(const qint64 &userId) const;
+
+    /*!
+     * \brief   Sends packet data to all clients bound to the user
+     *
+     * \param   userId      ID of the user
+     * \param   packetData  Packet data
+     *
+     * \retval  true    Packet data was queued for sending to at least one client
+     * \retval  false   No client is bound to the user
+     */
+    bool sendToUser(const qint64 &userId, const QByteArray &packetData);
+
+    /*!
+     * \brief   Changes the user's password
+     *
+     * \param   userId      ID of the user
+     * \param   newPassword New password or an empty string to disable the user
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * The password is changed in the database. The user's cached credentials are then replaced by
+     * the database change notification so that the new password is used for all following logins.
+     */
+    bool changeUserPassword(const qint64 &userId, const QString &newPassword);
+
+    /*!
+     * \brief   Starts the workday of all time trackers
+     *
+     * \param   timestamp   Timestamp within the working day
+     *
+     * \retval  true    Success
+     * \retval  false   Error, no working day is defined for the timestamp
+     *
+     * The working day is looked up in the working day cache. The schedules of all users for the
+     * working day are read from the database with a single query the first time it is started and
+     * are served from the schedule cache afterwards. The recurring schedule templates are expanded
+     * only for this working day.
+     *
+     * The working and break times of all time trackers are reset. While the server is started the
+     * next working day is started automatically when the working day changes.
+     */
+    bool startWorkday(const QDateTime &timestamp);
+
 private slots:
+    /*!
+     * \brief   Hands over the accepted connection to one of the I/O workers
+     *
+     * \param   socketDescriptor    Socket descriptor of the accepted connection
+     */
+    void dispatchConnection(qintptr socketDescriptor);
+
     /*!
      * \brief   Adds a new client to the client list
+     *
+     * \param   client  Client that needs to be added
      */
-    void addNewClient();
+    void addClient(Client *client);
 
     /*!
      * \brief   Removes the specified client from the client list
@@ -85,22 +314,343 @@ private slots:
      */
     void removeClient(Client *client);
 
+    /*!
+     * \brief   Processes the request received by the client
+     *
+     * \param   client  Client that received the request
+     * \param   request Request packet
+     *
+     * The request is dispatched to the request handler that is registered for its packet type. The
+     * connection of the client is closed if there is no matching request handler or if the handler
+     * fails.
+     */
+    void processRequest(Client *client, QSharedPointer<Packets::Packet> request);
+
+    /*!
+     * \brief   Closes connections of the clients that were idle for too long
+     *
+     * This is executed on each tick of the idle timer and only checks the clients whose timeout in
+     * the idle timer wheel expired. Clients that received data in the meantime are rescheduled.
+     */
+    void checkIdleClients();
+
+    /*!
+     * \brief   Starts the working day that contains the current time if it is not started yet
+     *
+     * This is executed by the workday timer, which is then scheduled for the next time at which
+     * the working day can change.
+     */
+    void advanceWorkday();
+
+    /*!
+     * \brief   Applies the changed schedules of the started working day to the time trackers
+     *
+     * If the started working day was dropped from the schedule cache its schedules are read again
+     * and they replace the schedules of only those time trackers whose schedules changed. Their
+     * working and break times are kept.
+     */
+    void refreshWorkday();
+
+    /*!
+     * \brief   Applies the user that was added to the database
+     *
+     * \param   userId      ID of the user
+     * \param   name        Name of the user
+     * \param   password    Password of the user
+     *
+     * The user is added to the user directory and the credential cache and a time tracker is
+     * created for it. The time tracker's workday is started with the user's cached schedules of the
+     * started working day.
+     */
+    void applyUserAdded(const qint64 &userId, const QString &name, const QString &password);
+
+    /*!
+     * \brief   Applies the user's name that was changed in the database
+     *
+     * \param   userId  ID of the user
+     * \param   newName New name of the user
+     */
+    void applyUserNameChanged(const qint64 &userId, const QString &newName);
+
+    /*!
+     * \brief   Applies the user's password that was changed in the database
+     *
+     * \param   userId      ID of the user
+     * \param   newPassword New password of the user
+     */
+    void applyUserPasswordChanged(const qint64 &userId, const QString &newPassword);
+
+    /*!
+     * \brief   Applies the user group that was added to the database
+     *
+     * \param   userGroupId ID of the user group
+     * \param   name        Name of the user group
+     */
+    void applyUserGroupAdded(const qint64 &userGroupId, const QString &name);
+
+    /*!
+     * \brief   Applies the user group's name that was changed in the database
+     *
+     * \param   userGroupId ID of the user group
+     * \param   newName     New name of the user group
+     */
+    void applyUserGroupNameChanged(const qint64 &userGroupId, const QString &newName);
+
+    /*!
+     * \brief   Applies the user mapping that was added to the database
+     *
+     * \param   userMappingId   ID of the user mapping
+     * \param   userGroupId     ID of the user group
+     * \param   userId          ID of the user
+     */
+    void applyUserMappingAdded(const qint64 &userMappingId,
+                               const qint64 &userGroupId,
+                               const qint64 &userId);
+
+    /*!
+     * \brief   Applies the user mapping that was removed from the database
+     *
+     * \param   userMappingId   ID of the user mapping
+     */
+    void applyUserMappingRemoved(const qint64 &userMappingId);
+
+    /*!
+     * \brief   Applies the working day that was added to the database
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   startTimestamp  Start of the working day
+     * \param   endTimestamp    End of the working day
+     *
+     * The working day is added to the working day cache and it is started if it contains the
+     * current time.
+     */
+    void applyWorkingDayAdded(const qint64 &workingDayId,
+                              const QDateTime &startTimestamp,
+                              const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Applies the schedule that was added to the database
+     *
+     * \param   scheduleId      ID of the schedule
+     * \param   userId          ID of the user
+     * \param   startTimestamp  Start of the schedule
+     * \param   endTimestamp    End of the schedule
+     *
+     * The cached working days that overlap with the schedule are dropped and the changes are
+     * applied to the time trackers.
+     */
+    void applyScheduleAdded(const qint64 &scheduleId,
+                            const qint64 &userId,
+                            const QDateTime &startTimestamp,
+                            const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Applies the schedule that was removed from the database
+     *
+     * \param   scheduleId  ID of the schedule
+     *
+     * The cached working days that contain the schedule are dropped and the changes are applied to
+     * the time trackers.
+     */
+    void applyScheduleRemoved(const qint64 &scheduleId);
+
+    /*!
+     * \brief   Applies the schedule template that was changed in the database
+     *
+     * \param   scheduleTemplateId  ID of the schedule template
+     *
+     * All cached working days are dropped and the changes are applied to the time trackers.
+     */
+    void applyScheduleTemplateChanged(const qint64 &scheduleTemplateId);
+
 private:
+    /*!
+     * \brief   Request handler
+     *
+     * A request handler processes the request and sends the response with Server::sendResponse()
+     * either immediately or later when the response is ready. Meanwhile other requests of the same
+     * client can be processed and their responses can be sent.
+     *
+     * The request handler returns false if the request is invalid.
+     */
+    typedef bool (Server::*RequestHandler)(Client *client,
+                                           const QSharedPointer<Packets::Packet> &request);
+
+    /*!
+     * \brief   Registers the request handler for the packet type
+     *
+     * \param   packetType  Packet type of the request
+     * \param   handler     Request handler
+     */
+    void registerRequestHandler(const QString &packetType, RequestHandler handler);
+
+    /*!
+     * \brief   Sends the response to the client
+     *
+     * \param   client      Client that received the request
+     * \param   response    Response packet (its reference ID must be set to the request's ID)
+     *
+     * \retval  true    Response was queued for sending
+     * \retval  false   Client no longer exists
+     */
+    bool sendResponse(Client *client, const QSharedPointer<Packets::Packet> &response);
+
+    /*!
+     * \brief   Processes the clock event request (start/stop working and start/end break)
+     *
+     * \param   client  Client that received the request
+     * \param   request Request packet
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * The user's time tracker is updated immediately and the response is sent right away. The event
+     * is written to the database later by the event recorder.
+     *
+     * The request is rejected if the client is not logged in or if the request is for a different
+     * user than the one that is logged in with the client.
+     */
+    bool processClockEventRequest(Client *client, const QSharedPointer<Packets::Packet> &request);
+
+    /*!
+     * \brief   Processes the request for subscription to the user status changes
+     *
+     * \param   client  Client that received the request
+     * \param   request Request packet
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * The subscription replaces the client's previous subscription. If it is accepted the current
+     * status of each of the subscribed users is sent right after the response.
+     *
+     * The request is rejected if the client is not logged in.
+     */
+    bool processSubscribeUserStatusRequest(Client *client,
+                                           const QSharedPointer<Packets::Packet> &request);
+
+    /*!
+     * \brief   Processes the request for the totals of the selected users
+     *
+     * \param   client  Client that received the request
+     * \param   request Request packet
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * The totals are calculated from the in-memory time trackers and the totals of all selected
+     * users are sent in a single response.
+     *
+     * The request is rejected if the client is not logged in.
+     */
+    bool processUserTotalsRequest(Client *client, const QSharedPointer<Packets::Packet> &request);
+
+    /*!
+     * \brief   Selects the users and the members of the user group
+     *
+     * \param[in]   userIds         IDs of the users
+     * \param[in]   userGroupId     ID of the user group (zero if no user group is selected)
+     * \param[out]  selectedUserIds IDs of the selected users
+     *
+     * \retval  true    Success
+     * \retval  false   Error, unknown user or user group
+     */
+    bool selectUsers(const QList<qint64> &userIds,
+                     const qint64 &userGroupId,
+                     QSet<qint64> *selectedUserIds) const;
+
+    /*!
+     * \brief   Processes the login request
+     *
+     * \param   client  Client that received the request
+     * \param   request Request packet
+     *
+     * \retval  true    Success
+     * \retval  false   Error
+     *
+     * The credentials are verified against the credential cache. If they are valid the client is
+     * bound to the user.
+     */
+    bool processLoginRequest(Client *client, const QSharedPointer<Packets::Packet> &request);
+
+    /*!
+     * \brief   Cancels the client's subscription to the user status changes
+     *
+     * \param   client  Client
+     */
+    void unsubscribeUserStatus(Client *client);
+
+    /*!
+     * \brief   Sends the current status of the user to the subscribed clients
+     *
+     * \param   userId  ID of the user
+     * \param   clients Clients that shall receive the status
+     *
+     * The status packet is written only once and the same packet data is queued for sending to all
+     * of the clients.
+     */
+    void publishUserStatus(const qint64 &userId, const QSet<Client *> &clients);
+
+    /*!
+     * \brief   Converts the time to the number of idle timer ticks (rounded up)
+     *
+     * \param   time    Time (in milliseconds)
+     *
+     * \return  Number of ticks
+     */
+    int toIdleTimerTicks(const qint64 &time) const;
+
+    /*!
+     * \brief   Schedules the workday timer for the next time at which the working day can change
+     *
+     * \param   currentTime Current time
+     *
+     * The working day can change when the started working day ends or when the next working day
+     * starts. The timer is stopped if there is no such time.
+     */
+    void scheduleWorkdayTimer(const QDateTime &currentTime);
+
+    /*!
+     * \brief   Schedules refreshing of the started working day
+     *
+     * All changes made until then (e.g. schedules published in bulk) are applied with a single
+     * refresh.
+     */
+    void scheduleWorkdayRefresh();
+
     /*!
      * \brief   Removes all clients from the server
      */
     void removeAllClients();
 
+    /*!
+     * \brief   Creates the I/O workers and starts their threads
+     */
+    void startIoThreads();
+
+    /*!
+     * \brief   Stops the threads of the I/O workers and deletes the I/O workers
+     *
+     * \note    All clients that are still owned by the I/O workers are deleted
+     */
+    void stopIoThreads();
+
     /*!
      * \brief   Reads the user list from the database
      *
      * \retval  true    Success
      * \retval  false   Error
      *
-     * Clears the user list and reads all users from the database
+     * Reloads the user directory with all users, user groups and user mappings from the database.
+     * The credential cache is rebuilt from the read users.
      */
     void readUsers();
 
+    /*!
+     * \brief   Reads all working days from the database into the working day cache
+     */
+    void readWorkingDays();
+
     /*!
      * \brief   Initializes time trackers
      *
@@ -114,22 +664,148 @@ private:
     /*!
      * \brief   Holds the TCP server object
      */
-    QTcpServer *m_tcpServer;
+    TcpServer *m_tcpServer;
+
+    /*!
+     * \brief   Holds the number of I/O threads
+     */
+    int m_ioThreadCount;
+
+    /*!
+     * \brief   Holds the I/O threads
+     */
+    QList<QThread *> m_ioThreads;
+
+    /*!
+     * \brief   Holds the I/O workers
+     */
+    QList<IoWorker *> m_ioWorkers;
+
+    /*!
+     * \brief   Holds the index of the I/O worker that will get the next accepted connection
+     */
+    int m_nextIoWorker;
+
+    /*!
+     * \brief   Holds all connected clients
+     */
+    QSet<Client *> m_clients;
+
+    /*!
+     * \brief   Holds the ID of the user bound to each client (only for bound clients)
+     */
+    QHash<Client *, qint64> m_clientUserIds;
+
+    /*!
+     * \brief   Holds the clients bound to each user
+     */
+    QHash<qint64, QSet<Client *> > m_userClients;
+
+    /*!
+     * \brief   Holds the clients subscribed to the status changes of each user
+     */
+    QHash<qint64, QSet<Client *> > m_statusSubscribers;
+
+    /*!
+     * \brief   Holds the users whose status changes each client is subscribed to
+     */
+    QHash<Client *, QSet<qint64> > m_clientSubscriptions;
+
+    /*!
+     * \brief   Holds the packet handler for packets that are pushed to the clients
+     */
+    PacketHandler m_packetHandler;
+
+    /*!
+     * \brief   Holds the request handlers by packet type
+     */
+    QHash<QString, RequestHandler> m_requestHandlers;
+
+    /*!
+     * \brief   Holds the idle timeout (in milliseconds)
+     */
+    int m_idleTimeout;
+
+    /*!
+     * \brief   Holds the keep-alive interval (in milliseconds)
+     */
+    int m_keepAliveInterval;
+
+    /*!
+     * \brief   Holds the maximum size of a packet received from a client (in bytes)
+     */
+    int m_maxFrameSize;
+
+    /*!
+     * \brief   Holds the maximum amount of data received from a client that is buffered (in bytes)
+     */
+    int m_maxInputBufferSize;
+
+    /*!
+     * \brief   Holds the packet payload size (in bytes) above which the sent packets are compressed
+     */
+    int m_compressionThreshold;
+
+    /*!
+     * \brief   Holds the timer that advances the idle timer wheel
+     */
+    QTimer m_idleTimer;
+
+    /*!
+     * \brief   Holds the idle timer wheel with the time when each client has to be checked
+     */
+    TimerWheel m_idleTimerWheel;
+
+    /*!
+     * \brief   Holds the users, user groups and user mappings
+     */
+    UserDirectory m_userDirectory;
+
+    /*!
+     * \brief   Holds the cached credentials of all enabled users
+     */
+    CredentialCache m_credentialCache;
+
+    /*!
+     * \brief   Holds time trackers for all users in the database (by user ID)
+     */
+    QHash<qint64, TimeTracker> m_timeTrackers;
+
+    /*!
+     * \brief   Holds all working days for looking up the working day of a timestamp
+     */
+    WorkingDayCache m_workingDayCache;
+
+    /*!
+     * \brief   Holds the schedules of all users per working day
+     */
+    ScheduleCache m_scheduleCache;
+
+    /*!
+     * \brief   Holds the ID of the started working day (0 if no working day is started)
+     */
+    qint64 m_workingDayId;
+
+    /*!
+     * \brief   Holds the start and end of the started working day
+     */
+    QPair<QDateTime, QDateTime> m_workingDay;
 
     /*!
-     * \brief   Holds the client list
+     * \brief   Holds the timer that starts the next working day
      */
-    QList<Client *> m_clients;
+    QTimer m_workdayTimer;
 
     /*!
-     * \brief   Holds user list
+     * \brief   Holds the flag that indicates that refreshing of the started working day is
+     *          scheduled
      */
-    QList<User> m_users;
+    bool m_workdayRefreshScheduled;
 
     /*!
-     * \brief   Holds time trackers for all users in the database
+     * \brief   Holds the event recorder
      */
-    QList<TimeTracker> m_timeTrackers;
+    EventRecorder m_eventRecorder;
 };
 
 }
@@ -0,0 +1,319 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QThread>
+#include "Settings.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+Settings::Settings(QObject *parent)
+    : QObject(parent)
+{
+    for (int i = 0; i < Key_Count; i++)
+    {
+        m_values[i].storeRelease(defaultValue(static_cast<Key>(i)));
+    }
+}
+
+int Settings::value(const Key key) const
+{
+    int result = 0;
+
+    if ((key >= 0) && (key < Key_Count))
+    {
+        result = m_values[key].loadAcquire();
+    }
+
+    return result;
+}
+
+bool Settings::setValue(const Key key, const QVariant &newValue)
+{
+    bool success = false;
+
+    if ((key >= 0) && (key < Key_Count))
+    {
+        const int value = newValue.toInt(&success);
+
+        if (success)
+        {
+            success = isValid(key, value);
+        }
+
+        if (success && (m_values[key].loadAcquire() != value))
+        {
+            m_values[key].storeRelease(value);
+            emit valueChanged(name(key), value);
+        }
+    }
+
+    return success;
+}
+
+bool Settings::load(const QMap<QString, QVariant> &settings, QStringList *errors)
+{
+    bool success = true;
+
+    if (errors != nullptr)
+    {
+        errors->clear();
+    }
+
+    for (int i = 0; i < Key_Count; i++)
+    {
+        const Key key = static_cast<Key>(i);
+        const QString settingName = name(key);
+
+        if (!settings.contains(settingName))
+        {
+            // Setting is not defined, use the default value
+            setValue(key, defaultValue(key));
+        }
+        else if (!setValue(key, settings.value(settingName)))
+        {
+            // Error, invalid value
+            setValue(key, defaultValue(key));
+            success = false;
+
+            if (errors != nullptr)
+            {
+                errors->append(QString("Invalid value of setting \"%1\": %2")
+                               .arg(settingName, settings.value(settingName).toString()));
+            }
+        }
+        else
+        {
+            // Setting was loaded
+        }
+    }
+
+    return success;
+}
+
+quint16 Settings::port() const
+{
+    return static_cast<quint16>(value(Key_Port));
+}
+
+int Settings::ioThreadCount() const
+{
+    return value(Key_IoThreadCount);
+}
+
+int Settings::idleTimeout() const
+{
+    return value(Key_IdleTimeout);
+}
+
+int Settings::keepAliveInterval() const
+{
+    return value(Key_KeepAliveInterval);
+}
+
+int Settings::maxFrameSize() const
+{
+    return value(Key_MaxFrameSize);
+}
+
+int Settings::maxInputBufferSize() const
+{
+    return value(Key_MaxInputBufferSize);
+}
+
+int Settings::compressionThreshold() const
+{
+    return value(Key_CompressionThreshold);
+}
+
+Settings::Key Settings::key(const QString &name)
+{
+    Key result = Key_Count;
+
+    for (int i = 0; i < Key_Count; i++)
+    {
+        if (Settings::name(static_cast<Key>(i)) == name)
+        {
+            result = static_cast<Key>(i);
+            break;
+        }
+    }
+
+    return result;
+}
+
+QString Settings::name(const Key key)
+{
+    QString result;
+
+    switch (key)
+    {
+        case Key_Port:
+        {
+            result = QStringLiteral("port");
+            break;
+        }
+
+        case Key_IoThreadCount:
+        {
+            result = QStringLiteral("ioThreadCount");
+            break;
+        }
+
+        case Key_IdleTimeout:
+        {
+            result = QStringLiteral("idleTimeout");
+            break;
+        }
+
+        case Key_KeepAliveInterval:
+        {
+            result = QStringLiteral("keepAliveInterval");
+            break;
+        }
+
+        case Key_MaxFrameSize:
+        {
+            result = QStringLiteral("maxFrameSize");
+            break;
+        }
+
+        case Key_MaxInputBufferSize:
+        {
+            result = QStringLiteral("maxInputBufferSize");
+            break;
+        }
+
+        case Key_CompressionThreshold:
+        {
+            result = QStringLiteral("compressionThreshold");
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+int Settings::defaultValue(const Key key)
+{
+    int result = 0;
+
+    switch (key)
+    {
+        case Key_Port:
+        {
+            result = 61234;
+            break;
+        }
+
+        case Key_IoThreadCount:
+        {
+            result = QThread::idealThreadCount();
+            break;
+        }
+
+        case Key_IdleTimeout:
+        {
+            result = 120000;
+            break;
+        }
+
+        case Key_KeepAliveInterval:
+        {
+            result = 30000;
+            break;
+        }
+
+        case Key_MaxFrameSize:
+        {
+            result = 64 * 1024;
+            break;
+        }
+
+        case Key_MaxInputBufferSize:
+        {
+            result = 256 * 1024;
+            break;
+        }
+
+        case Key_CompressionThreshold:
+        {
+            result = 1024;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+bool Settings::isValid(const Key key, const int value)
+{
+    bool valid = false;
+
+    switch (key)
+    {
+        case Key_Port:
+        {
+            // Clients connect to a fixed port, so zero (any free port) is not allowed
+            valid = ((0 < value) && (value <= 65535));
+            break;
+        }
+
+        case Key_MaxFrameSize:
+        {
+            // Zero disables the limit, otherwise a frame has to be able to hold at least a small
+            // packet
+            valid = ((value == 0) || (value >= 1024));
+            break;
+        }
+
+        case Key_IoThreadCount:
+        case Key_IdleTimeout:
+        case Key_KeepAliveInterval:
+        case Key_MaxInputBufferSize:
+        case Key_CompressionThreshold:
+        {
+            // Zero disables the feature
+            valid = (value >= 0);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return valid;
+}
+
+void Settings::applySettingChanged(const QString &name, const QVariant &value)
+{
+    const Key settingKey = key(name);
+
+    if (settingKey != Key_Count)
+    {
+        setValue(settingKey, value);
+    }
+}
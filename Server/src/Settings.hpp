@@ -0,0 +1,228 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_SETTINGS_HPP
+#define OPENTIMETRACKER_SERVER_SETTINGS_HPP
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Typed registry of the server's settings
+ *
+ * Each setting is identified by a key and has a name (used in the database), a default value and a
+ * range of valid values. The settings are loaded once from the values read from the database and
+ * are then kept up to date with the settings changed in the database.
+ *
+ * The default values are the only source of the defaults, the server and its clients are
+ * initialized with them too. The server reads the settings only when it is configured at startup,
+ * so a setting changed in the database while the server is running is applied on the next start.
+ *
+ * The values are stored as atomic integers, so they can be read from any thread without locking
+ * and without converting variants. They are only written in the thread that owns the object.
+ */
+class Settings : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief   Enumerates the settings
+     */
+    enum Key
+    {
+        Key_Port,                   /*!< TCP port of the server (fixed, zero is not allowed) */
+        Key_IoThreadCount,          /*!< Number of I/O threads */
+        Key_IdleTimeout,            /*!< Idle timeout (in milliseconds) */
+        Key_KeepAliveInterval,      /*!< Keep-alive interval (in milliseconds) */
+        Key_MaxFrameSize,           /*!< Maximum frame size (in bytes) */
+        Key_MaxInputBufferSize,     /*!< Maximum size of buffered input data (in bytes) */
+        Key_CompressionThreshold,   /*!< Compression threshold (in bytes) */
+        Key_Count                   /*!< Number of settings (not a setting) */
+    };
+
+    /*!
+     * \brief   Constructor, all settings are set to their default values
+     *
+     * \param   parent  Pointer to the parent object
+     */
+    explicit Settings(QObject *parent = 0);
+
+    /*!
+     * \brief   Gets the value of a setting
+     *
+     * \param   key     Key of the setting
+     *
+     * \return  Value of the setting
+     *
+     * \note    This method can be called from any thread
+     */
+    int value(const Key key) const;
+
+    /*!
+     * \brief   Sets the value of a setting
+     *
+     * \param   key         Key of the setting
+     * \param   newValue    New value of the setting
+     *
+     * \retval  true    Success
+     * \retval  false   Error, the value is not valid for the setting
+     */
+    bool setValue(const Key key, const QVariant &newValue);
+
+    /*!
+     * \brief   Loads the settings
+     *
+     * \param       settings    Settings (by name), for example as read from the database
+     * \param[out]  errors      Optional output for the errors of the invalid settings
+     *
+     * \retval  true    Success
+     * \retval  false   Error, at least one of the settings is invalid
+     *
+     * Settings that are not in the map are set to their default values, invalid settings keep their
+     * default values and unknown settings are ignored.
+     */
+    bool load(const QMap<QString, QVariant> &settings, QStringList *errors = nullptr);
+
+    /*!
+     * \brief   Gets the TCP port of the server
+     *
+     * \return  TCP port
+     */
+    quint16 port() const;
+
+    /*!
+     * \brief   Gets the number of I/O threads
+     *
+     * \return  Number of I/O threads
+     */
+    int ioThreadCount() const;
+
+    /*!
+     * \brief   Gets the idle timeout
+     *
+     * \return  Idle timeout (in milliseconds)
+     */
+    int idleTimeout() const;
+
+    /*!
+     * \brief   Gets the keep-alive interval
+     *
+     * \return  Keep-alive interval (in milliseconds)
+     */
+    int keepAliveInterval() const;
+
+    /*!
+     * \brief   Gets the maximum frame size
+     *
+     * \return  Maximum frame size (in bytes), zero if the frame size is not limited
+     */
+    int maxFrameSize() const;
+
+    /*!
+     * \brief   Gets the maximum size of buffered input data
+     *
+     * \return  Maximum input buffer size (in bytes), zero if the buffered data is not limited
+     */
+    int maxInputBufferSize() const;
+
+    /*!
+     * \brief   Gets the compression threshold
+     *
+     * \return  Compression threshold (in bytes)
+     */
+    int compressionThreshold() const;
+
+    /*!
+     * \brief   Finds the key of a setting
+     *
+     * \param   name    Name of the setting
+     *
+     * \return  Key of the setting or Key_Count if there is no such setting
+     */
+    static Key key(const QString &name);
+
+    /*!
+     * \brief   Gets the name of a setting
+     *
+     * \param   key     Key of the setting
+     *
+     * \return  Name of the setting
+     */
+    static QString name(const Key key);
+
+    /*!
+     * \brief   Gets the default value of a setting
+     *
+     * \param   key     Key of the setting
+     *
+     * \return  Default value of the setting
+     */
+    static int defaultValue(const Key key);
+
+    /*!
+     * \brief   Checks if the value is valid for a setting
+     *
+     * \param   key     Key of the setting
+     * \param   value   Value
+     *
+     * \retval  true    Valid
+     * \retval  false   Invalid
+     */
+    static bool isValid(const Key key, const int value);
+
+public slots:
+    /*!
+     * \brief   Applies the setting that was changed in the database
+     *
+     * \param   name    Name of the setting
+     * \param   value   New value of the setting
+     *
+     * Unknown settings and invalid values are ignored.
+     */
+    void applySettingChanged(const QString &name, const QVariant &value);
+
+signals:
+    /*!
+     * \brief   Notification that the value of a setting was changed
+     *
+     * \param   name    Name of the setting
+     * \param   value   New value of the setting
+     *
+     * \note    The server isn't connected to this signal, since its settings can only be applied
+     *          when it is started (see the class description).
+     */
+    void valueChanged(const QString &name, const int value);
+
+private:
+    /*!
+     * \brief   Holds the values of the settings (by key)
+     */
+    QAtomicInt m_values[Key_Count];
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_SETTINGS_HPP
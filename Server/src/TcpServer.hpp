@@ -0,0 +1,67 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_TCPSERVER_HPP
+#define OPENTIMETRACKER_SERVER_TCPSERVER_HPP
+
+#include <QtNetwork/QTcpServer>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   TCP server that hands over the socket descriptors of the accepted connections
+ *
+ * Instead of creating a socket object for each accepted connection in the thread of the TCP server
+ * only the socket descriptor is passed on, so that the socket object can be created in the thread
+ * that will handle the connection.
+ */
+class TcpServer : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief   Constructor
+     *
+     * \param   parent  Pointer to the parent object
+     */
+    explicit TcpServer(QObject *parent = 0);
+
+signals:
+    /*!
+     * \brief   Notification that a new connection was accepted
+     *
+     * \param   socketDescriptor    Socket descriptor of the accepted connection
+     */
+    void newSocketDescriptor(qintptr socketDescriptor);
+
+protected:
+    /*!
+     * \brief   Handles a new connection
+     *
+     * \param   socketDescriptor    Socket descriptor of the accepted connection
+     *
+     * It just emits the TcpServer::newSocketDescriptor() signal
+     */
+    virtual void incomingConnection(qintptr socketDescriptor);
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_TCPSERVER_HPP
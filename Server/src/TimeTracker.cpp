@@ -175,6 +175,11 @@ TimeTracker::State TimeTracker::state() const
     return m_state;
 }
 
+QDateTime TimeTracker::lastEventTimestamp() const
+{
+    return m_lastEventTimestamp;
+}
+
 bool TimeTracker::startWorkday(const BreakTimeCalculator &breakTimeCalculator,
                                const QList<Schedule> &schedules)
 {
@@ -182,39 +187,8 @@ bool TimeTracker::startWorkday(const BreakTimeCalculator &breakTimeCalculator,
 
     if (breakTimeCalculator.isValid())
     {
-        success = true;
-        QDateTime endOfLastSchedule;
-
         // Verify schedules
-        foreach (const Schedule &schedule, schedules)
-        {
-            if ((!schedule.isValid()) || (schedule.userId() != m_userId))
-            {
-                // Invalid schedule
-                success = false;
-            }
-            else if (endOfLastSchedule.isNull())
-            {
-                // This is the first schedule checked, save its end timestamp
-                endOfLastSchedule = schedule.endTimestamp();
-            }
-            else if (endOfLastSchedule <= schedule.startTimestamp())
-            {
-                // This schedule comes after the last schedule, save its end timestamp
-                endOfLastSchedule = schedule.endTimestamp();
-            }
-            else
-            {
-                // Error, this schedule overlaps with the previous schedule
-                success = false;
-            }
-
-            // On failure exit the loop
-            if (!success)
-            {
-                break;
-            }
-        }
+        success = areSchedulesValid(schedules);
 
         // Start workday
         if (success)
@@ -233,6 +207,24 @@ bool TimeTracker::startWorkday(const BreakTimeCalculator &breakTimeCalculator,
     return success;
 }
 
+QList<Schedule> TimeTracker::schedules() const
+{
+    return m_schedules;
+}
+
+bool TimeTracker::changeSchedules(const QList<Schedule> &schedules)
+{
+    bool success = areSchedulesValid(schedules);
+
+    // Replace only the schedules, the tracked times are kept
+    if (success)
+    {
+        m_schedules = schedules;
+    }
+
+    return success;
+}
+
 bool TimeTracker::startWorking(const QDateTime &timestamp)
 {
     bool success = false;
@@ -326,6 +318,44 @@ bool TimeTracker::stopWorking(const QDateTime &timestamp)
     return success;
 }
 
+bool TimeTracker::areSchedulesValid(const QList<Schedule> &schedules) const
+{
+    bool success = true;
+    QDateTime endOfLastSchedule;
+
+    foreach (const Schedule &schedule, schedules)
+    {
+        if ((!schedule.isValid()) || (schedule.userId() != m_userId))
+        {
+            // Invalid schedule
+            success = false;
+        }
+        else if (endOfLastSchedule.isNull())
+        {
+            // This is the first schedule checked, save its end timestamp
+            endOfLastSchedule = schedule.endTimestamp();
+        }
+        else if (endOfLastSchedule <= schedule.startTimestamp())
+        {
+            // This schedule comes after the last schedule, save its end timestamp
+            endOfLastSchedule = schedule.endTimestamp();
+        }
+        else
+        {
+            // Error, this schedule overlaps with the previous schedule
+            success = false;
+        }
+
+        // On failure exit the loop
+        if (!success)
+        {
+            break;
+        }
+    }
+
+    return success;
+}
+
 qint32 TimeTracker::calculateScheduledTime(const QDateTime &startTimestamp,
                                            const QDateTime &endTimestamp) const
 {
@@ -119,6 +119,13 @@ public:
      */
     State state() const;
 
+    /*!
+     * \brief   Gets the timestamp of the last state change
+     *
+     * \return  Timestamp or an invalid timestamp if the state didn't change yet
+     */
+    QDateTime lastEventTimestamp() const;
+
     /*!
      * \brief   Starts the workday
      *
@@ -146,6 +153,26 @@ public:
     bool startWorkday(const BreakTimeCalculator &breakTimeCalculator,
                       const QList<Schedule> &schedules);
 
+    /*!
+     * \brief   Gets the schedules of the current workday
+     *
+     * \return  Schedules that define when the working time is tracked
+     */
+    QList<Schedule> schedules() const;
+
+    /*!
+     * \brief   Replaces the schedules of the current workday
+     *
+     * \param   schedules   List of schedules that define when the working time shall be tracked
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid or overlapping schedules (the schedules are not changed)
+     *
+     * Unlike startWorkday() this keeps the working and break times, state and timestamp of the last
+     * state change. It is intended for schedules that were changed during the workday.
+     */
+    bool changeSchedules(const QList<Schedule> &schedules);
+
     /*!
      * \brief   Starts tracking users working time
      *
@@ -195,6 +222,16 @@ public:
     bool stopWorking(const QDateTime &timestamp);
 
 private:
+    /*!
+     * \brief   Checks if the schedules are valid for the tracked user
+     *
+     * \param   schedules   List of schedules
+     *
+     * \retval  true    All schedules are valid, belong to the tracked user and don't overlap
+     * \retval  false   Invalid schedules
+     */
+    bool areSchedulesValid(const QList<Schedule> &schedules) const;
+
     /*!
      * \brief   Calculates scheduled time for the specified time period
      *
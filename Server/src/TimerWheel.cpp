@@ -0,0 +1,106 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TimerWheel.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+TimerWheel::TimerWheel(const int slotCount)
+    : m_slots(qMax(slotCount, 1)),
+      m_objectSlots(),
+      m_currentSlot(0)
+{
+}
+
+int TimerWheel::slotCount() const
+{
+    return m_slots.size();
+}
+
+int TimerWheel::size() const
+{
+    return m_objectSlots.size();
+}
+
+bool TimerWheel::contains(QObject *object) const
+{
+    return m_objectSlots.contains(object);
+}
+
+void TimerWheel::add(QObject *object, const int ticks)
+{
+    // Remove the old expiration
+    remove(object);
+
+    // Calculate the slot and the number of full rotations until the object expires
+    const int expirationTicks = qMax(ticks, 1);
+    const int slot = (m_currentSlot + expirationTicks) % m_slots.size();
+    const int rotations = (expirationTicks - 1) / m_slots.size();
+
+    m_slots[slot].insert(object, rotations);
+    m_objectSlots.insert(object, slot);
+}
+
+void TimerWheel::remove(QObject *object)
+{
+    const QHash<QObject *, int>::iterator it = m_objectSlots.find(object);
+
+    if (it != m_objectSlots.end())
+    {
+        m_slots[it.value()].remove(object);
+        m_objectSlots.erase(it);
+    }
+}
+
+void TimerWheel::clear()
+{
+    for (int i = 0; i < m_slots.size(); i++)
+    {
+        m_slots[i].clear();
+    }
+
+    m_objectSlots.clear();
+}
+
+QList<QObject *> TimerWheel::advance()
+{
+    QList<QObject *> expiredObjects;
+
+    // Move to the next slot
+    m_currentSlot = (m_currentSlot + 1) % m_slots.size();
+
+    // Check only the objects in the current slot
+    QHash<QObject *, int> &slot = m_slots[m_currentSlot];
+    QHash<QObject *, int>::iterator it = slot.begin();
+
+    while (it != slot.end())
+    {
+        if (it.value() < 1)
+        {
+            // Object expired
+            expiredObjects.append(it.key());
+            m_objectSlots.remove(it.key());
+            it = slot.erase(it);
+        }
+        else
+        {
+            // Object expires in one of the next rotations
+            it.value()--;
+            ++it;
+        }
+    }
+
+    return expiredObjects;
+}
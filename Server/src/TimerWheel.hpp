@@ -0,0 +1,127 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_TIMERWHEEL_HPP
+#define OPENTIMETRACKER_SERVER_TIMERWHEEL_HPP
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Hashed timer wheel for tracking timeouts of a large number of objects
+ *
+ * The wheel consists of a fixed number of slots. An object that needs to expire after N ticks is
+ * put into the slot that is N slots ahead of the current slot together with the number of full
+ * rotations of the wheel that have to pass before it expires.
+ *
+ * On each tick the wheel advances by one slot and only the objects in that slot are checked, so
+ * the cost of a tick does not depend on the total number of tracked objects. Adding and removing
+ * an object are constant time operations.
+ *
+ * \note    The wheel doesn't own the tracked objects
+ */
+class TimerWheel
+{
+public:
+    /*!
+     * \brief   Constructor
+     *
+     * \param   slotCount   Number of slots in the wheel
+     */
+    explicit TimerWheel(const int slotCount = 256);
+
+    /*!
+     * \brief   Gets the number of slots in the wheel
+     *
+     * \return  Number of slots
+     */
+    int slotCount() const;
+
+    /*!
+     * \brief   Gets the number of tracked objects
+     *
+     * \return  Number of tracked objects
+     */
+    int size() const;
+
+    /*!
+     * \brief   Checks if the object is tracked
+     *
+     * \param   object  Object
+     *
+     * \retval  true    Object is tracked
+     * \retval  false   Object is not tracked
+     */
+    bool contains(QObject *object) const;
+
+    /*!
+     * \brief   Starts tracking the object
+     *
+     * \param   object  Object
+     * \param   ticks   Number of ticks after which the object expires (at least one)
+     *
+     * If the object is already tracked its old expiration is replaced.
+     */
+    void add(QObject *object, const int ticks);
+
+    /*!
+     * \brief   Stops tracking the object
+     *
+     * \param   object  Object
+     */
+    void remove(QObject *object);
+
+    /*!
+     * \brief   Stops tracking all objects
+     */
+    void clear();
+
+    /*!
+     * \brief   Advances the wheel by a single tick
+     *
+     * \return  Objects that expired with this tick
+     *
+     * Expired objects are no longer tracked.
+     */
+    QList<QObject *> advance();
+
+private:
+    /*!
+     * \brief   Holds the slots with the tracked objects and their remaining rotations
+     */
+    QVector<QHash<QObject *, int> > m_slots;
+
+    /*!
+     * \brief   Holds the index of the slot of each tracked object
+     */
+    QHash<QObject *, int> m_objectSlots;
+
+    /*!
+     * \brief   Holds the index of the current slot
+     */
+    int m_currentSlot;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_TIMERWHEEL_HPP
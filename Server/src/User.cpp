@@ -14,32 +14,106 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "User.hpp"
+#include <QtCore/QSharedData>
 #include <cstdint>
 
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of a user
+ */
+class UserData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserData()
+        : QSharedData(),
+          m_id(0LL),
+          m_name(),
+          m_password()
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    UserData(const UserData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_name(other.m_name),
+          m_password(other.m_password)
+    {
+    }
+
+    /*!
+     * \brief   Holds the user's ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the user's name
+     */
+    QString m_name;
+
+    /*!
+     * \brief   Holds the user's password
+     */
+    QString m_password;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from users
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<UserData> &defaultData()
+{
+    static const QSharedDataPointer<UserData> data(new UserData());
+
+    return data;
+}
+
+}
+}
+
 using namespace OpenTimeTracker::Server;
 
 User::User()
-    : m_id(0LL),
-      m_name(),
-      m_password()
+    : m_data(defaultData())
 {
 }
 
 User::User(const User &other)
-    : m_id(other.m_id),
-      m_name(other.m_name),
-      m_password(other.m_password)
+    : m_data(other.m_data)
+{
+}
+
+User::User(User &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+User::~User()
 {
 }
 
 User &User::operator =(const User &other)
 {
-    if (this != &other)
-    {
-        m_id = other.m_id;
-        m_name = other.m_name;
-        m_password = other.m_password;
-    }
+    m_data = other.m_data;
+
+    return *this;
+}
+
+User &User::operator =(User &&other) noexcept
+{
+    m_data.swap(other.m_data);
 
     return *this;
 }
@@ -48,9 +122,9 @@ bool User::isValid() const
 {
     bool valid = true;
 
-    if ((m_id < 1LL) ||
-        m_name.isEmpty() ||
-        ((m_password.isNull() == false) && m_password.isEmpty()))
+    if ((m_data->m_id < 1LL) ||
+        m_data->m_name.isEmpty() ||
+        ((m_data->m_password.isNull() == false) && m_data->m_password.isEmpty()))
     {
         valid = false;
     }
@@ -60,32 +134,32 @@ bool User::isValid() const
 
 qint64 User::id() const
 {
-    return m_id;
+    return m_data->m_id;
 }
 
 void User::setId(const qint64 &newId)
 {
-    m_id = newId;
+    m_data->m_id = newId;
 }
 
 QString User::name() const
 {
-    return m_name;
+    return m_data->m_name;
 }
 
 void User::setName(const QString &newName)
 {
-    m_name = newName;
+    m_data->m_name = newName;
 }
 
 QString User::password() const
 {
-    return m_password;
+    return m_data->m_password;
 }
 
 void User::setPassword(const QString &newPassword)
 {
-    m_password = newPassword;
+    m_data->m_password = newPassword;
 }
 
 User User::fromMap(const QMap<QString, QVariant> &map)
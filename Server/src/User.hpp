@@ -17,6 +17,7 @@
 #define OPENTIMETRACKER_SERVER_USER_HPP
 
 #include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
@@ -25,6 +26,8 @@ namespace OpenTimeTracker
 namespace Server
 {
 
+class UserData;
+
 /*!
  * \brief   Holds user's information
  */
@@ -42,6 +45,20 @@ public:
      */
     User(const User &other);
 
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    User(User &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~User();
+
     /*!
      * \brief   operator =
      * \param   other   Object to be copied
@@ -50,6 +67,14 @@ public:
      */
     User &operator =(const User &other);
 
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    User &operator =(User &&other) noexcept;
+
     /*!
      * \brief   Checks if object is valid
      *
@@ -114,22 +139,14 @@ public:
 
 private:
     /*!
-     * \brief   Holds the user's ID
-     */
-    qint64 m_id;
-
-    /*!
-     * \brief   Holds the user's name
+     * \brief   Holds the user's data, which is implicitly shared between the copies
      */
-    QString m_name;
-
-    /*!
-     * \brief   Holds the user's password
-     */
-    QString m_password;
+    QSharedDataPointer<UserData> m_data;
 };
 
 }
 }
 
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::User, Q_MOVABLE_TYPE);
+
 #endif // OPENTIMETRACKER_SERVER_USER_HPP
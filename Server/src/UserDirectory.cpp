@@ -0,0 +1,284 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QtAlgorithms>
+#include "UserDirectory.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+UserDirectory::UserDirectory()
+    : m_users(),
+      m_userIds(),
+      m_userGroups(),
+      m_userMappings(),
+      m_userGroupMembers(),
+      m_userGroupsOfUser(),
+      m_groupMembership()
+{
+}
+
+void UserDirectory::clear()
+{
+    m_users.clear();
+    m_userIds.clear();
+    m_userGroups.clear();
+    m_userMappings.clear();
+    m_userGroupMembers.clear();
+    m_userGroupsOfUser.clear();
+    m_groupMembership.clear();
+}
+
+void UserDirectory::load(const QList<User> &users,
+                         const QList<UserGroup> &userGroups,
+                         const QList<UserMapping> &userMappings)
+{
+    clear();
+
+    m_users.reserve(users.size());
+    m_userIds.reserve(users.size());
+    m_userGroups.reserve(userGroups.size());
+    m_userMappings.reserve(userMappings.size());
+
+    foreach (const User &user, users)
+    {
+        addUser(user);
+    }
+
+    foreach (const UserGroup &userGroup, userGroups)
+    {
+        addUserGroup(userGroup);
+    }
+
+    // User mappings are added last so that they can be checked against the users and user groups
+    foreach (const UserMapping &userMapping, userMappings)
+    {
+        addUserMapping(userMapping);
+    }
+}
+
+int UserDirectory::userCount() const
+{
+    return m_users.size();
+}
+
+QList<User> UserDirectory::users() const
+{
+    QList<qint64> userIds = m_users.keys();
+    qSort(userIds);
+
+    QList<User> users;
+    users.reserve(userIds.size());
+
+    foreach (const qint64 userId, userIds)
+    {
+        users.append(m_users.value(userId));
+    }
+
+    return users;
+}
+
+bool UserDirectory::containsUser(const qint64 &userId) const
+{
+    return m_users.contains(userId);
+}
+
+User UserDirectory::user(const qint64 &userId) const
+{
+    return m_users.value(userId);
+}
+
+User UserDirectory::userByName(const QString &name) const
+{
+    return m_users.value(m_userIds.value(name, 0LL));
+}
+
+QList<UserGroup> UserDirectory::userGroups() const
+{
+    QList<qint64> userGroupIds = m_userGroups.keys();
+    qSort(userGroupIds);
+
+    QList<UserGroup> userGroups;
+    userGroups.reserve(userGroupIds.size());
+
+    foreach (const qint64 userGroupId, userGroupIds)
+    {
+        userGroups.append(m_userGroups.value(userGroupId));
+    }
+
+    return userGroups;
+}
+
+bool UserDirectory::containsUserGroup(const qint64 &userGroupId) const
+{
+    return m_userGroups.contains(userGroupId);
+}
+
+UserGroup UserDirectory::userGroup(const qint64 &userGroupId) const
+{
+    return m_userGroups.value(userGroupId);
+}
+
+QVector<qint64> UserDirectory::userGroupMembers(const qint64 &userGroupId) const
+{
+    return m_userGroupMembers.value(userGroupId);
+}
+
+QVector<qint64> UserDirectory::userGroupsOfUser(const qint64 &userId) const
+{
+    return m_userGroupsOfUser.value(userId);
+}
+
+const GroupMembership &UserDirectory::groupMembership() const
+{
+    return m_groupMembership;
+}
+
+bool UserDirectory::addUser(const User &user)
+{
+    bool success = false;
+
+    if (user.isValid() && (!m_users.contains(user.id())) && (!m_userIds.contains(user.name())))
+    {
+        m_users.insert(user.id(), user);
+        m_userIds.insert(user.name(), user.id());
+        m_groupMembership.addUser(user.id());
+        success = true;
+    }
+
+    return success;
+}
+
+bool UserDirectory::changeUserName(const qint64 &userId, const QString &newName)
+{
+    bool success = false;
+    const QHash<qint64, User>::iterator it = m_users.find(userId);
+
+    if ((it != m_users.end()) && (!newName.isEmpty()))
+    {
+        const qint64 otherUserId = m_userIds.value(newName, 0LL);
+
+        if ((otherUserId == 0LL) || (otherUserId == userId))
+        {
+            // Re-index the user under the new name
+            m_userIds.remove(it.value().name());
+            m_userIds.insert(newName, userId);
+            it.value().setName(newName);
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+bool UserDirectory::changeUserPassword(const qint64 &userId, const QString &newPassword)
+{
+    bool success = false;
+    const QHash<qint64, User>::iterator it = m_users.find(userId);
+
+    if (it != m_users.end())
+    {
+        it.value().setPassword(newPassword);
+        success = true;
+    }
+
+    return success;
+}
+
+bool UserDirectory::addUserGroup(const UserGroup &userGroup)
+{
+    bool success = false;
+
+    if (userGroup.isValid() && (!m_userGroups.contains(userGroup.id())))
+    {
+        m_userGroups.insert(userGroup.id(), userGroup);
+        success = true;
+    }
+
+    return success;
+}
+
+bool UserDirectory::changeUserGroupName(const qint64 &userGroupId, const QString &newName)
+{
+    bool success = false;
+    const QHash<qint64, UserGroup>::iterator it = m_userGroups.find(userGroupId);
+
+    if ((it != m_userGroups.end()) && (!newName.isEmpty()))
+    {
+        it.value().setName(newName);
+        success = true;
+    }
+
+    return success;
+}
+
+bool UserDirectory::addUserMapping(const UserMapping &userMapping)
+{
+    bool success = false;
+
+    if (userMapping.isValid() &&
+        (!m_userMappings.contains(userMapping.id())) &&
+        m_users.contains(userMapping.userId()) &&
+        m_userGroups.contains(userMapping.userGroupId()))
+    {
+        QVector<qint64> &members = m_userGroupMembers[userMapping.userGroupId()];
+
+        if (!members.contains(userMapping.userId()))
+        {
+            members.append(userMapping.userId());
+            m_userGroupsOfUser[userMapping.userId()].append(userMapping.userGroupId());
+            m_userMappings.insert(userMapping.id(), userMapping);
+            m_groupMembership.addMember(userMapping.userGroupId(), userMapping.userId());
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+bool UserDirectory::removeUserMapping(const qint64 &userMappingId)
+{
+    bool success = false;
+    const QHash<qint64, UserMapping>::iterator it = m_userMappings.find(userMappingId);
+
+    if (it != m_userMappings.end())
+    {
+        const qint64 userGroupId = it.value().userGroupId();
+        const qint64 userId = it.value().userId();
+
+        // Remove the user from the members of the user group
+        QVector<qint64> &members = m_userGroupMembers[userGroupId];
+        members.remove(members.indexOf(userId));
+
+        if (members.isEmpty())
+        {
+            m_userGroupMembers.remove(userGroupId);
+        }
+
+        // Remove the user group from the user's groups
+        QVector<qint64> &userGroups = m_userGroupsOfUser[userId];
+        userGroups.remove(userGroups.indexOf(userGroupId));
+
+        if (userGroups.isEmpty())
+        {
+            m_userGroupsOfUser.remove(userId);
+        }
+
+        m_groupMembership.removeMember(userGroupId, userId);
+        m_userMappings.erase(it);
+        success = true;
+    }
+
+    return success;
+}
@@ -0,0 +1,278 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_USERDIRECTORY_HPP
+#define OPENTIMETRACKER_SERVER_USERDIRECTORY_HPP
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include "GroupMembership.hpp"
+#include "User.hpp"
+#include "UserGroup.hpp"
+#include "UserMapping.hpp"
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   In-memory directory of the users, user groups and user mappings
+ *
+ * Users are indexed both by ID and by name and user groups are indexed by ID. User mappings are
+ * additionally kept as adjacency arrays (members of each user group and user groups of each user)
+ * so that none of the lookups needs a linear scan. For queries that combine several user groups the
+ * memberships are also kept as bitsets (see GroupMembership).
+ *
+ * The directory doesn't access the database. After a change is written to the database the same
+ * change must be applied to the directory to keep it coherent with the database.
+ */
+class UserDirectory
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserDirectory();
+
+    /*!
+     * \brief   Removes all users, user groups and user mappings from the directory
+     */
+    void clear();
+
+    /*!
+     * \brief   Replaces the contents of the directory
+     *
+     * \param   users           Users
+     * \param   userGroups      User groups
+     * \param   userMappings    User mappings
+     *
+     * Invalid items, items with duplicate IDs or names and user mappings that reference unknown
+     * users or user groups are skipped.
+     */
+    void load(const QList<User> &users,
+              const QList<UserGroup> &userGroups,
+              const QList<UserMapping> &userMappings);
+
+    /*!
+     * \brief   Gets the number of users in the directory
+     *
+     * \return  Number of users
+     */
+    int userCount() const;
+
+    /*!
+     * \brief   Gets all users
+     *
+     * \return  Users sorted by ID
+     */
+    QList<User> users() const;
+
+    /*!
+     * \brief   Checks if the directory contains the user
+     *
+     * \param   userId  ID of the user
+     *
+     * \retval  true    User was found
+     * \retval  false   User was not found
+     */
+    bool containsUser(const qint64 &userId) const;
+
+    /*!
+     * \brief   Gets the user by its ID
+     *
+     * \param   userId  ID of the user
+     *
+     * \return  User or an invalid user if it was not found
+     */
+    User user(const qint64 &userId) const;
+
+    /*!
+     * \brief   Gets the user by its name
+     *
+     * \param   name    Name of the user
+     *
+     * \return  User or an invalid user if it was not found
+     */
+    User userByName(const QString &name) const;
+
+    /*!
+     * \brief   Gets all user groups
+     *
+     * \return  User groups sorted by ID
+     */
+    QList<UserGroup> userGroups() const;
+
+    /*!
+     * \brief   Checks if the directory contains the user group
+     *
+     * \param   userGroupId ID of the user group
+     *
+     * \retval  true    User group was found
+     * \retval  false   User group was not found
+     */
+    bool containsUserGroup(const qint64 &userGroupId) const;
+
+    /*!
+     * \brief   Gets the user group by its ID
+     *
+     * \param   userGroupId ID of the user group
+     *
+     * \return  User group or an invalid user group if it was not found
+     */
+    UserGroup userGroup(const qint64 &userGroupId) const;
+
+    /*!
+     * \brief   Gets the members of the user group
+     *
+     * \param   userGroupId ID of the user group
+     *
+     * \return  IDs of the users in the user group
+     */
+    QVector<qint64> userGroupMembers(const qint64 &userGroupId) const;
+
+    /*!
+     * \brief   Gets the user groups of the user
+     *
+     * \param   userId  ID of the user
+     *
+     * \return  IDs of the user groups that the user is a member of
+     */
+    QVector<qint64> userGroupsOfUser(const qint64 &userId) const;
+
+    /*!
+     * \brief   Gets the membership of the users in the user groups
+     *
+     * \return  Group membership
+     */
+    const GroupMembership &groupMembership() const;
+
+    /*!
+     * \brief   Adds the user to the directory
+     *
+     * \param   user    User
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid user or its ID or name is already used
+     */
+    bool addUser(const User &user);
+
+    /*!
+     * \brief   Changes the user's name
+     *
+     * \param   userId  ID of the user
+     * \param   newName New name of the user
+     *
+     * \retval  true    Success
+     * \retval  false   Error, unknown user or the name is already used by another user
+     */
+    bool changeUserName(const qint64 &userId, const QString &newName);
+
+    /*!
+     * \brief   Changes the user's password
+     *
+     * \param   userId      ID of the user
+     * \param   newPassword New password of the user
+     *
+     * \retval  true    Success
+     * \retval  false   Error, unknown user
+     */
+    bool changeUserPassword(const qint64 &userId, const QString &newPassword);
+
+    /*!
+     * \brief   Adds the user group to the directory
+     *
+     * \param   userGroup   User group
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid user group or its ID is already used
+     */
+    bool addUserGroup(const UserGroup &userGroup);
+
+    /*!
+     * \brief   Changes the user group's name
+     *
+     * \param   userGroupId ID of the user group
+     * \param   newName     New name of the user group
+     *
+     * \retval  true    Success
+     * \retval  false   Error, unknown user group or empty name
+     */
+    bool changeUserGroupName(const qint64 &userGroupId, const QString &newName);
+
+    /*!
+     * \brief   Adds the user mapping to the directory
+     *
+     * \param   userMapping User mapping
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid user mapping, its ID is already used, it references an
+     *                  unknown user or user group or the user is already a member of the group
+     */
+    bool addUserMapping(const UserMapping &userMapping);
+
+    /*!
+     * \brief   Removes the user mapping from the directory
+     *
+     * \param   userMappingId   ID of the user mapping
+     *
+     * \retval  true    Success
+     * \retval  false   Error, unknown user mapping
+     */
+    bool removeUserMapping(const qint64 &userMappingId);
+
+private:
+    /*!
+     * \brief   Holds the users by ID
+     */
+    QHash<qint64, User> m_users;
+
+    /*!
+     * \brief   Holds the user IDs by user name
+     */
+    QHash<QString, qint64> m_userIds;
+
+    /*!
+     * \brief   Holds the user groups by ID
+     */
+    QHash<qint64, UserGroup> m_userGroups;
+
+    /*!
+     * \brief   Holds the user mappings by ID
+     */
+    QHash<qint64, UserMapping> m_userMappings;
+
+    /*!
+     * \brief   Holds the IDs of the members of each user group (by user group ID)
+     */
+    QHash<qint64, QVector<qint64> > m_userGroupMembers;
+
+    /*!
+     * \brief   Holds the IDs of the user groups of each user (by user ID)
+     */
+    QHash<qint64, QVector<qint64> > m_userGroupsOfUser;
+
+    /*!
+     * \brief   Holds the membership of the users in the user groups as bitsets
+     */
+    GroupMembership m_groupMembership;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_USERDIRECTORY_HPP
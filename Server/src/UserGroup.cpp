@@ -14,28 +14,98 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "UserGroup.hpp"
+#include <QtCore/QSharedData>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of a user group
+ */
+class UserGroupData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserGroupData()
+        : QSharedData(),
+          m_id(0LL),
+          m_name()
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    UserGroupData(const UserGroupData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_name(other.m_name)
+    {
+    }
+
+    /*!
+     * \brief   Holds the user group's ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the user group's name
+     */
+    QString m_name;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from user groups
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<UserGroupData> &defaultData()
+{
+    static const QSharedDataPointer<UserGroupData> data(new UserGroupData());
+
+    return data;
+}
+
+}
+}
 
 using namespace OpenTimeTracker::Server;
 
 UserGroup::UserGroup()
-    : m_id(0LL),
-      m_name()
+    : m_data(defaultData())
 {
 }
 
 UserGroup::UserGroup(const UserGroup &other)
-    : m_id(other.m_id),
-      m_name(other.m_name)
+    : m_data(other.m_data)
+{
+}
+
+UserGroup::UserGroup(UserGroup &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+UserGroup::~UserGroup()
 {
 }
 
 UserGroup &UserGroup::operator =(const UserGroup &other)
 {
-    if (this != &other)
-    {
-        m_id = other.m_id;
-        m_name = other.m_name;
-    }
+    m_data = other.m_data;
+
+    return *this;
+}
+
+UserGroup &UserGroup::operator =(UserGroup &&other) noexcept
+{
+    m_data.swap(other.m_data);
 
     return *this;
 }
@@ -44,7 +114,7 @@ bool UserGroup::isValid() const
 {
     bool valid = true;
 
-    if ((m_id < 1LL) || m_name.isEmpty())
+    if ((m_data->m_id < 1LL) || m_data->m_name.isEmpty())
     {
         valid = false;
     }
@@ -54,22 +124,22 @@ bool UserGroup::isValid() const
 
 qint64 UserGroup::id() const
 {
-    return m_id;
+    return m_data->m_id;
 }
 
 void UserGroup::setId(const qint64 &newId)
 {
-    m_id = newId;
+    m_data->m_id = newId;
 }
 
 QString UserGroup::name() const
 {
-    return m_name;
+    return m_data->m_name;
 }
 
 void UserGroup::setName(const QString &newName)
 {
-    m_name = newName;
+    m_data->m_name = newName;
 }
 
 UserGroup UserGroup::fromMap(const QMap<QString, QVariant> &map)
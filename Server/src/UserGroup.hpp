@@ -17,6 +17,7 @@
 #define OPENTIMETRACKER_SERVER_USERGROUP_HPP
 
 #include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
@@ -25,6 +26,8 @@ namespace OpenTimeTracker
 namespace Server
 {
 
+class UserGroupData;
+
 /*!
  * \brief   Holds user group's information
  */
@@ -42,6 +45,20 @@ public:
      */
     UserGroup(const UserGroup &other);
 
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    UserGroup(UserGroup &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~UserGroup();
+
     /*!
      * \brief   operator =
      * \param   other   Object to be copied
@@ -50,6 +67,14 @@ public:
      */
     UserGroup &operator =(const UserGroup &other);
 
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    UserGroup &operator =(UserGroup &&other) noexcept;
+
     /*!
      * \brief   Checks if object is valid
      *
@@ -100,17 +125,14 @@ public:
 
 private:
     /*!
-     * \brief   Holds the user group's ID
+     * \brief   Holds the user group's data, which is implicitly shared between the copies
      */
-    qint64 m_id;
-
-    /*!
-     * \brief   Holds the user group's name
-     */
-    QString m_name;
+    QSharedDataPointer<UserGroupData> m_data;
 };
 
 }
 }
 
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::UserGroup, Q_MOVABLE_TYPE);
+
 #endif // OPENTIMETRACKER_SERVER_USERGROUP_HPP
@@ -14,31 +14,105 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "UserMapping.hpp"
+#include <QtCore/QSharedData>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the data of a user mapping
+ */
+class UserMappingData : public QSharedData
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserMappingData()
+        : QSharedData(),
+          m_id(0LL),
+          m_userGroupId(0LL),
+          m_userId(0LL)
+    {
+    }
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    UserMappingData(const UserMappingData &other)
+        : QSharedData(other),
+          m_id(other.m_id),
+          m_userGroupId(other.m_userGroupId),
+          m_userId(other.m_userId)
+    {
+    }
+
+    /*!
+     * \brief   Holds the user mapping ID
+     */
+    qint64 m_id;
+
+    /*!
+     * \brief   Holds the user group ID
+     */
+    qint64 m_userGroupId;
+
+    /*!
+     * \brief   Holds the user ID
+     */
+    qint64 m_userId;
+};
+
+/*!
+ * \brief   Gets the data of the default constructed and moved-from user mappings
+ *
+ * \return  Shared data, created on first use and never deleted
+ */
+static const QSharedDataPointer<UserMappingData> &defaultData()
+{
+    static const QSharedDataPointer<UserMappingData> data(new UserMappingData());
+
+    return data;
+}
+
+}
+}
 
 using namespace OpenTimeTracker::Server;
 
 UserMapping::UserMapping()
-    : m_id(0LL),
-      m_userGroupId(0LL),
-      m_userId(0LL)
+    : m_data(defaultData())
 {
 }
 
 UserMapping::UserMapping(const UserMapping &other)
-    : m_id(other.m_id),
-      m_userGroupId(other.m_userGroupId),
-      m_userId(other.m_userId)
+    : m_data(other.m_data)
+{
+}
+
+UserMapping::UserMapping(UserMapping &&other) noexcept
+    : m_data(defaultData())
+{
+    m_data.swap(other.m_data);
+}
+
+UserMapping::~UserMapping()
 {
 }
 
 UserMapping &UserMapping::operator =(const UserMapping &other)
 {
-    if (this != &other)
-    {
-        m_id = other.m_id;
-        m_userGroupId = other.m_userGroupId;
-        m_userId = other.m_userId;
-    }
+    m_data = other.m_data;
+
+    return *this;
+}
+
+UserMapping &UserMapping::operator =(UserMapping &&other) noexcept
+{
+    m_data.swap(other.m_data);
 
     return *this;
 }
@@ -47,7 +121,7 @@ bool UserMapping::isValid() const
 {
     bool valid = true;
 
-    if ((m_id < 1LL) || (m_userGroupId < 1LL) || (m_userId < 1LL))
+    if ((m_data->m_id < 1LL) || (m_data->m_userGroupId < 1LL) || (m_data->m_userId < 1LL))
     {
         valid = false;
     }
@@ -57,32 +131,32 @@ bool UserMapping::isValid() const
 
 qint64 UserMapping::id() const
 {
-    return m_id;
+    return m_data->m_id;
 }
 
 void UserMapping::setId(const qint64 &newId)
 {
-    m_id = newId;
+    m_data->m_id = newId;
 }
 
 qint64 UserMapping::userGroupId() const
 {
-    return m_userGroupId;
+    return m_data->m_userGroupId;
 }
 
 void UserMapping::setUserGroupId(const qint64 &newUserGroupId)
 {
-    m_userGroupId = newUserGroupId;
+    m_data->m_userGroupId = newUserGroupId;
 }
 
 qint64 UserMapping::userId() const
 {
-    return m_userId;
+    return m_data->m_userId;
 }
 
 void UserMapping::setUserId(const qint64 &newUserId)
 {
-    m_userId = newUserId;
+    m_data->m_userId = newUserId;
 }
 
 UserMapping UserMapping::fromMap(const QMap<QString, QVariant> &map)
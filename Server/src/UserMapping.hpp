@@ -17,6 +17,7 @@
 #define OPENTIMETRACKER_SERVER_USERMAPPING_HPP
 
 #include <QtCore/QMap>
+#include <QtCore/QSharedDataPointer>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 
@@ -25,6 +26,8 @@ namespace OpenTimeTracker
 namespace Server
 {
 
+class UserMappingData;
+
 /*!
  * \brief   Holds information for mapping users to user groups
  */
@@ -42,6 +45,20 @@ public:
      */
     UserMapping(const UserMapping &other);
 
+    /*!
+     * \brief   Move constructor
+     * \param   other   Object to be moved
+     *
+     * \note    The moved-from object is left with default (invalid) values, which are shared by
+     *          all such objects so that moving doesn't allocate
+     */
+    UserMapping(UserMapping &&other) noexcept;
+
+    /*!
+     * \brief   Destructor
+     */
+    ~UserMapping();
+
     /*!
      * \brief   operator =
      * \param   other   Object to be copied
@@ -50,6 +67,14 @@ public:
      */
     UserMapping &operator =(const UserMapping &other);
 
+    /*!
+     * \brief   Move assignment operator
+     * \param   other   Object to be moved
+     *
+     * \return  Reference to the this object
+     */
+    UserMapping &operator =(UserMapping &&other) noexcept;
+
     /*!
      * \brief   Checks if object is valid
      *
@@ -114,22 +139,14 @@ public:
 
 private:
     /*!
-     * \brief   Holds the user mapping ID
-     */
-    qint64 m_id;
-
-    /*!
-     * \brief   Holds the user group ID
+     * \brief   Holds the user mapping's data, which is implicitly shared between the copies
      */
-    qint64 m_userGroupId;
-
-    /*!
-     * \brief   Holds the user ID
-     */
-    qint64 m_userId;
+    QSharedDataPointer<UserMappingData> m_data;
 };
 
 }
 }
 
+Q_DECLARE_TYPEINFO(OpenTimeTracker::Server::UserMapping, Q_MOVABLE_TYPE);
+
 #endif // OPENTIMETRACKER_SERVER_USERMAPPING_HPP
@@ -0,0 +1,186 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtCore/QtAlgorithms>
+#include "UserSet.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+UserSet::UserSet()
+    : m_words()
+{
+}
+
+UserSet::UserSet(const UserSet &other)
+    : m_words(other.m_words)
+{
+}
+
+UserSet &UserSet::operator =(const UserSet &other)
+{
+    if (this != &other)
+    {
+        m_words = other.m_words;
+    }
+
+    return *this;
+}
+
+bool UserSet::isEmpty() const
+{
+    bool empty = true;
+    const quint64 *words = m_words.constData();
+    const int wordCount = m_words.size();
+
+    for (int i = 0; i < wordCount; i++)
+    {
+        if (words[i] != 0ULL)
+        {
+            empty = false;
+            break;
+        }
+    }
+
+    return empty;
+}
+
+int UserSet::count() const
+{
+    int slotCount = 0;
+    const quint64 *words = m_words.constData();
+    const int wordCount = m_words.size();
+
+    for (int i = 0; i < wordCount; i++)
+    {
+        slotCount += static_cast<int>(qPopulationCount(words[i]));
+    }
+
+    return slotCount;
+}
+
+bool UserSet::contains(const int slot) const
+{
+    bool found = false;
+
+    if ((slot >= 0) && ((slot / 64) < m_words.size()))
+    {
+        found = ((m_words.at(slot / 64) & (1ULL << (slot % 64))) != 0ULL);
+    }
+
+    return found;
+}
+
+void UserSet::insert(const int slot)
+{
+    if (slot >= 0)
+    {
+        // Grow the set to cover the slot
+        if ((slot / 64) >= m_words.size())
+        {
+            m_words.resize((slot / 64) + 1);
+        }
+
+        m_words[slot / 64] |= (1ULL << (slot % 64));
+    }
+}
+
+void UserSet::remove(const int slot)
+{
+    if ((slot >= 0) && ((slot / 64) < m_words.size()))
+    {
+        m_words[slot / 64] &= ~(1ULL << (slot % 64));
+    }
+}
+
+void UserSet::clear()
+{
+    m_words.clear();
+}
+
+QVector<int> UserSet::toSlotList() const
+{
+    QVector<int> slotList;
+    slotList.reserve(count());
+
+    for (int i = 0; i < m_words.size(); i++)
+    {
+        quint64 word = m_words.at(i);
+
+        while (word != 0ULL)
+        {
+            // Position of the lowest set bit equals the number of the zero bits below it
+            const quint64 lowestBit = word & (~word + 1ULL);
+            const int bit = static_cast<int>(qPopulationCount(lowestBit - 1ULL));
+
+            slotList.append((i * 64) + bit);
+            word &= ~lowestBit;
+        }
+    }
+
+    return slotList;
+}
+
+UserSet &UserSet::unite(const UserSet &other)
+{
+    if (m_words.size() < other.m_words.size())
+    {
+        m_words.resize(other.m_words.size());
+    }
+
+    quint64 *words = m_words.data();
+    const quint64 *otherWords = other.m_words.constData();
+    const int wordCount = other.m_words.size();
+
+    for (int i = 0; i < wordCount; i++)
+    {
+        words[i] |= otherWords[i];
+    }
+
+    return *this;
+}
+
+UserSet &UserSet::intersect(const UserSet &other)
+{
+    // Slots beyond the end of the other set can't be in the intersection
+    if (m_words.size() > other.m_words.size())
+    {
+        m_words.resize(other.m_words.size());
+    }
+
+    quint64 *words = m_words.data();
+    const quint64 *otherWords = other.m_words.constData();
+    const int wordCount = m_words.size();
+
+    for (int i = 0; i < wordCount; i++)
+    {
+        words[i] &= otherWords[i];
+    }
+
+    return *this;
+}
+
+UserSet &UserSet::subtract(const UserSet &other)
+{
+    quint64 *words = m_words.data();
+    const quint64 *otherWords = other.m_words.constData();
+    const int wordCount = qMin(m_words.size(), other.m_words.size());
+
+    for (int i = 0; i < wordCount; i++)
+    {
+        words[i] &= ~otherWords[i];
+    }
+
+    return *this;
+}
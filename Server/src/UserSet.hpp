@@ -0,0 +1,143 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_USERSET_HPP
+#define OPENTIMETRACKER_SERVER_USERSET_HPP
+
+#include <QtCore/QVector>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Dense bitset of user slots
+ *
+ * Each user is represented by a slot index (see GroupMembership) and each slot by a single bit.
+ * The bits are stored in 64-bit words so that the set operations and counting are simple loops
+ * over the words which the compiler can vectorize.
+ */
+class UserSet
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    UserSet();
+
+    /*!
+     * \brief   Copy constructor
+     * \param   other   Object to be copied
+     */
+    UserSet(const UserSet &other);
+
+    /*!
+     * \brief   operator =
+     * \param   other   Object to be copied
+     *
+     * \return  Reference to the this object
+     */
+    UserSet &operator =(const UserSet &other);
+
+    /*!
+     * \brief   Checks if the set is empty
+     *
+     * \retval  true    Empty
+     * \retval  false   Not empty
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief   Gets the number of slots in the set
+     *
+     * \return  Number of slots
+     */
+    int count() const;
+
+    /*!
+     * \brief   Checks if the slot is in the set
+     *
+     * \param   slot    Slot index
+     *
+     * \retval  true    Slot is in the set
+     * \retval  false   Slot is not in the set
+     */
+    bool contains(const int slot) const;
+
+    /*!
+     * \brief   Adds the slot to the set
+     *
+     * \param   slot    Slot index
+     */
+    void insert(const int slot);
+
+    /*!
+     * \brief   Removes the slot from the set
+     *
+     * \param   slot    Slot index
+     */
+    void remove(const int slot);
+
+    /*!
+     * \brief   Removes all slots from the set
+     */
+    void clear();
+
+    /*!
+     * \brief   Gets the slots in the set
+     *
+     * \return  Slot indexes in ascending order
+     */
+    QVector<int> toSlotList() const;
+
+    /*!
+     * \brief   Adds all slots of the other set to this set (union)
+     *
+     * \param   other   Other set
+     *
+     * \return  Reference to this set
+     */
+    UserSet &unite(const UserSet &other);
+
+    /*!
+     * \brief   Removes all slots that are not in the other set from this set (intersection)
+     *
+     * \param   other   Other set
+     *
+     * \return  Reference to this set
+     */
+    UserSet &intersect(const UserSet &other);
+
+    /*!
+     * \brief   Removes all slots of the other set from this set (difference)
+     *
+     * \param   other   Other set
+     *
+     * \return  Reference to this set
+     */
+    UserSet &subtract(const UserSet &other);
+
+private:
+    /*!
+     * \brief   Holds the bits of the slots, bit N of word W represents the slot (W * 64 + N)
+     */
+    QVector<quint64> m_words;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_USERSET_HPP
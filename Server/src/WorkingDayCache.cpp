@@ -0,0 +1,149 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WorkingDayCache.hpp"
+
+using namespace OpenTimeTracker::Server;
+
+WorkingDayCache::WorkingDayCache()
+    : m_startTimestamps(),
+      m_endTimestamps(),
+      m_maxEndTimestamps(),
+      m_workingDayIds()
+{
+}
+
+void WorkingDayCache::clear()
+{
+    m_startTimestamps.clear();
+    m_endTimestamps.clear();
+    m_maxEndTimestamps.clear();
+    m_workingDayIds.clear();
+}
+
+int WorkingDayCache::size() const
+{
+    return m_workingDayIds.size();
+}
+
+bool WorkingDayCache::addWorkingDay(const qint64 &workingDayId,
+                                    const QDateTime &startTimestamp,
+                                    const QDateTime &endTimestamp)
+{
+    bool success = false;
+
+    if ((workingDayId > 0LL) &&
+        startTimestamp.isValid() &&
+        endTimestamp.isValid() &&
+        (startTimestamp < endTimestamp))
+    {
+        // Insert the working day so that the working days stay sorted by their start
+        const qint64 start = startTimestamp.toMSecsSinceEpoch();
+        const qint64 end = endTimestamp.toMSecsSinceEpoch();
+        const int index = upperBound(start);
+
+        m_startTimestamps.insert(index, start);
+        m_endTimestamps.insert(index, end);
+        m_maxEndTimestamps.insert(index, end);
+        m_workingDayIds.insert(index, workingDayId);
+
+        // Update the latest ends from the inserted working day on
+        for (int i = qMax(index, 1); i < m_maxEndTimestamps.size(); i++)
+        {
+            m_maxEndTimestamps[i] = qMax(m_endTimestamps.at(i), m_maxEndTimestamps.at(i - 1));
+        }
+
+        success = true;
+    }
+
+    return success;
+}
+
+QPair<QDateTime, QDateTime> WorkingDayCache::findWorkingDay(const QDateTime &timestamp,
+                                                            qint64 *workingDayId) const
+{
+    QPair<QDateTime, QDateTime> workingDay;
+    int found = -1;
+
+    if (timestamp.isValid())
+    {
+        const qint64 time = timestamp.toMSecsSinceEpoch();
+
+        // Check the working days that start at or before the timestamp, starting with the last one,
+        // for as long as one of them can still contain the timestamp
+        for (int i = upperBound(time) - 1; (i >= 0) && (time <= m_maxEndTimestamps.at(i)); i--)
+        {
+            if ((time <= m_endTimestamps.at(i)) &&
+                ((found < 0) || (m_workingDayIds.at(i) > m_workingDayIds.at(found))))
+            {
+                found = i;
+            }
+        }
+    }
+
+    if (found >= 0)
+    {
+        workingDay.first = QDateTime::fromMSecsSinceEpoch(m_startTimestamps.at(found), Qt::UTC);
+        workingDay.second = QDateTime::fromMSecsSinceEpoch(m_endTimestamps.at(found), Qt::UTC);
+    }
+
+    // Optionally get the working day's ID
+    if (workingDayId != nullptr)
+    {
+        *workingDayId = (found >= 0) ? m_workingDayIds.at(found) : 0LL;
+    }
+
+    return workingDay;
+}
+
+QDateTime WorkingDayCache::nextWorkingDayStart(const QDateTime &timestamp) const
+{
+    QDateTime startTimestamp;
+
+    if (timestamp.isValid())
+    {
+        const int index = upperBound(timestamp.toMSecsSinceEpoch());
+
+        if (index < m_startTimestamps.size())
+        {
+            startTimestamp = QDateTime::fromMSecsSinceEpoch(m_startTimestamps.at(index), Qt::UTC);
+        }
+    }
+
+    return startTimestamp;
+}
+
+int WorkingDayCache::upperBound(const qint64 timestamp) const
+{
+    int first = 0;
+    int count = m_startTimestamps.size();
+
+    while (count > 0)
+    {
+        const int step = count / 2;
+
+        if (m_startTimestamps.at(first + step) <= timestamp)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
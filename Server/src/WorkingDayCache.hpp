@@ -0,0 +1,136 @@
+/* Copyright 2015  Djuro Drljaca <djurodrljaca@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPENTIMETRACKER_SERVER_WORKINGDAYCACHE_HPP
+#define OPENTIMETRACKER_SERVER_WORKINGDAYCACHE_HPP
+
+#include <QtCore/QDateTime>
+#include <QtCore/QPair>
+#include <QtCore/QVector>
+
+namespace OpenTimeTracker
+{
+namespace Server
+{
+
+/*!
+ * \brief   Holds the working days for looking up the working day of a timestamp
+ *
+ * The working days are kept in arrays sorted by their start, so the working day of a timestamp is
+ * found with a binary search instead of a database query. Working days may overlap, in which case
+ * the most recently added working day (with the highest ID) is used, same as in the database.
+ *
+ * \warning The lookup is O(log n) only while the working days don't overlap much. After the binary
+ *          search the working days that start before the timestamp are checked backwards for as
+ *          long as the latest end among them still reaches the timestamp. A single long or
+ *          overlapping working day therefore makes the lookup of every timestamp before its end
+ *          scan back to it (O(n) in the worst case). Overlapping working days aren't rejected
+ *          because the database allows them.
+ *
+ * Timestamps are stored as milliseconds since the epoch and returned in UTC.
+ */
+class WorkingDayCache
+{
+public:
+    /*!
+     * \brief   Constructor
+     */
+    WorkingDayCache();
+
+    /*!
+     * \brief   Removes all working days from the cache
+     */
+    void clear();
+
+    /*!
+     * \brief   Gets the number of working days in the cache
+     *
+     * \return  Number of working days
+     */
+    int size() const;
+
+    /*!
+     * \brief   Adds a working day to the cache
+     *
+     * \param   workingDayId    ID of the working day
+     * \param   startTimestamp  Start of the working day
+     * \param   endTimestamp    End of the working day
+     *
+     * \retval  true    Success
+     * \retval  false   Error, invalid working day
+     */
+    bool addWorkingDay(const qint64 &workingDayId,
+                       const QDateTime &startTimestamp,
+                       const QDateTime &endTimestamp);
+
+    /*!
+     * \brief   Finds the working day that contains the timestamp
+     *
+     * \param       timestamp       Timestamp
+     * \param[out]  workingDayId    Optional output for the ID of the working day (0 if not found)
+     *
+     * \return  Start and end of the working day or invalid timestamps if it was not found
+     *
+     * \note    See the class description for the cost of overlapping working days.
+     */
+    QPair<QDateTime, QDateTime> findWorkingDay(const QDateTime &timestamp,
+                                               qint64 *workingDayId = nullptr) const;
+
+    /*!
+     * \brief   Finds the start of the first working day that starts after the timestamp
+     *
+     * \param   timestamp   Timestamp
+     *
+     * \return  Start of the working day or an invalid timestamp if there is no such working day
+     */
+    QDateTime nextWorkingDayStart(const QDateTime &timestamp) const;
+
+private:
+    /*!
+     * \brief   Finds the position of the first working day that starts after the timestamp
+     *
+     * \param   timestamp   Timestamp (milliseconds since the epoch)
+     *
+     * \return  Index of the working day or number of working days if there is no such working day
+     */
+    int upperBound(const qint64 timestamp) const;
+
+    /*!
+     * \brief   Holds the start of each working day (sorted)
+     */
+    QVector<qint64> m_startTimestamps;
+
+    /*!
+     * \brief   Holds the end of each working day
+     */
+    QVector<qint64> m_endTimestamps;
+
+    /*!
+     * \brief   Holds the latest end of all working days up to and including each working day
+     *
+     * This limits the search for overlapping working days that start before the timestamp.
+     */
+    QVector<qint64> m_maxEndTimestamps;
+
+    /*!
+     * \brief   Holds the ID of each working day
+     */
+    QVector<qint64> m_workingDayIds;
+};
+
+}
+}
+
+#endif // OPENTIMETRACKER_SERVER_WORKINGDAYCACHE_HPP
@@ -13,11 +13,16 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QtDebug>
+#include "Database/ChangeNotifier.hpp"
 #include "Database/DatabaseManagement.hpp"
 #include "Database/SettingsManagement.hpp"
+#include "Database/UserManagement.hpp"
+#include "Roster.hpp"
 #include "Server.hpp"
+#include "Settings.hpp"
 
 int main(int argc, char *argv[])
 {
@@ -25,6 +30,17 @@ int main(int argc, char *argv[])
 
     QCoreApplication app(argc, argv);
 
+    // Parse command line
+    QCommandLineParser parser;
+    parser.addHelpOption();
+
+    const QCommandLineOption importOption(
+                "import",
+                "Imports the users and user groups from the roster file (CSV or JSON) and exits.",
+                "file");
+    parser.addOption(importOption);
+    parser.process(app);
+
     Server server(&app);
 
     // Open database
@@ -39,38 +55,100 @@ int main(int argc, char *argv[])
         success = true;
     }
 
-    // Read connection settings
-    QMap<QString, QVariant> settings;
-
-    if (success)
+    // Import the roster instead of starting the server (optional command line mode)
+    if (parser.isSet(importOption))
     {
-        settings = Database::SettingsManagement::readSettings();
+        int exitCode = 1;
 
-        // Add default settings to the database if necessary
-        if (settings.isEmpty())
+        if (success)
         {
-            settings["port"] = 61234U;
+            bool valid = false;
+            const Roster roster = Roster::fromFile(parser.value(importOption), &valid);
+
+            if (valid)
+            {
+                QStringList rowErrors;
+
+                if (Database::UserManagement::importRoster(roster, &rowErrors))
+                {
+                    exitCode = 0;
 
-            success = Database::SettingsManagement::addSettings(settings);
+                    // Report the skipped entries
+                    for (int i = 0; i < rowErrors.size(); i++)
+                    {
+                        if (!rowErrors.at(i).isEmpty())
+                        {
+                            qWarning() << "Skipped roster entry" << (i + 1)
+                                       << roster.entries().at(i).userName << ":" << rowErrors.at(i);
+                            exitCode = 2;
+                        }
+                    }
+                }
+                else
+                {
+                    qWarning() << "Failed to import the roster";
+                }
+            }
+            else
+            {
+                qWarning() << "Failed to read the roster file" << parser.value(importOption);
+            }
         }
+
+        return exitCode;
     }
 
-    // Start server
+    // Read settings
+    Settings settings;
+
     if (success)
     {
-        success = false;
+        const QMap<QString, QVariant> storedSettings =
+                Database::SettingsManagement::readSettings();
 
-        if (settings.contains("port"))
+        if (storedSettings.isEmpty())
         {
-            const quint32 valuePort = settings["port"].toUInt(&success);
+            // Add default settings to the database
+            QMap<QString, QVariant> defaultSettings;
+            defaultSettings[Settings::name(Settings::Key_Port)] = settings.port();
 
-            if (success && (valuePort <= UINT16_MAX))
+            success = Database::SettingsManagement::addSettings(defaultSettings);
+        }
+        else
+        {
+            // Invalid settings are replaced by their default values
+            QStringList errors;
+
+            if (!settings.load(storedSettings, &errors))
             {
-                const quint16 port = static_cast<quint16>(valuePort);
-                success = server.start(port);
+                foreach (const QString &error, errors)
+                {
+                    qWarning() << error;
+                }
             }
         }
     }
 
+    // Keep the settings up to date with the changes written to the database
+    QObject::connect(Database::ChangeNotifier::instance(), SIGNAL(settingChanged(QString,QVariant)),
+                     &settings, SLOT(applySettingChanged(QString,QVariant)));
+
+    // Configure the server (settings changed while the server is running apply on the next start)
+    if (success)
+    {
+        server.setIoThreadCount(settings.ioThreadCount());
+        server.setIdleTimeout(settings.idleTimeout());
+        server.setKeepAliveInterval(settings.keepAliveInterval());
+        server.setMaxFrameSize(settings.maxFrameSize());
+        server.setMaxInputBufferSize(settings.maxInputBufferSize());
+        server.setCompressionThreshold(settings.compressionThreshold());
+    }
+
+    // Start server
+    if (success)
+    {
+        success = server.start(settings.port());
+    }
+
     return app.exec();
 }
@@ -16,6 +16,7 @@ CONFIG -= app_bundle
 TEMPLATE = app
 
 HEADERS += \
+    ../../src/Database/ChangeNotifier.hpp \
     ../../src/Database/DatabaseManagement.hpp \
     ../../src/Database/EventManagement.hpp \
     ../../src/Database/ScheduleManagement.hpp \
@@ -23,13 +24,17 @@ HEADERS += \
     ../../src/Database/UserManagement.hpp \
     ../../src/Event.hpp \
     ../../src/EventChangeLogItem.hpp \
+    ../../src/Roster.hpp \
     ../../src/Schedule.hpp \
+    ../../src/ScheduleIndex.hpp \
+    ../../src/ScheduleTemplate.hpp \
     ../../src/User.hpp \
     ../../src/UserGroup.hpp \
     ../../src/UserMapping.hpp
 
 SOURCES += \
     tst_DatabaseTest.cpp \
+    ../../src/Database/ChangeNotifier.cpp \
     ../../src/Database/DatabaseManagement.cpp \
     ../../src/Database/EventManagement.cpp \
     ../../src/Database/ScheduleManagement.cpp \
@@ -37,7 +42,10 @@ SOURCES += \
     ../../src/Database/UserManagement.cpp \
     ../../src/Event.cpp \
     ../../src/EventChangeLogItem.cpp \
+    ../../src/Roster.cpp \
     ../../src/Schedule.cpp \
+    ../../src/ScheduleIndex.cpp \
+    ../../src/ScheduleTemplate.cpp \
     ../../src/User.cpp \
     ../../src/UserGroup.cpp \
     ../../src/UserMapping.cpp
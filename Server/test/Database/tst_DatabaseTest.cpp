@@ -16,6 +16,7 @@
 #include <QString>
 #include <QtTest>
 #include <QFile>
+#include "../../src/Database/ChangeNotifier.hpp"
 #include "../../src/Database/DatabaseManagement.hpp"
 #include "../../src/Database/EventManagement.hpp"
 #include "../../src/Database/ScheduleManagement.hpp"
@@ -40,6 +41,7 @@ private Q_SLOTS:
     void testCaseConnect();
     void testCaseDisconnect();
     void testCaseReconnect();
+    void testCaseUpgrade();
 
     // Settings unit tests
     void testCaseReadSettingsEmptyDatabase();
@@ -118,6 +120,24 @@ private Q_SLOTS:
     void testCaseChangeEventEnableStateFail();
     void testCaseReadEventChangeLogChangedEvent();
 
+    // Change notification unit tests
+    void testCaseChangeNotification();
+    void testCaseChangeNotificationTransaction();
+
+    // Import unit tests
+    void testCaseRosterFromCsv();
+    void testCaseRosterFromJson();
+    void testCaseImportRoster();
+
+    // Schedule publishing unit tests
+    void testCasePublishSchedules();
+
+    // Schedule template unit tests
+    void testCaseScheduleTemplates();
+
+    // Event benchmarks
+    void testCaseBenchmarkReadEvents();
+
 private:
     void removeDatabaseFile();
     OpenTimeTracker::Server::User readUser(const qint64 &userId);
@@ -283,6 +303,47 @@ void DatabaseTest::testCaseReconnect()
     QCOMPARE(DatabaseManagement::isConnected(), true);
 }
 
+void DatabaseTest::testCaseUpgrade()
+{
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    // Turn the database into a version 1 database (without the schedule template tables)
+    QVERIFY(DatabaseManagement::executeSqlCommand(
+                QStringLiteral("DROP TABLE ScheduleTemplateExceptions")));
+    QVERIFY(DatabaseManagement::executeSqlCommand(QStringLiteral("DROP TABLE ScheduleTemplates")));
+    QVERIFY(DatabaseManagement::executeSqlCommand(QStringLiteral("PRAGMA user_version = 1")));
+
+    // Reconnecting should upgrade the database
+    DatabaseManagement::disconnect();
+    QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+
+    // Check the database version
+    QList<QMap<QString, QVariant> > results;
+    QVERIFY(DatabaseManagement::executeSqlCommand(QStringLiteral("PRAGMA user_version"),
+                                                  QMap<QString, QVariant>(),
+                                                  &results));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().value("user_version").toInt(), 2);
+
+    // Check the tables added in version 2
+    QVERIFY(DatabaseManagement::executeSqlCommand(
+                QStringLiteral("SELECT name FROM sqlite_master "
+                               "WHERE (type = 'table') AND (name LIKE 'ScheduleTemplate%') "
+                               "ORDER BY name"),
+                QMap<QString, QVariant>(),
+                &results));
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results.at(0).value("name").toString(), QStringLiteral("ScheduleTemplateExceptions"));
+    QCOMPARE(results.at(1).value("name").toString(), QStringLiteral("ScheduleTemplates"));
+}
+
 // Setting unit tests ******************************************************************************
 
 void DatabaseTest::testCaseReadSettingsEmptyDatabase()
@@ -544,11 +605,13 @@ void DatabaseTest::testCaseReadWorkingDaysNonEmptyDatabase()
     QCOMPARE(workingDay.second, QDateTime(QDate(2016, 01, 01), QTime(22, 59, 59)));
 
     // Timestamp a second before working day 2
+    qint64 workingDayId = -1LL;
     timestamp = QDateTime(QDate(2016, 01, 02), QTime(6, 59, 59));
-    workingDay = ScheduleManagement::readWorkingDay(timestamp);
+    workingDay = ScheduleManagement::readWorkingDay(timestamp, &workingDayId);
 
     QVERIFY(!workingDay.first.isValid());
     QVERIFY(!workingDay.second.isValid());
+    QCOMPARE(workingDayId, 0LL);
 
     // Read working day 2: start
     timestamp = QDateTime(QDate(2016, 01, 02), QTime(7, 00, 00));
@@ -559,10 +622,11 @@ void DatabaseTest::testCaseReadWorkingDaysNonEmptyDatabase()
 
     // Read working day 2: middle
     timestamp = QDateTime(QDate(2016, 01, 02), QTime(15, 00, 00));
-    workingDay = ScheduleManagement::readWorkingDay(timestamp);
+    workingDay = ScheduleManagement::readWorkingDay(timestamp, &workingDayId);
 
     QCOMPARE(workingDay.first, QDateTime(QDate(2016, 01, 02), QTime(7, 00, 00)));
     QCOMPARE(workingDay.second, QDateTime(QDate(2016, 01, 02), QTime(22, 59, 59)));
+    QCOMPARE(workingDayId, 2LL);
 
     // Read working day 2: end
     timestamp = QDateTime(QDate(2016, 01, 02), QTime(22, 59, 59));
@@ -577,6 +641,15 @@ void DatabaseTest::testCaseReadWorkingDaysNonEmptyDatabase()
 
     QVERIFY(!workingDay.first.isValid());
     QVERIFY(!workingDay.second.isValid());
+
+    // Read all working days
+    const QMap<qint64, QPair<QDateTime, QDateTime> > workingDays =
+            ScheduleManagement::readWorkingDays();
+
+    QCOMPARE(workingDays.size(), 2);
+    QCOMPARE(workingDays.value(1LL).first, QDateTime(QDate(2016, 01, 01), QTime(7, 00, 00)));
+    QCOMPARE(workingDays.value(2LL).first, QDateTime(QDate(2016, 01, 02), QTime(7, 00, 00)));
+    QCOMPARE(workingDays.value(2LL).second, QDateTime(QDate(2016, 01, 02), QTime(22, 59, 59)));
 }
 
 // User unit tests *********************************************************************************
@@ -1201,6 +1274,11 @@ void DatabaseTest::testCaseAddScheduleFail_data()
     QTest::newRow("3") << 1LL
                        << QDateTime(QDate(2016, 01, 01), QTime(8, 00, 00))
                        << QDateTime();
+
+    // Overlaps with an existing schedule of the user
+    QTest::newRow("4") << 1LL
+                       << QDateTime(QDate(2016, 01, 01), QTime(11, 00, 00))
+                       << QDateTime(QDate(2016, 01, 01), QTime(13, 00, 00));
 }
 
 void DatabaseTest::testCaseAddScheduleFail()
@@ -1221,6 +1299,10 @@ void DatabaseTest::testCaseAddScheduleFail()
     QFETCH(QDateTime, endTimestamp);
 
     QVERIFY(!ScheduleManagement::addSchedule(userId, startTimestamp, endTimestamp));
+
+    // The transaction of the rejected schedule was rolled back, so a new one can be started
+    QVERIFY(DatabaseManagement::beginTransaction());
+    QVERIFY(DatabaseManagement::rollbackTransaction());
 }
 
 void DatabaseTest::testCaseRemoveSchedule()
@@ -1735,6 +1817,411 @@ void DatabaseTest::testCaseReadEventChangeLogChangedEvent()
     QCOMPARE(toValueEnableState, false);
 }
 
+// Change notification unit tests ******************************************************************
+
+void DatabaseTest::testCaseChangeNotification()
+{
+    using namespace OpenTimeTracker::Server;
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    QSignalSpy userNameSpy(ChangeNotifier::instance(), SIGNAL(userNameChanged(qint64,QString)));
+    QSignalSpy userGroupSpy(ChangeNotifier::instance(), SIGNAL(userGroupAdded(qint64,QString)));
+
+    // Change user name
+    QVERIFY(UserManagement::changeUserName(2LL, "user2notified"));
+    QCOMPARE(userNameSpy.size(), 1);
+    QCOMPARE(userNameSpy.at(0).at(0).toLongLong(), 2LL);
+    QCOMPARE(userNameSpy.at(0).at(1).toString(), QString("user2notified"));
+
+    // Failed change must not be notified
+    QVERIFY(!UserManagement::changeUserName(2LL, "user1"));
+    QCOMPARE(userNameSpy.size(), 1);
+
+    // Add user group, the notification must hold the ID of the new user group
+    QVERIFY(UserManagement::addUserGroup("groupNotified"));
+    QCOMPARE(userGroupSpy.size(), 1);
+
+    const QList<UserGroup> userGroups = UserManagement::readUserGroups();
+    QVERIFY(!userGroups.isEmpty());
+    QCOMPARE(userGroupSpy.at(0).at(0).toLongLong(), userGroups.last().id());
+    QCOMPARE(userGroupSpy.at(0).at(1).toString(), QString("groupNotified"));
+}
+
+void DatabaseTest::testCaseChangeNotificationTransaction()
+{
+    using namespace OpenTimeTracker::Server;
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    QSignalSpy userNameSpy(ChangeNotifier::instance(), SIGNAL(userNameChanged(qint64,QString)));
+
+    // Rolled back change must not be notified
+    QVERIFY(DatabaseManagement::beginTransaction());
+    QVERIFY(UserManagement::changeUserName(2LL, "user2rolledBack"));
+    QCOMPARE(userNameSpy.size(), 0);
+    QVERIFY(DatabaseManagement::rollbackTransaction());
+    QCOMPARE(userNameSpy.size(), 0);
+    QVERIFY(readUser(2LL).name() != QString("user2rolledBack"));
+
+    // Committed change is notified only after the commit
+    QVERIFY(DatabaseManagement::beginTransaction());
+    QVERIFY(UserManagement::changeUserName(2LL, "user2committed"));
+    QCOMPARE(userNameSpy.size(), 0);
+    QVERIFY(DatabaseManagement::commitTransaction());
+    QCOMPARE(userNameSpy.size(), 1);
+    QCOMPARE(userNameSpy.at(0).at(0).toLongLong(), 2LL);
+    QCOMPARE(userNameSpy.at(0).at(1).toString(), QString("user2committed"));
+}
+
+// Import unit tests *******************************************************************************
+
+void DatabaseTest::testCaseRosterFromCsv()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Valid roster
+    bool ok = false;
+    Roster roster = Roster::fromCsv("# name,password,groups\n"
+                                    "user1,111,group1;group2\n"
+                                    "\n"
+                                    "user2,222\n"
+                                    "user3,,group2\n",
+                                    &ok);
+    QVERIFY(ok);
+    QCOMPARE(roster.size(), 3);
+    QCOMPARE(roster.entries().at(0).userName, QString("user1"));
+    QCOMPARE(roster.entries().at(0).userGroupNames, QStringList() << "group1" << "group2");
+    QCOMPARE(roster.entries().at(1).password, QString("222"));
+    QVERIFY(roster.entries().at(1).userGroupNames.isEmpty());
+    QVERIFY(roster.entries().at(2).password.isEmpty());
+    QCOMPARE(roster.userGroupNames(), QStringList() << "group1" << "group2");
+
+    // Too many fields
+    roster = Roster::fromCsv("user1,111,group1,extra\n", &ok);
+    QVERIFY(!ok);
+    QVERIFY(roster.isEmpty());
+}
+
+void DatabaseTest::testCaseRosterFromJson()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Valid roster
+    bool ok = false;
+    Roster roster = Roster::fromJson("[{\"name\": \"user1\", \"password\": \"111\", "
+                                     "\"groups\": [\"group1\"]}, {\"name\": \"user2\"}]",
+                                     &ok);
+    QVERIFY(ok);
+    QCOMPARE(roster.size(), 2);
+    QCOMPARE(roster.entries().at(0).password, QString("111"));
+    QCOMPARE(roster.entries().at(0).userGroupNames, QStringList() << "group1");
+    QCOMPARE(roster.entries().at(1).userName, QString("user2"));
+    QVERIFY(roster.entries().at(1).password.isEmpty());
+
+    // Invalid rosters
+    roster = Roster::fromJson("{\"name\": \"user1\"}", &ok);
+    QVERIFY(!ok);
+
+    roster = Roster::fromJson("[{\"name\": \"user1\", \"groups\": \"group1\"}]", &ok);
+    QVERIFY(!ok);
+    QVERIFY(roster.isEmpty());
+}
+
+void DatabaseTest::testCaseImportRoster()
+{
+    using namespace OpenTimeTracker::Server;
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    const int userCount = UserManagement::readUsers().size();
+    const int userGroupCount = UserManagement::readUserGroups().size();
+    const int userMappingCount = UserManagement::readUserMappings().size();
+
+    // Import roster, the second entry uses an existing user name
+    bool ok = false;
+    const Roster roster = Roster::fromCsv("imported1,imp111,groupNotified;importedGroup\n"
+                                          "user1,imp222,importedGroup\n"
+                                          "imported2,,importedGroup\n",
+                                          &ok);
+    QVERIFY(ok);
+
+    QSignalSpy userSpy(ChangeNotifier::instance(), SIGNAL(userAdded(qint64,QString,QString)));
+    QStringList rowErrors;
+    QVERIFY(UserManagement::importRoster(roster, &rowErrors));
+
+    QCOMPARE(rowErrors.size(), 3);
+    QVERIFY(rowErrors.at(0).isEmpty());
+    QVERIFY(!rowErrors.at(1).isEmpty());
+    QVERIFY(rowErrors.at(2).isEmpty());
+    QCOMPARE(userSpy.size(), 2);
+
+    // Check the imported users, user groups and user mappings
+    const QList<User> users = UserManagement::readUsers();
+    QCOMPARE(users.size(), userCount + 2);
+    QCOMPARE(users.at(userCount).name(), QString("imported1"));
+    QCOMPARE(users.at(userCount).password(), QString("imp111"));
+    QVERIFY(users.at(userCount + 1).password().isNull());
+
+    const QList<UserGroup> userGroups = UserManagement::readUserGroups();
+    QCOMPARE(userGroups.size(), userGroupCount + 1);
+    QCOMPARE(userGroups.last().name(), QString("importedGroup"));
+
+    const QList<UserMapping> userMappings = UserManagement::readUserMappings();
+    QCOMPARE(userMappings.size(), userMappingCount + 3);
+    QCOMPARE(userMappings.last().userGroupId(), userGroups.last().id());
+    QCOMPARE(userMappings.last().userId(), users.at(userCount + 1).id());
+}
+
+// Schedule publishing unit tests ******************************************************************
+
+void DatabaseTest::testCasePublishSchedules()
+{
+    using namespace OpenTimeTracker::Server;
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    const QDateTime startOfDay(QDate(2017, 01, 01), QTime(0, 0, 0));
+    const QDateTime endOfDay(QDate(2017, 01, 01), QTime(23, 59, 59));
+
+    // Schedules may touch but not overlap, schedules of other users are not affected
+    QVERIFY(ScheduleManagement::addSchedule(1LL,
+                                            startOfDay.addSecs(8 * 3600),
+                                            startOfDay.addSecs(12 * 3600)));
+    QVERIFY(!ScheduleManagement::addSchedule(1LL,
+                                             startOfDay.addSecs(11 * 3600),
+                                             startOfDay.addSecs(13 * 3600)));
+    QVERIFY(ScheduleManagement::addSchedule(1LL,
+                                            startOfDay.addSecs(12 * 3600),
+                                            startOfDay.addSecs(13 * 3600)));
+    QVERIFY(ScheduleManagement::addSchedule(2LL,
+                                            startOfDay.addSecs(11 * 3600),
+                                            startOfDay.addSecs(13 * 3600)));
+    QCOMPARE(ScheduleManagement::readSchedules(startOfDay, endOfDay).size(), 3);
+
+    // Published schedules that overlap with each other are rejected
+    QList<Schedule> schedules;
+
+    Schedule schedule;
+    schedule.setUserId(2LL);
+    schedule.setStartTimestamp(startOfDay.addSecs(14 * 3600));
+    schedule.setEndTimestamp(startOfDay.addSecs(16 * 3600));
+    schedules.append(schedule);
+
+    schedule.setStartTimestamp(startOfDay.addSecs(15 * 3600));
+    schedule.setEndTimestamp(startOfDay.addSecs(17 * 3600));
+    schedules.append(schedule);
+
+    QStringList rowErrors;
+    QVERIFY(!ScheduleManagement::publishSchedules(schedules, &rowErrors));
+    QCOMPARE(rowErrors.size(), 2);
+    QVERIFY(rowErrors.at(0).isEmpty());
+    QVERIFY(!rowErrors.at(1).isEmpty());
+    QCOMPARE(ScheduleManagement::readSchedules(startOfDay, endOfDay).size(), 3);
+
+    // Valid schedules are all added
+    schedules[1].setStartTimestamp(startOfDay.addSecs(16 * 3600));
+    schedules.append(schedule);
+    schedules[2].setUserId(1LL);
+
+    QSignalSpy scheduleSpy(ChangeNotifier::instance(),
+                           SIGNAL(scheduleAdded(qint64,qint64,QDateTime,QDateTime)));
+    QVERIFY(ScheduleManagement::publishSchedules(schedules, &rowErrors));
+    QCOMPARE(rowErrors, QStringList() << QString() << QString() << QString());
+    QCOMPARE(scheduleSpy.size(), 3);
+    QCOMPARE(ScheduleManagement::readSchedules(startOfDay, endOfDay).size(), 6);
+
+    // Published schedules that overlap with stored schedules are rejected
+    schedules.clear();
+    schedule.setUserId(1LL);
+    schedule.setStartTimestamp(startOfDay.addSecs(18 * 3600));
+    schedule.setEndTimestamp(startOfDay.addSecs(19 * 3600));
+    schedules.append(schedule);
+
+    schedule.setStartTimestamp(startOfDay.addSecs(12 * 3600 + 1800));
+    schedules.append(schedule);
+
+    QVERIFY(!ScheduleManagement::publishSchedules(schedules, &rowErrors));
+    QCOMPARE(rowErrors.size(), 2);
+    QVERIFY(rowErrors.at(0).isEmpty());
+    QVERIFY(!rowErrors.at(1).isEmpty());
+    QCOMPARE(ScheduleManagement::readSchedules(startOfDay, endOfDay).size(), 6);
+
+    // The transaction of the rejected schedules was rolled back, so a new one can be started
+    QVERIFY(DatabaseManagement::beginTransaction());
+    QVERIFY(DatabaseManagement::rollbackTransaction());
+}
+
+// Schedule template unit tests ********************************************************************
+
+void DatabaseTest::testCaseScheduleTemplates()
+{
+    using namespace OpenTimeTracker::Server;
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    // 2018-01-01 is a Monday
+    const QDateTime startOfDay(QDate(2018, 01, 01), QTime(0, 0, 0));
+    const QDateTime endOfDay(QDate(2018, 01, 01), QTime(23, 59, 59));
+
+    // Invalid schedule templates
+    QVERIFY(!ScheduleManagement::addScheduleTemplate(1LL,
+                                                     8,
+                                                     QTime(8, 0, 0),
+                                                     3600,
+                                                     QDate(2018, 01, 01)));
+    QVERIFY(!ScheduleManagement::addScheduleTemplate(1LL,
+                                                     Qt::Monday,
+                                                     QTime(8, 0, 0),
+                                                     0,
+                                                     QDate(2018, 01, 01)));
+    QVERIFY(!ScheduleManagement::addScheduleTemplate(1LL,
+                                                     Qt::Monday,
+                                                     QTime(8, 0, 0),
+                                                     3600,
+                                                     QDate(2018, 01, 10),
+                                                     QDate(2018, 01, 01)));
+
+    // Weekly schedules on Mondays, the second one is only valid in January
+    QSignalSpy templateSpy(ChangeNotifier::instance(), SIGNAL(scheduleTemplateChanged(qint64)));
+    QVERIFY(ScheduleManagement::addScheduleTemplate(1LL,
+                                                    Qt::Monday,
+                                                    QTime(8, 0, 0),
+                                                    4 * 3600,
+                                                    QDate(2018, 01, 01)));
+    QVERIFY(ScheduleManagement::addScheduleTemplate(2LL,
+                                                    Qt::Monday,
+                                                    QTime(9, 0, 0),
+                                                    4 * 3600,
+                                                    QDate(2018, 01, 01),
+                                                    QDate(2018, 01, 31)));
+    QCOMPARE(templateSpy.size(), 2);
+
+    const QList<ScheduleTemplate> scheduleTemplates =
+            ScheduleManagement::readScheduleTemplates(QDate(2018, 01, 01), QDate(2018, 01, 01));
+    QCOMPARE(scheduleTemplates.size(), 2);
+    QCOMPARE(scheduleTemplates.at(0).userId(), 1LL);
+    QVERIFY(scheduleTemplates.at(0).validUntil().isNull());
+    QCOMPARE(scheduleTemplates.at(1).validUntil(), QDate(2018, 01, 31));
+
+    // The templates are expanded only for the requested time range
+    QList<Schedule> schedules = ScheduleManagement::readExpandedSchedules(startOfDay, endOfDay);
+    QCOMPARE(schedules.size(), 2);
+    QCOMPARE(schedules.at(0).id(), 0LL);
+    QCOMPARE(schedules.at(0).scheduleTemplateId(), scheduleTemplates.at(0).id());
+    QCOMPARE(schedules.at(0).userId(), 1LL);
+    QCOMPARE(schedules.at(0).startTimestamp(), startOfDay.addSecs(8 * 3600));
+    QCOMPARE(schedules.at(0).endTimestamp(), startOfDay.addSecs(12 * 3600));
+    QCOMPARE(schedules.at(1).userId(), 2LL);
+
+    QVERIFY(ScheduleManagement::readExpandedSchedules(startOfDay.addDays(1),
+                                                      endOfDay.addDays(1)).isEmpty());
+    QCOMPARE(ScheduleManagement::readExpandedSchedules(startOfDay.addDays(35),
+                                                       endOfDay.addDays(35)).size(), 1);
+
+    // Exceptions
+    QVERIFY(ScheduleManagement::addScheduleTemplateException(scheduleTemplates.at(0).id(),
+                                                             QDate(2018, 01, 08)));
+    QVERIFY(!ScheduleManagement::addScheduleTemplateException(scheduleTemplates.at(0).id(),
+                                                              QDate(2018, 01, 08)));
+
+    schedules = ScheduleManagement::readExpandedSchedules(startOfDay.addDays(7),
+                                                          endOfDay.addDays(7));
+    QCOMPARE(schedules.size(), 1);
+    QCOMPARE(schedules.at(0).userId(), 2LL);
+
+    // A stored schedule replaces the expanded schedule that it overlaps with
+    QVERIFY(ScheduleManagement::addSchedule(1LL,
+                                            startOfDay.addDays(14).addSecs(10 * 3600),
+                                            startOfDay.addDays(14).addSecs(14 * 3600)));
+
+    schedules = ScheduleManagement::readExpandedSchedules(startOfDay.addDays(14),
+                                                          endOfDay.addDays(14));
+    QCOMPARE(schedules.size(), 2);
+    QCOMPARE(schedules.at(0).userId(), 1LL);
+    QCOMPARE(schedules.at(0).startTimestamp(), startOfDay.addDays(14).addSecs(10 * 3600));
+    QCOMPARE(schedules.at(1).userId(), 2LL);
+
+    // Remove schedule template (together with its exceptions)
+    QVERIFY(ScheduleManagement::removeScheduleTemplate(scheduleTemplates.at(0).id()));
+    QVERIFY(!ScheduleManagement::removeScheduleTemplate(scheduleTemplates.at(0).id()));
+    QCOMPARE(ScheduleManagement::readScheduleTemplates(QDate(2018, 01, 01),
+                                                       QDate(2018, 01, 31)).size(), 1);
+    QCOMPARE(templateSpy.size(), 4);
+}
+
+// Event benchmarks ********************************************************************************
+
+void DatabaseTest::testCaseBenchmarkReadEvents()
+{
+    using namespace OpenTimeTracker::Server;
+    using namespace OpenTimeTracker::Server::Database;
+
+    // Make sure the we are connected to the database
+    if (DatabaseManagement::isConnected() == false)
+    {
+        QVERIFY(DatabaseManagement::connect(m_databaseFilePath));
+        QCOMPARE(DatabaseManagement::isConnected(), true);
+    }
+
+    // Add the events in a single transaction
+    const int eventCount = 1000;
+    const QDateTime startTimestamp(QDate(2017, 01, 02), QTime(0, 0, 0), Qt::UTC);
+
+    QVERIFY(DatabaseManagement::beginTransaction());
+
+    for (int i = 0; i < eventCount; i++)
+    {
+        const Event::Type type = ((i % 2) == 0) ? Event::Type_Started : Event::Type_Finished;
+        QVERIFY(EventManagement::addEvent(startTimestamp.addSecs(i * 60), 1LL, type));
+    }
+
+    QVERIFY(DatabaseManagement::commitTransaction());
+
+    // Measure reading of the events
+    QList<Event> events;
+
+    QBENCHMARK
+    {
+        events = EventManagement::readEvents(startTimestamp,
+                                             startTimestamp.addSecs(eventCount * 60),
+                                             1LL);
+    }
+
+    QCOMPARE(events.size(), eventCount);
+    QVERIFY(events.last().isValid());
+}
+
 QTEST_APPLESS_MAIN(DatabaseTest)
 
 #include "tst_DatabaseTest.moc"
@@ -13,17 +13,52 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <time.h>
 #include <QtCore/QString>
 #include <QtTest>
 #include "../../src/Database/DatabaseManagement.hpp"
+#include "../../src/Database/EventManagement.hpp"
+#include "../../src/Database/ScheduleManagement.hpp"
 #include "../../src/Database/UserManagement.hpp"
+#include "../../src/Packets/ClockEventRequestPacket.hpp"
+#include "../../src/Packets/ClockEventRequestPacketWriter.hpp"
+#include "../../src/Packets/ClockEventResponsePacket.hpp"
+#include "../../src/Packets/ClockEventResponsePacketReader.hpp"
+#include "../../src/Packets/CompressionRequestPacket.hpp"
+#include "../../src/Packets/CompressionRequestPacketWriter.hpp"
+#include "../../src/Packets/CompressionResponsePacket.hpp"
+#include "../../src/Packets/CompressionResponsePacketReader.hpp"
 #include "../../src/Packets/KeepAliveRequestPacket.hpp"
 #include "../../src/Packets/KeepAliveRequestPacketReader.hpp"
 #include "../../src/Packets/KeepAliveRequestPacketWriter.hpp"
 #include "../../src/Packets/KeepAliveResponsePacket.hpp"
 #include "../../src/Packets/KeepAliveResponsePacketReader.hpp"
 #include "../../src/Packets/KeepAliveResponsePacketWriter.hpp"
+#include "../../src/Packets/LoginRequestPacket.hpp"
+#include "../../src/Packets/LoginRequestPacketWriter.hpp"
+#include "../../src/Packets/LoginResponsePacket.hpp"
+#include "../../src/Packets/LoginResponsePacketReader.hpp"
+#include "../../src/Packets/SubscribeUserStatusRequestPacket.hpp"
+#include "../../src/Packets/SubscribeUserStatusRequestPacketWriter.hpp"
+#include "../../src/Packets/SubscribeUserStatusResponsePacket.hpp"
+#include "../../src/Packets/SubscribeUserStatusResponsePacketReader.hpp"
+#include "../../src/Packets/UserStatusPacket.hpp"
+#include "../../src/Packets/UserStatusPacketReader.hpp"
+#include "../../src/Packets/UserTotalsRequestPacket.hpp"
+#include "../../src/Packets/UserTotalsRequestPacketWriter.hpp"
+#include "../../src/Packets/UserTotalsResponsePacket.hpp"
+#include "../../src/Packets/UserTotalsResponsePacketReader.hpp"
+#include "../../src/Packets/UserTotalsResponsePacketWriter.hpp"
+#include "../../src/CredentialCache.hpp"
+#include "../../src/EventRecorder.hpp"
+#include "../../src/GroupMembership.hpp"
+#include "../../src/ScheduleCache.hpp"
+#include "../../src/ScheduleIndex.hpp"
+#include "../../src/ScheduleTemplate.hpp"
 #include "../../src/Server.hpp"
+#include "../../src/Settings.hpp"
+#include "../../src/UserDirectory.hpp"
+#include "../../src/WorkingDayCache.hpp"
 
 namespace Test
 {
@@ -37,14 +72,43 @@ public:
     Client()
         : QObject(),
           m_socket(),
-          m_packetHandler()
+          m_packetHandler(),
+          m_receivedData()
     {
+        m_packetHandler.registerPacketWriter(new Packets::CompressionRequestPacketWriter());
+        m_packetHandler.registerPacketReader(new Packets::CompressionResponsePacketReader());
+
         m_packetHandler.registerPacketReader(new Packets::KeepAliveRequestPacketReader());
         m_packetHandler.registerPacketWriter(new Packets::KeepAliveRequestPacketWriter());
 
         m_packetHandler.registerPacketReader(new Packets::KeepAliveResponsePacketReader());
         m_packetHandler.registerPacketWriter(new Packets::KeepAliveResponsePacketWriter());
 
+        m_packetHandler.registerPacketWriter(new Packets::LoginRequestPacketWriter());
+        m_packetHandler.registerPacketReader(new Packets::LoginResponsePacketReader());
+
+        m_packetHandler.registerPacketWriter(
+                    new Packets::SubscribeUserStatusRequestPacketWriter());
+        m_packetHandler.registerPacketReader(
+                    new Packets::SubscribeUserStatusResponsePacketReader());
+        m_packetHandler.registerPacketReader(new Packets::UserStatusPacketReader());
+
+        m_packetHandler.registerPacketWriter(new Packets::UserTotalsRequestPacketWriter());
+        m_packetHandler.registerPacketReader(new Packets::UserTotalsResponsePacketReader());
+
+        const QList<Event::Type> clockEventTypes = QList<Event::Type>() << Event::Type_Started
+                                                                        << Event::Type_OnBreak
+                                                                        << Event::Type_FromBreak
+                                                                        << Event::Type_Finished;
+
+        foreach (const Event::Type eventType, clockEventTypes)
+        {
+            m_packetHandler.registerPacketWriter(
+                        new Packets::ClockEventRequestPacketWriter(eventType));
+            m_packetHandler.registerPacketReader(
+                        new Packets::ClockEventResponsePacketReader(eventType));
+        }
+
         QObject::connect(&m_socket, SIGNAL(readyRead()), this, SLOT(readReceivedData()));
     }
 
@@ -79,6 +143,75 @@ public:
         return success;
     }
 
+    bool sendData(const QByteArray &data)
+    {
+        bool success = false;
+
+        const qint64 bytesWritten = m_socket.write(data);
+
+        if (bytesWritten == data.size())
+        {
+            success = m_socket.flush();
+        }
+
+        return success;
+    }
+
+    qint64 login(const QString &userName, const QString &password)
+    {
+        qint64 userId = 0LL;
+
+        Packets::LoginRequestPacket requestPacket;
+        requestPacket.setId(PacketHandler::createPacketId());
+        requestPacket.setUserName(userName);
+        requestPacket.setPassword(password);
+
+        if (sendPacket(requestPacket))
+        {
+            QScopedPointer<Packets::Packet> packet(readPacket());
+            Packets::LoginResponsePacket *responsePacket =
+                    dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+            if ((responsePacket != nullptr) && responsePacket->isAccepted())
+            {
+                userId = responsePacket->userId();
+            }
+        }
+
+        return userId;
+    }
+
+    qint32 requestWorkingTime(const qint64 &userId, const QDateTime &timestamp)
+    {
+        qint32 workingTime = -1;
+
+        Packets::UserTotalsRequestPacket requestPacket;
+        requestPacket.setId(PacketHandler::createPacketId());
+        requestPacket.setUserIds(QList<qint64>() << userId);
+        requestPacket.setTimestamp(timestamp);
+
+        if (sendPacket(requestPacket))
+        {
+            QScopedPointer<Packets::Packet> packet(readPacket());
+            Packets::UserTotalsResponsePacket *responsePacket =
+                    dynamic_cast<Packets::UserTotalsResponsePacket *>(packet.data());
+
+            if ((responsePacket != nullptr) &&
+                responsePacket->isAccepted() &&
+                (responsePacket->totals().size() == 1))
+            {
+                workingTime = responsePacket->totals().first().workingTime;
+            }
+        }
+
+        return workingTime;
+    }
+
+    QByteArray toByteArray(const Packets::Packet &packet)
+    {
+        return m_packetHandler.toByteArray(packet);
+    }
+
     Packets::Packet *readPacket()
     {
         Packets::Packet *packet = nullptr;
@@ -124,15 +257,52 @@ public:
         return packet;
     }
 
+    QByteArray receivedData() const
+    {
+        return m_receivedData;
+    }
+
 private slots:
     void readReceivedData()
     {
-        m_packetHandler.addData(m_socket.readAll());
+        const QByteArray data = m_socket.readAll();
+        m_receivedData.append(data);
+        m_packetHandler.addData(data);
     }
 
 private:
     QTcpSocket m_socket;
     PacketHandler m_packetHandler;
+    QByteArray m_receivedData;
+};
+
+class PacketIdThread : public QThread
+{
+public:
+    PacketIdThread(const int count)
+        : QThread(),
+          m_count(count),
+          m_packetIds()
+    {
+    }
+
+    QList<quint32> packetIds() const
+    {
+        return m_packetIds;
+    }
+
+protected:
+    void run()
+    {
+        for (int i = 0; i < m_count; i++)
+        {
+            m_packetIds.append(PacketHandler::createPacketId());
+        }
+    }
+
+private:
+    const int m_count;
+    QList<quint32> m_packetIds;
 };
 }
 
@@ -153,6 +323,67 @@ private Q_SLOTS:
 
     // Client unit tests
     void testCaseClientConnect();
+    void testCaseClientManyRequests();
+    void testCaseClientPipelinedRequests();
+    void testCaseClientIoThreads_data();
+    void testCaseClientIoThreads();
+    void testCaseClientRegistry();
+    void testCaseClientIdleTimeout();
+    void testCaseClientKeepAlive();
+    void testCaseClientOversizedFrame();
+    void testCaseClientClockEvents();
+    void testCaseClientUserStatusSubscription();
+    void testCaseClientUserTotals();
+    void testCaseClientCompression();
+    void testCaseClientLogin();
+    void testCaseClientLoginAfterRename();
+    void testCaseClientUnauthenticatedRequests();
+    void testCaseClientWorkday();
+
+    // Credential cache unit tests
+    void testCaseCredentialCache();
+
+    // User directory unit tests
+    void testCaseUserDirectory();
+
+    // Group membership unit tests
+    void testCaseUserSet();
+    void testCaseGroupMembership();
+
+    // Schedule cache unit tests
+    void testCaseScheduleCache();
+    void testCaseScheduleIndex();
+    void testCaseScheduleTemplate();
+
+    // Working day cache unit tests
+    void testCaseWorkingDayCache();
+
+    // Settings unit tests
+    void testCaseSettings();
+
+    // Event recorder unit tests
+    void testCaseEventRecorder();
+
+    // Latency histogram unit tests
+    void testCaseLatencyHistogram();
+
+    // Value type unit tests
+    void testCaseImplicitSharing();
+
+    // Packet unit tests
+    void testCasePacketHandlerLimits();
+    void testCasePacketIdThreads();
+    void testCasePacketCompression();
+    void testCaseKeepAliveResponseTemplate_data();
+    void testCaseKeepAliveResponseTemplate();
+
+    // Packet writer benchmarks
+    void testCaseBenchmarkPacketWriter_data();
+    void testCaseBenchmarkPacketWriter();
+    void testCaseBenchmarkPacketCompression_data();
+    void testCaseBenchmarkPacketCompression();
+    void testCaseBenchmarkEventList_data();
+    void testCaseBenchmarkEventList();
 
 private:
     void removeDatabaseFile();
@@ -261,6 +492,2063 @@ void ServerTest::testCaseClientConnect()
     QCOMPARE(derivedPacket->referenceId(), requestPacket.id());
 }
 
+void ServerTest::testCaseClientManyRequests()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QCoreApplication::processEvents();
+
+    // Send many "keep alive" requests at once
+    const int requestCount = 100;
+    QList<quint32> requestIds;
+    QByteArray data;
+
+    for (int i = 0; i < requestCount; i++)
+    {
+        Packets::KeepAliveRequestPacket requestPacket;
+        requestPacket.setId(PacketHandler::createPacketId());
+
+        requestIds.append(requestPacket.id());
+        data.append(client.toByteArray(requestPacket));
+    }
+
+    QVERIFY(client.sendData(data));
+
+    // Wait for all of the response packets
+    for (int i = 0; i < requestCount; i++)
+    {
+        QScopedPointer<Packets::Packet> responsePacket(client.readPacket());
+        QVERIFY(!responsePacket.isNull());
+
+        Packets::KeepAliveResponsePacket *derivedPacket =
+                dynamic_cast<Packets::KeepAliveResponsePacket *>(responsePacket.data());
+
+        QVERIFY(derivedPacket != nullptr);
+        QCOMPARE(derivedPacket->referenceId(), requestIds.at(i));
+    }
+}
+
+void ServerTest::testCaseClientPipelinedRequests()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server with small input limits
+    Server server;
+    server.setMaxInputBufferSize(8 * 1024);
+    server.setMaxFrameSize(256);
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client, connect to the server and login
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    const qint64 userId = client.login("user1", "111");
+    QVERIFY(userId > 0LL);
+
+    // Send many more requests than can be pending at once without waiting for their responses,
+    // their size exceeds the input buffer so processing of the received data is paused and resumed
+    // several times
+    const int requestCount = 200;
+    QSet<quint32> requestIds;
+    QByteArray data;
+
+    for (int i = 0; i < requestCount; i++)
+    {
+        Packets::UserTotalsRequestPacket requestPacket;
+        requestPacket.setId(PacketHandler::createPacketId());
+        requestPacket.setUserIds(QList<qint64>() << userId);
+
+        requestIds.insert(requestPacket.id());
+        data.append(client.toByteArray(requestPacket));
+    }
+
+    QVERIFY(data.size() > (2 * server.maxInputBufferSize()));
+    QVERIFY(client.sendData(data));
+
+    // All requests must be answered and the client must stay connected
+    for (int i = 0; i < requestCount; i++)
+    {
+        QScopedPointer<Packets::Packet> packet(client.readPacket());
+        Packets::UserTotalsResponsePacket *responsePacket =
+                dynamic_cast<Packets::UserTotalsResponsePacket *>(packet.data());
+
+        QVERIFY(responsePacket != nullptr);
+        QVERIFY(requestIds.remove(responsePacket->referenceId()));
+        QVERIFY(responsePacket->isAccepted());
+    }
+
+    QVERIFY(requestIds.isEmpty());
+    QCOMPARE(server.clientCount(), 1);
+}
+
+void ServerTest::testCaseClientIoThreads_data()
+{
+    QTest::addColumn<int>("ioThreadCount");
+
+    QTest::newRow("No I/O threads") << 0;
+    QTest::newRow("Single I/O thread") << 1;
+    QTest::newRow("Multiple I/O threads") << 3;
+}
+
+void ServerTest::testCaseClientIoThreads()
+{
+    using namespace OpenTimeTracker::Server;
+
+    QFETCH(int, ioThreadCount);
+
+    // Start server
+    Server server;
+    server.setIoThreadCount(ioThreadCount);
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Connect more clients than there are I/O threads
+    const int clientCount = 5;
+    QList<Test::Client *> clients;
+
+    for (int i = 0; i < clientCount; i++)
+    {
+        clients.append(new Test::Client());
+        QVERIFY(clients.last()->connect(m_port));
+        QCoreApplication::processEvents();
+    }
+
+    // Send a "keep alive" request from each client and wait for its response
+    foreach (Test::Client *client, clients)
+    {
+        Packets::KeepAliveRequestPacket requestPacket;
+        requestPacket.setId(PacketHandler::createPacketId());
+
+        QVERIFY(client->sendPacket(requestPacket));
+
+        QScopedPointer<Packets::Packet> responsePacket(client->readPacket());
+        QVERIFY(!responsePacket.isNull());
+
+        Packets::KeepAliveResponsePacket *derivedPacket =
+                dynamic_cast<Packets::KeepAliveResponsePacket *>(responsePacket.data());
+
+        QVERIFY(derivedPacket != nullptr);
+        QCOMPARE(derivedPacket->referenceId(), requestPacket.id());
+    }
+
+    qDeleteAll(clients);
+
+    // Stop server
+    server.stop();
+    QVERIFY(!server.isStarted());
+}
+
+void ServerTest::testCaseClientRegistry()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Connect many clients
+    const int clientCount = 20;
+    QList<Test::Client *> clients;
+
+    for (int i = 0; i < clientCount; i++)
+    {
+        clients.append(new Test::Client());
+        QVERIFY(clients.last()->connect(m_port));
+    }
+
+    QTRY_COMPARE(server.clientCount(), clientCount);
+
+    // Unknown users have no clients
+    QVERIFY(server.clientsOfUser(1LL).isEmpty());
+    QVERIFY(!server.sendToUser(1LL, QByteArray("data")));
+
+    // Disconnect all clients at once
+    qDeleteAll(clients);
+    clients.clear();
+
+    QTRY_COMPARE(server.clientCount(), 0);
+}
+
+void ServerTest::testCaseClientIdleTimeout()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server with a short idle timeout
+    Server server;
+    server.setIdleTimeout(500);
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    // Active client must stay connected for longer than the idle timeout
+    for (int i = 0; i < 10; i++)
+    {
+        Packets::KeepAliveRequestPacket requestPacket;
+        requestPacket.setId(PacketHandler::createPacketId());
+
+        QVERIFY(client.sendPacket(requestPacket));
+
+        QScopedPointer<Packets::Packet> responsePacket(client.readPacket());
+        QVERIFY(!responsePacket.isNull());
+
+        QTest::qWait(100);
+    }
+
+    QCOMPARE(server.clientCount(), 1);
+
+    // Idle client must be disconnected
+    QTRY_COMPARE(server.clientCount(), 0);
+}
+
+void ServerTest::testCaseClientKeepAlive()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server with a short keep-alive interval
+    Server server;
+    server.setKeepAliveInterval(100);
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    // Respond to the "keep alive" requests from the server
+    const int requestCount = 3;
+
+    for (int i = 0; i < requestCount; i++)
+    {
+        QScopedPointer<Packets::Packet> requestPacket(client.readPacket());
+        QVERIFY(!requestPacket.isNull());
+        QCOMPARE(requestPacket->type(), Packets::KeepAliveRequestPacket::staticType());
+
+        Packets::KeepAliveResponsePacket responsePacket;
+        responsePacket.setId(PacketHandler::createPacketId());
+        responsePacket.setReferenceId(requestPacket->id());
+
+        QVERIFY(client.sendPacket(responsePacket));
+    }
+
+    // Check the measured round-trip times
+    QTRY_COMPARE(server.roundTripHistograms().size(), 1);
+    QTRY_COMPARE(server.roundTripHistograms().values().first().count(),
+                 static_cast<quint64>(requestCount));
+}
+
+void ServerTest::testCaseClientOversizedFrame()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server with a small frame size limit
+    Server server;
+    server.setMaxFrameSize(1024);
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    // Send the start of a packet that never ends, the client must be disconnected as soon as the
+    // limit is exceeded
+    QVERIFY(client.sendData(QByteArray("\x02") + QByteArray(2048, 'a')));
+    QTRY_COMPARE(server.clientCount(), 0);
+}
+
+void ServerTest::testCaseClientClockEvents()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test user
+    qint64 userId = 0LL;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        if (user.name() == QStringLiteral("user1"))
+        {
+            userId = user.id();
+        }
+    }
+
+    QVERIFY(userId > 0LL);
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client, connect to the server and login
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+    QCOMPARE(client.login("user1", "111"), userId);
+
+    // Send a whole workday at once
+    const QDateTime startTimestamp(QDate(2015, 6, 1), QTime(8, 0), Qt::UTC);
+    QList<Event::Type> eventTypes;
+    eventTypes << Event::Type_Started
+               << Event::Type_OnBreak
+               << Event::Type_FromBreak
+               << Event::Type_Finished;
+
+    QHash<quint32, Event::Type> requests;
+    QByteArray data;
+
+    for (int i = 0; i < eventTypes.size(); i++)
+    {
+        Packets::ClockEventRequestPacket requestPacket(eventTypes.at(i));
+        requestPacket.setId(PacketHandler::createPacketId());
+        requestPacket.setUserId(userId);
+        requestPacket.setTimestamp(startTimestamp.addSecs(i * 3600));
+
+        requests[requestPacket.id()] = requestPacket.eventType();
+        data.append(client.toByteArray(requestPacket));
+    }
+
+    QVERIFY(client.sendData(data));
+
+    // All events must be accepted
+    for (int i = 0; i < eventTypes.size(); i++)
+    {
+        QScopedPointer<Packets::Packet> responsePacket(client.readPacket());
+        QVERIFY(!responsePacket.isNull());
+
+        Packets::ClockEventResponsePacket *derivedPacket =
+                dynamic_cast<Packets::ClockEventResponsePacket *>(responsePacket.data());
+
+        QVERIFY(derivedPacket != nullptr);
+        QVERIFY(requests.contains(derivedPacket->referenceId()));
+        QCOMPARE(derivedPacket->eventType(), requests.take(derivedPacket->referenceId()));
+        QVERIFY(derivedPacket->isAccepted());
+    }
+
+    // Event that is invalid for the user's state must be rejected
+    Packets::ClockEventRequestPacket requestPacket(Event::Type_OnBreak);
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserId(userId);
+    requestPacket.setTimestamp(startTimestamp.addSecs(5 * 3600));
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    QScopedPointer<Packets::Packet> responsePacket(client.readPacket());
+    Packets::ClockEventResponsePacket *derivedPacket =
+            dynamic_cast<Packets::ClockEventResponsePacket *>(responsePacket.data());
+
+    QVERIFY(derivedPacket != nullptr);
+    QCOMPARE(derivedPacket->referenceId(), requestPacket.id());
+    QVERIFY(!derivedPacket->isAccepted());
+
+    // Stopping the server writes all accepted events to the database
+    server.stop();
+
+    const QList<Event> events =
+            Database::EventManagement::readEvents(startTimestamp,
+                                                  startTimestamp.addSecs(5 * 3600),
+                                                  userId);
+    QCOMPARE(events.size(), eventTypes.size());
+}
+
+void ServerTest::testCaseClientUserStatusSubscription()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test user
+    qint64 userId = 0LL;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        if (user.name() == QStringLiteral("user2"))
+        {
+            userId = user.id();
+        }
+    }
+
+    QVERIFY(userId > 0LL);
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test clients and connect to the server
+    Test::Client subscriber;
+    Test::Client terminal;
+
+    QVERIFY(subscriber.connect(m_port));
+    QVERIFY(terminal.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 2);
+
+    // Login the subscriber and login the terminal as the user whose status is observed
+    QVERIFY(subscriber.login("user1", "111") > 0LL);
+    QCOMPARE(terminal.login("user2", "222"), userId);
+
+    // Subscribe to the user's status
+    Packets::SubscribeUserStatusRequestPacket requestPacket;
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserIds(QList<qint64>() << userId);
+
+    QVERIFY(subscriber.sendPacket(requestPacket));
+
+    QScopedPointer<Packets::Packet> packet(subscriber.readPacket());
+    Packets::SubscribeUserStatusResponsePacket *responsePacket =
+            dynamic_cast<Packets::SubscribeUserStatusResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QCOMPARE(responsePacket->referenceId(), requestPacket.id());
+    QVERIFY(responsePacket->isAccepted());
+
+    // Current status is sent right after the response
+    packet.reset(subscriber.readPacket());
+    Packets::UserStatusPacket *statusPacket =
+            dynamic_cast<Packets::UserStatusPacket *>(packet.data());
+
+    QVERIFY(statusPacket != nullptr);
+    QCOMPARE(statusPacket->userId(), userId);
+    QCOMPARE(statusPacket->state(), TimeTracker::State_NotWorking);
+
+    // Status change is pushed to the subscriber
+    const QDateTime timestamp(QDate(2015, 6, 2), QTime(8, 0), Qt::UTC);
+    Packets::ClockEventRequestPacket clockEventPacket(Event::Type_Started);
+    clockEventPacket.setId(PacketHandler::createPacketId());
+    clockEventPacket.setUserId(userId);
+    clockEventPacket.setTimestamp(timestamp);
+
+    QVERIFY(terminal.sendPacket(clockEventPacket));
+
+    packet.reset(subscriber.readPacket());
+    statusPacket = dynamic_cast<Packets::UserStatusPacket *>(packet.data());
+
+    QVERIFY(statusPacket != nullptr);
+    QCOMPARE(statusPacket->userId(), userId);
+    QCOMPARE(statusPacket->state(), TimeTracker::State_Working);
+    QCOMPARE(statusPacket->timestamp(), timestamp);
+
+    // Subscription to an unknown user is rejected
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserIds(QList<qint64>() << 123456LL);
+
+    QVERIFY(subscriber.sendPacket(requestPacket));
+
+    packet.reset(subscriber.readPacket());
+    responsePacket = dynamic_cast<Packets::SubscribeUserStatusResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(!responsePacket->isAccepted());
+}
+
+void ServerTest::testCaseClientUserTotals()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test users
+    QList<qint64> userIds;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        userIds.append(user.id());
+    }
+
+    qSort(userIds);
+    QVERIFY(userIds.size() >= 2);
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client, connect to the server and login
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+    QVERIFY(client.login("user1", "111") > 0LL);
+
+    // Request the totals of all users
+    const QDateTime timestamp(QDate(2015, 6, 3), QTime(12, 0), Qt::UTC);
+    Packets::UserTotalsRequestPacket requestPacket;
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserIds(userIds);
+    requestPacket.setTimestamp(timestamp);
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    QScopedPointer<Packets::Packet> packet(client.readPacket());
+    Packets::UserTotalsResponsePacket *responsePacket =
+            dynamic_cast<Packets::UserTotalsResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QCOMPARE(responsePacket->referenceId(), requestPacket.id());
+    QVERIFY(responsePacket->isAccepted());
+    QCOMPARE(responsePacket->timestamp(), timestamp);
+
+    // All totals are sent in a single response
+    const QList<Packets::UserTotalsResponsePacket::UserTotals> totals = responsePacket->totals();
+    QCOMPARE(totals.size(), userIds.size());
+
+    for (int i = 0; i < totals.size(); i++)
+    {
+        QCOMPARE(totals.at(i).userId, userIds.at(i));
+        QVERIFY(totals.at(i).workingTime >= 0);
+        QVERIFY(totals.at(i).breakTime >= 0);
+        QVERIFY(totals.at(i).totalWorkingTime >= totals.at(i).workingTime);
+    }
+
+    // Request with an unknown user is rejected
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserIds(QList<qint64>() << userIds.first() << 123456LL);
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    packet.reset(client.readPacket());
+    responsePacket = dynamic_cast<Packets::UserTotalsResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(!responsePacket->isAccepted());
+    QVERIFY(responsePacket->totals().isEmpty());
+}
+
+void ServerTest::testCaseClientCompression()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test users
+    QList<qint64> userIds;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        userIds.append(user.id());
+    }
+
+    // Start server with a low compression threshold
+    Server server;
+    server.setCompressionThreshold(16);
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client, connect to the server and login
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+    QVERIFY(client.login("user1", "111") > 0LL);
+
+    // Unsupported algorithm is rejected
+    Packets::CompressionRequestPacket compressionPacket;
+    compressionPacket.setId(PacketHandler::createPacketId());
+    compressionPacket.setAlgorithm("unknown");
+
+    QVERIFY(client.sendPacket(compressionPacket));
+
+    QScopedPointer<Packets::Packet> packet(client.readPacket());
+    Packets::CompressionResponsePacket *compressionResponsePacket =
+            dynamic_cast<Packets::CompressionResponsePacket *>(packet.data());
+
+    QVERIFY(compressionResponsePacket != nullptr);
+    QCOMPARE(compressionResponsePacket->referenceId(), compressionPacket.id());
+    QVERIFY(!compressionResponsePacket->isAccepted());
+
+    // Request compression
+    compressionPacket.setId(PacketHandler::createPacketId());
+    compressionPacket.setAlgorithm("zlib");
+
+    QVERIFY(client.sendPacket(compressionPacket));
+
+    packet.reset(client.readPacket());
+    compressionResponsePacket = dynamic_cast<Packets::CompressionResponsePacket *>(packet.data());
+
+    QVERIFY(compressionResponsePacket != nullptr);
+    QCOMPARE(compressionResponsePacket->referenceId(), compressionPacket.id());
+    QVERIFY(compressionResponsePacket->isAccepted());
+    QVERIFY(!client.receivedData().contains('\x01'));
+
+    // Large response is sent in a compressed frame
+    Packets::UserTotalsRequestPacket requestPacket;
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserIds(userIds);
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    packet.reset(client.readPacket());
+    Packets::UserTotalsResponsePacket *responsePacket =
+            dynamic_cast<Packets::UserTotalsResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QCOMPARE(responsePacket->referenceId(), requestPacket.id());
+    QCOMPARE(responsePacket->totals().size(), userIds.size());
+    QVERIFY(client.receivedData().contains('\x01'));
+}
+
+void ServerTest::testCaseClientLogin()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    // Login with valid credentials
+    Packets::LoginRequestPacket requestPacket;
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserName("user3");
+    requestPacket.setPassword("222");
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    QScopedPointer<Packets::Packet> packet(client.readPacket());
+    Packets::LoginResponsePacket *responsePacket =
+            dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QCOMPARE(responsePacket->referenceId(), requestPacket.id());
+    QVERIFY(responsePacket->isAccepted());
+
+    const qint64 userId = responsePacket->userId();
+    QVERIFY(userId > 0LL);
+    QCOMPARE(server.clientsOfUser(userId).size(), 1);
+
+    // Login with an invalid password is rejected
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setPassword("111");
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    packet.reset(client.readPacket());
+    responsePacket = dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(!responsePacket->isAccepted());
+    QCOMPARE(responsePacket->userId(), 0LL);
+
+    // Changed password is used for the following logins
+    QVERIFY(server.changeUserPassword(userId, "333"));
+
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setPassword("222");
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    packet.reset(client.readPacket());
+    responsePacket = dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(!responsePacket->isAccepted());
+
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setPassword("333");
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    packet.reset(client.readPacket());
+    responsePacket = dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(responsePacket->isAccepted());
+    QCOMPARE(responsePacket->userId(), userId);
+
+    // Restore the password
+    QVERIFY(server.changeUserPassword(userId, "222"));
+}
+
+void ServerTest::testCaseClientLoginAfterRename()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    // Rename the user directly in the database, the server must pick up the change
+    const User user = Database::UserManagement::readUsers().value(2);
+    QCOMPARE(user.name(), QString("user3"));
+    QVERIFY(Database::UserManagement::changeUserName(user.id(), "user3renamed"));
+
+    // Login with the old name is rejected
+    Packets::LoginRequestPacket requestPacket;
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserName("user3");
+    requestPacket.setPassword("222");
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    QScopedPointer<Packets::Packet> packet(client.readPacket());
+    Packets::LoginResponsePacket *responsePacket =
+            dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(!responsePacket->isAccepted());
+
+    // Login with the new name is accepted
+    requestPacket.setId(PacketHandler::createPacketId());
+    requestPacket.setUserName("user3renamed");
+
+    QVERIFY(client.sendPacket(requestPacket));
+
+    packet.reset(client.readPacket());
+    responsePacket = dynamic_cast<Packets::LoginResponsePacket *>(packet.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QVERIFY(responsePacket->isAccepted());
+    QCOMPARE(responsePacket->userId(), user.id());
+
+    // Restore the name
+    QVERIFY(Database::UserManagement::changeUserName(user.id(), "user3"));
+}
+
+void ServerTest::testCaseClientUnauthenticatedRequests()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test users
+    qint64 userId1 = 0LL;
+    qint64 userId2 = 0LL;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        if (user.name() == QStringLiteral("user1"))
+        {
+            userId1 = user.id();
+        }
+        else if (user.name() == QStringLiteral("user2"))
+        {
+            userId2 = user.id();
+        }
+    }
+
+    QVERIFY(userId1 > 0LL);
+    QVERIFY(userId2 > 0LL);
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Create test client and connect to the server
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+
+    // Clock event of a client that is not logged in is rejected
+    const QDateTime timestamp(QDate(2015, 6, 4), QTime(8, 0), Qt::UTC);
+    Packets::ClockEventRequestPacket clockEventPacket(Event::Type_Started);
+    clockEventPacket.setId(PacketHandler::createPacketId());
+    clockEventPacket.setUserId(userId1);
+    clockEventPacket.setTimestamp(timestamp);
+
+    QVERIFY(client.sendPacket(clockEventPacket));
+
+    QScopedPointer<Packets::Packet> packet(client.readPacket());
+    Packets::ClockEventResponsePacket *clockEventResponsePacket =
+            dynamic_cast<Packets::ClockEventResponsePacket *>(packet.data());
+
+    QVERIFY(clockEventResponsePacket != nullptr);
+    QCOMPARE(clockEventResponsePacket->referenceId(), clockEventPacket.id());
+    QVERIFY(!clockEventResponsePacket->isAccepted());
+
+    // Subscription of a client that is not logged in is rejected
+    Packets::SubscribeUserStatusRequestPacket subscribePacket;
+    subscribePacket.setId(PacketHandler::createPacketId());
+    subscribePacket.setUserIds(QList<qint64>() << userId1);
+
+    QVERIFY(client.sendPacket(subscribePacket));
+
+    packet.reset(client.readPacket());
+    Packets::SubscribeUserStatusResponsePacket *subscribeResponsePacket =
+            dynamic_cast<Packets::SubscribeUserStatusResponsePacket *>(packet.data());
+
+    QVERIFY(subscribeResponsePacket != nullptr);
+    QCOMPARE(subscribeResponsePacket->referenceId(), subscribePacket.id());
+    QVERIFY(!subscribeResponsePacket->isAccepted());
+
+    // Totals request of a client that is not logged in is rejected
+    Packets::UserTotalsRequestPacket totalsPacket;
+    totalsPacket.setId(PacketHandler::createPacketId());
+    totalsPacket.setUserIds(QList<qint64>() << userId1);
+
+    QVERIFY(client.sendPacket(totalsPacket));
+
+    packet.reset(client.readPacket());
+    Packets::UserTotalsResponsePacket *totalsResponsePacket =
+            dynamic_cast<Packets::UserTotalsResponsePacket *>(packet.data());
+
+    QVERIFY(totalsResponsePacket != nullptr);
+    QCOMPARE(totalsResponsePacket->referenceId(), totalsPacket.id());
+    QVERIFY(!totalsResponsePacket->isAccepted());
+    QVERIFY(totalsResponsePacket->totals().isEmpty());
+
+    // Clock event for a different user than the logged in one is rejected
+    QCOMPARE(client.login("user1", "111"), userId1);
+
+    clockEventPacket.setId(PacketHandler::createPacketId());
+    clockEventPacket.setUserId(userId2);
+
+    QVERIFY(client.sendPacket(clockEventPacket));
+
+    packet.reset(client.readPacket());
+    clockEventResponsePacket = dynamic_cast<Packets::ClockEventResponsePacket *>(packet.data());
+
+    QVERIFY(clockEventResponsePacket != nullptr);
+    QCOMPARE(clockEventResponsePacket->referenceId(), clockEventPacket.id());
+    QVERIFY(!clockEventResponsePacket->isAccepted());
+
+    // Clock event for the logged in user is accepted
+    clockEventPacket.setId(PacketHandler::createPacketId());
+    clockEventPacket.setUserId(userId1);
+
+    QVERIFY(client.sendPacket(clockEventPacket));
+
+    packet.reset(client.readPacket());
+    clockEventResponsePacket = dynamic_cast<Packets::ClockEventResponsePacket *>(packet.data());
+
+    QVERIFY(clockEventResponsePacket != nullptr);
+    QCOMPARE(clockEventResponsePacket->referenceId(), clockEventPacket.id());
+    QVERIFY(clockEventResponsePacket->isAccepted());
+}
+
+void ServerTest::testCaseClientWorkday()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test user
+    qint64 userId = 0LL;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        if (user.name() == QStringLiteral("user1"))
+        {
+            userId = user.id();
+        }
+    }
+
+    QVERIFY(userId > 0LL);
+
+    // Define a working day with a single schedule for the user
+    const QDateTime dayStart(QDate(2015, 8, 3), QTime(0, 0), Qt::UTC);
+
+    QVERIFY(Database::ScheduleManagement::addWorkingDay(dayStart, dayStart.addDays(1)));
+    QVERIFY(Database::ScheduleManagement::addSchedule(userId,
+                                                      dayStart.addSecs(9 * 3600),
+                                                      dayStart.addSecs(17 * 3600)));
+
+    // Start server
+    Server server;
+
+    QVERIFY(server.start(m_port));
+    QVERIFY(server.isStarted());
+    QCoreApplication::processEvents();
+
+    // Workday can't be started outside of the working days
+    QVERIFY(!server.startWorkday(dayStart.addDays(30)));
+
+    // Start the workday
+    QVERIFY(server.startWorkday(dayStart.addSecs(12 * 3600)));
+
+    // Create test client, connect to the server and login
+    Test::Client client;
+
+    QVERIFY(client.connect(m_port));
+    QTRY_COMPARE(server.clientCount(), 1);
+    QCOMPARE(client.login("user1", "111"), userId);
+
+    // Start working before the schedule, only the scheduled time is tracked
+    Packets::ClockEventRequestPacket clockEventPacket(Event::Type_Started);
+    clockEventPacket.setId(PacketHandler::createPacketId());
+    clockEventPacket.setUserId(userId);
+    clockEventPacket.setTimestamp(dayStart.addSecs(8 * 3600));
+
+    QVERIFY(client.sendPacket(clockEventPacket));
+
+    QScopedPointer<Packets::Packet> packet(client.readPacket());
+    Packets::ClockEventResponsePacket *clockEventResponsePacket =
+            dynamic_cast<Packets::ClockEventResponsePacket *>(packet.data());
+
+    QVERIFY(clockEventResponsePacket != nullptr);
+    QVERIFY(clockEventResponsePacket->isAccepted());
+
+    QCOMPARE(client.requestWorkingTime(userId, dayStart.addSecs(10 * 3600)), 3600);
+
+    // Schedule added during the workday is applied without resetting the tracked time
+    QVERIFY(Database::ScheduleManagement::addSchedule(userId,
+                                                      dayStart.addSecs(8 * 3600),
+                                                      dayStart.addSecs(9 * 3600)));
+    QCoreApplication::processEvents();
+
+    QCOMPARE(client.requestWorkingTime(userId, dayStart.addSecs(10 * 3600)), 7200);
+
+    // Starting the workday again resets the tracked time
+    QVERIFY(server.startWorkday(dayStart.addSecs(12 * 3600)));
+
+    QCOMPARE(client.requestWorkingTime(userId, dayStart.addSecs(10 * 3600)), 0);
+}
+
+// Credential cache unit tests *********************************************************************
+
+void ServerTest::testCaseCredentialCache()
+{
+    using namespace OpenTimeTracker::Server;
+
+    User user;
+    user.setId(1LL);
+    user.setName("user");
+    user.setPassword("secret");
+
+    CredentialCache credentialCache;
+    credentialCache.addUser(user);
+    QCOMPARE(credentialCache.size(), 1);
+
+    // Verify credentials
+    QCOMPARE(credentialCache.verify("user", "secret"), 1LL);
+    QCOMPARE(credentialCache.verify("user", "Secret"), 0LL);
+    QCOMPARE(credentialCache.verify("user", QString()), 0LL);
+    QCOMPARE(credentialCache.verify("unknown", "secret"), 0LL);
+
+    // Renamed user can only log in with the new name
+    user.setName("renamed");
+    credentialCache.addUser(user);
+
+    QCOMPARE(credentialCache.size(), 1);
+    QCOMPARE(credentialCache.verify("user", "secret"), 0LL);
+    QCOMPARE(credentialCache.verify("renamed", "secret"), 1LL);
+
+    // Disabled user is removed from the cache
+    user.setPassword(QString());
+    credentialCache.addUser(user);
+
+    QCOMPARE(credentialCache.size(), 0);
+    QCOMPARE(credentialCache.verify("renamed", "secret"), 0LL);
+}
+
+// User directory unit tests **********************************************************************
+
+void ServerTest::testCaseUserDirectory()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Prepare users, user groups and user mappings
+    QList<User> users;
+    QList<UserGroup> userGroups;
+    QList<UserMapping> userMappings;
+
+    for (int i = 1; i <= 3; i++)
+    {
+        User user;
+        user.setId(i);
+        user.setName(QString("user%1").arg(i));
+        user.setPassword("password");
+        users.append(user);
+
+        UserGroup userGroup;
+        userGroup.setId(i);
+        userGroup.setName(QString("group%1").arg(i));
+        userGroups.append(userGroup);
+    }
+
+    for (int i = 1; i <= 3; i++)
+    {
+        // All users are in the first group and each user is also in its own group
+        UserMapping userMapping;
+        userMapping.setId(i);
+        userMapping.setUserGroupId(1LL);
+        userMapping.setUserId(i);
+        userMappings.append(userMapping);
+
+        userMapping.setId(i + 10);
+        userMapping.setUserGroupId(i);
+        userMappings.append(userMapping);
+    }
+
+    // Load the directory (duplicate mapping of the first user to the first group is skipped)
+    UserDirectory userDirectory;
+    userDirectory.load(users, userGroups, userMappings);
+
+    QCOMPARE(userDirectory.userCount(), 3);
+    QCOMPARE(userDirectory.users().first().id(), 1LL);
+    QCOMPARE(userDirectory.user(2LL).name(), QString("user2"));
+    QCOMPARE(userDirectory.userByName("user3").id(), 3LL);
+    QVERIFY(!userDirectory.userByName("unknown").isValid());
+    QVERIFY(userDirectory.containsUserGroup(2LL));
+    QCOMPARE(userDirectory.userGroupMembers(1LL).size(), 3);
+    QCOMPARE(userDirectory.userGroupsOfUser(1LL).size(), 1);
+    QCOMPARE(userDirectory.userGroupsOfUser(2LL).size(), 2);
+
+    // Users with a duplicate ID or name are rejected
+    User user;
+    user.setId(4LL);
+    user.setName("user1");
+    QVERIFY(!userDirectory.addUser(user));
+
+    user.setName("user4");
+    QVERIFY(userDirectory.addUser(user));
+    QCOMPARE(userDirectory.userByName("user4").id(), 4LL);
+
+    // Renamed user is indexed only by the new name
+    QVERIFY(!userDirectory.changeUserName(4LL, "user1"));
+    QVERIFY(userDirectory.changeUserName(4LL, "renamed"));
+    QVERIFY(!userDirectory.userByName("user4").isValid());
+    QCOMPARE(userDirectory.userByName("renamed").id(), 4LL);
+
+    // Mappings keep both adjacency arrays coherent
+    UserMapping userMapping;
+    userMapping.setId(20LL);
+    userMapping.setUserGroupId(2LL);
+    userMapping.setUserId(4LL);
+
+    QVERIFY(userDirectory.addUserMapping(userMapping));
+    QVERIFY(!userDirectory.addUserMapping(userMapping));
+    QCOMPARE(userDirectory.userGroupMembers(2LL).size(), 2);
+    QCOMPARE(userDirectory.userGroupsOfUser(4LL), QVector<qint64>() << 2LL);
+    QVERIFY(userDirectory.groupMembership().isMember(2LL, 4LL));
+
+    QVERIFY(userDirectory.removeUserMapping(20LL));
+    QVERIFY(!userDirectory.removeUserMapping(20LL));
+    QCOMPARE(userDirectory.userGroupMembers(2LL), QVector<qint64>() << 2LL);
+    QVERIFY(userDirectory.userGroupsOfUser(4LL).isEmpty());
+    QVERIFY(!userDirectory.groupMembership().isMember(2LL, 4LL));
+
+    // Mapping of an unknown user is rejected
+    userMapping.setId(21LL);
+    userMapping.setUserId(5LL);
+    QVERIFY(!userDirectory.addUserMapping(userMapping));
+}
+
+// Group membership unit tests *********************************************************************
+
+void ServerTest::testCaseUserSet()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Slots in different words
+    UserSet userSet;
+    QVERIFY(userSet.isEmpty());
+
+    userSet.insert(1);
+    userSet.insert(63);
+    userSet.insert(64);
+    userSet.insert(130);
+
+    QVERIFY(!userSet.isEmpty());
+    QCOMPARE(userSet.count(), 4);
+    QVERIFY(userSet.contains(63));
+    QVERIFY(userSet.contains(64));
+    QVERIFY(!userSet.contains(65));
+    QVERIFY(!userSet.contains(1000));
+    QCOMPARE(userSet.toSlotList(), QVector<int>() << 1 << 63 << 64 << 130);
+
+    // Union
+    UserSet other;
+    other.insert(2);
+    other.insert(64);
+    other.insert(200);
+
+    UserSet result = userSet;
+    result.unite(other);
+    QCOMPARE(result.toSlotList(), QVector<int>() << 1 << 2 << 63 << 64 << 130 << 200);
+
+    // Intersection
+    result = userSet;
+    result.intersect(other);
+    QCOMPARE(result.toSlotList(), QVector<int>() << 64);
+
+    // Difference
+    result = userSet;
+    result.subtract(other);
+    QCOMPARE(result.toSlotList(), QVector<int>() << 1 << 63 << 130);
+
+    // Removing the last slot empties the set
+    result.remove(1);
+    result.remove(63);
+    result.remove(130);
+    QVERIFY(result.isEmpty());
+    QCOMPARE(result.count(), 0);
+}
+
+void ServerTest::testCaseGroupMembership()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Add 100 users: group 1 holds the even users, group 2 the multiples of three and group 3
+    // the users above 90
+    GroupMembership groupMembership;
+
+    for (qint64 userId = 1LL; userId <= 100LL; userId++)
+    {
+        QVERIFY(groupMembership.addUser(userId));
+
+        if ((userId % 2LL) == 0LL)
+        {
+            QVERIFY(groupMembership.addMember(1LL, userId));
+        }
+
+        if ((userId % 3LL) == 0LL)
+        {
+            QVERIFY(groupMembership.addMember(2LL, userId));
+        }
+
+        if (userId > 90LL)
+        {
+            QVERIFY(groupMembership.addMember(3LL, userId));
+        }
+    }
+
+    QVERIFY(!groupMembership.addUser(1LL));
+    QVERIFY(!groupMembership.addMember(1LL, 101LL));
+    QCOMPARE(groupMembership.userCount(), 100);
+    QCOMPARE(groupMembership.memberCount(1LL), 50);
+    QCOMPARE(groupMembership.memberCount(2LL), 33);
+    QCOMPARE(groupMembership.memberCount(4LL), 0);
+
+    // Users in group 1 or 2 but not in group 3
+    UserSet userSet = groupMembership.membersOfAny(QList<qint64>() << 1LL << 2LL);
+    QCOMPARE(userSet.count(), 67);
+
+    userSet.subtract(groupMembership.members(3LL));
+    QCOMPARE(userSet.count(), 60);
+    QCOMPARE(groupMembership.userIds(userSet).last(), 90LL);
+
+    // Users in groups 1, 2 and 3
+    userSet = groupMembership.membersOfAll(QList<qint64>() << 1LL << 2LL << 3LL);
+    QCOMPARE(groupMembership.userIds(userSet), QVector<qint64>() << 96LL);
+    QVERIFY(groupMembership.membersOfAll(QList<qint64>()).isEmpty());
+
+    // Groups of a user
+    QCOMPARE(groupMembership.userGroupsOfUser(96LL), QVector<qint64>() << 1LL << 2LL << 3LL);
+    QCOMPARE(groupMembership.userGroupsOfUser(97LL), QVector<qint64>() << 3LL);
+    QVERIFY(groupMembership.userGroupsOfUser(1LL).isEmpty());
+
+    // Remove membership
+    QVERIFY(groupMembership.removeMember(3LL, 96LL));
+    QVERIFY(!groupMembership.isMember(3LL, 96LL));
+    QVERIFY(groupMembership.isMember(2LL, 96LL));
+    QCOMPARE(groupMembership.memberCount(3LL), 9);
+}
+
+// Schedule cache unit tests ***********************************************************************
+
+void ServerTest::testCaseScheduleCache()
+{
+    using namespace OpenTimeTracker::Server;
+
+    const QDateTime startOfDay(QDate(2016, 01, 01), QTime(7, 0, 0), Qt::UTC);
+    const QDateTime endOfDay(QDate(2016, 01, 01), QTime(22, 59, 59), Qt::UTC);
+
+    // Prepare schedules of two users (interleaved like the results of a single query)
+    QList<Schedule> schedules;
+
+    for (int i = 0; i < 4; i++)
+    {
+        Schedule schedule;
+        schedule.setId(i + 1);
+        schedule.setUserId((i % 2) + 1);
+        schedule.setStartTimestamp(startOfDay.addSecs(3600 * i));
+        schedule.setEndTimestamp(startOfDay.addSecs((3600 * i) + 1800));
+        schedules.append(schedule);
+    }
+
+    ScheduleCache scheduleCache;
+    QVERIFY(!scheduleCache.addWorkingDay(0LL, startOfDay, endOfDay, schedules));
+    QVERIFY(!scheduleCache.addWorkingDay(1LL, endOfDay, startOfDay, schedules));
+
+    // Invalid schedules are skipped
+    QVERIFY(scheduleCache.addWorkingDay(1LL,
+                                        startOfDay,
+                                        endOfDay,
+                                        QList<Schedule>() << schedules << Schedule()));
+    QVERIFY(scheduleCache.containsWorkingDay(1LL));
+
+    // Schedules are grouped by user
+    QCOMPARE(scheduleCache.scheduleCount(1LL, 1LL), 2);
+    QCOMPARE(scheduleCache.scheduleCount(1LL, 2LL), 2);
+    QCOMPARE(scheduleCache.scheduleCount(1LL, 3LL), 0);
+    QCOMPARE(scheduleCache.scheduleCount(2LL, 1LL), 0);
+    QCOMPARE(scheduleCache.scheduledTime(1LL, 1LL), 3600);
+
+    const QList<Schedule> userSchedules = scheduleCache.schedules(1LL, 2LL);
+    QCOMPARE(userSchedules.size(), 2);
+    QCOMPARE(userSchedules.at(0).id(), 2LL);
+    QCOMPARE(userSchedules.at(0).userId(), 2LL);
+    QCOMPARE(userSchedules.at(0).startTimestamp(), schedules.at(1).startTimestamp());
+    QCOMPARE(userSchedules.at(1).id(), 4LL);
+    QCOMPARE(userSchedules.at(1).endTimestamp(), schedules.at(3).endTimestamp());
+
+    // Cached schedules can be used to start the workday
+    TimeTracker timeTracker;
+    timeTracker.setUserId(2LL);
+    QVERIFY(timeTracker.startWorkday(BreakTimeCalculator(), userSchedules));
+
+    // Invalidation
+    scheduleCache.invalidate(endOfDay.addSecs(1), endOfDay.addSecs(3600));
+    QVERIFY(scheduleCache.containsWorkingDay(1LL));
+
+    scheduleCache.invalidateSchedule(5LL);
+    QVERIFY(scheduleCache.containsWorkingDay(1LL));
+
+    scheduleCache.invalidateSchedule(3LL);
+    QVERIFY(!scheduleCache.containsWorkingDay(1LL));
+
+    QVERIFY(scheduleCache.addWorkingDay(1LL, startOfDay, endOfDay, schedules));
+    scheduleCache.invalidate(startOfDay.addSecs(60), startOfDay.addSecs(120));
+    QCOMPARE(scheduleCache.workingDayCount(), 0);
+}
+
+void ServerTest::testCaseScheduleIndex()
+{
+    using namespace OpenTimeTracker::Server;
+
+    const QDateTime startOfDay(QDate(2016, 01, 01), QTime(0, 0, 0), Qt::UTC);
+    QList<QDateTime> hours;
+
+    for (int i = 0; i < 24; i++)
+    {
+        hours.append(startOfDay.addSecs(3600 * i));
+    }
+
+    // Insert intervals out of order
+    ScheduleIndex scheduleIndex;
+    QVERIFY(scheduleIndex.insert(1LL, hours[14], hours[18]));
+    QVERIFY(scheduleIndex.insert(1LL, hours[8], hours[12]));
+    QVERIFY(scheduleIndex.insert(2LL, hours[10], hours[16]));
+    QCOMPARE(scheduleIndex.size(), 3);
+
+    // Invalid intervals
+    QVERIFY(!scheduleIndex.insert(1LL, QDateTime(), hours[1]));
+    QVERIFY(!scheduleIndex.insert(1LL, hours[1], hours[0]));
+
+    // Overlapping intervals
+    QVERIFY(scheduleIndex.overlaps(1LL, hours[11], hours[13]));
+    QVERIFY(scheduleIndex.overlaps(1LL, hours[9], hours[10]));
+    QVERIFY(scheduleIndex.overlaps(1LL, hours[7], hours[19]));
+    QVERIFY(!scheduleIndex.insert(1LL, hours[17], hours[20]));
+
+    // Touching intervals and intervals of other users don't overlap
+    QVERIFY(!scheduleIndex.overlaps(1LL, hours[12], hours[14]));
+    QVERIFY(!scheduleIndex.overlaps(3LL, hours[8], hours[9]));
+    QVERIFY(scheduleIndex.insert(1LL, hours[12], hours[14]));
+    QCOMPARE(scheduleIndex.size(), 4);
+
+    scheduleIndex.clear();
+    QCOMPARE(scheduleIndex.size(), 0);
+    QVERIFY(!scheduleIndex.overlaps(1LL, hours[9], hours[10]));
+}
+
+void ServerTest::testCaseScheduleTemplate()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Night shift on Fridays (2016-01-01 is a Friday)
+    ScheduleTemplate scheduleTemplate;
+    scheduleTemplate.setId(1LL);
+    scheduleTemplate.setUserId(2LL);
+    scheduleTemplate.setDayOfWeek(Qt::Friday);
+    scheduleTemplate.setStartTime(QTime(22, 0, 0));
+    scheduleTemplate.setDuration(8 * 3600);
+    scheduleTemplate.setValidFrom(QDate(2016, 01, 01));
+    QVERIFY(scheduleTemplate.isValid());
+
+    QVERIFY(scheduleTemplate.occursOn(QDate(2016, 01, 01)));
+    QVERIFY(scheduleTemplate.occursOn(QDate(2016, 01, 08)));
+    QVERIFY(!scheduleTemplate.occursOn(QDate(2016, 01, 02)));
+    QVERIFY(!scheduleTemplate.occursOn(QDate(2015, 12, 25)));
+
+    // Expansion
+    const QDateTime startOfWeek(QDate(2016, 01, 01), QTime(0, 0, 0));
+    QList<Schedule> schedules = scheduleTemplate.expand(startOfWeek, startOfWeek.addDays(14));
+    QCOMPARE(schedules.size(), 2);
+    QCOMPARE(schedules.at(0).id(), 0LL);
+    QCOMPARE(schedules.at(0).scheduleTemplateId(), 1LL);
+    QCOMPARE(schedules.at(0).userId(), 2LL);
+    QCOMPARE(schedules.at(0).startTimestamp(), QDateTime(QDate(2016, 01, 01), QTime(22, 0, 0)));
+    QCOMPARE(schedules.at(0).endTimestamp(), QDateTime(QDate(2016, 01, 02), QTime(6, 0, 0)));
+    QCOMPARE(schedules.at(1).startTimestamp(), QDateTime(QDate(2016, 01, 08), QTime(22, 0, 0)));
+    QVERIFY(schedules.at(1).isValid());
+
+    // Only the schedules that are completely within the time range are expanded
+    QVERIFY(scheduleTemplate.expand(startOfWeek, startOfWeek.addDays(1)).isEmpty());
+
+    // Copies are implicitly shared, changing a copy doesn't change the original
+    ScheduleTemplate copy(scheduleTemplate);
+    copy.addException(QDate(2016, 01, 08));
+    copy.setStartTime(QTime(6, 0, 0));
+    QVERIFY(scheduleTemplate.exceptions().isEmpty());
+    QCOMPARE(scheduleTemplate.startTime(), QTime(22, 0, 0));
+    QCOMPARE(copy.exceptions().size(), 1);
+
+    // Exceptions and end of validity
+    scheduleTemplate.addException(QDate(2016, 01, 01));
+    QVERIFY(!scheduleTemplate.occursOn(QDate(2016, 01, 01)));
+
+    scheduleTemplate.setValidUntil(QDate(2016, 01, 14));
+    QCOMPARE(scheduleTemplate.expand(startOfWeek, startOfWeek.addDays(28)).size(), 1);
+
+    scheduleTemplate.setValidUntil(QDate(2015, 12, 31));
+    QVERIFY(!scheduleTemplate.isValid());
+    QVERIFY(scheduleTemplate.expand(startOfWeek, startOfWeek.addDays(28)).isEmpty());
+
+    // Start time in a daylight saving time gap (2016-03-27 02:30 doesn't exist in CET/CEST) is
+    // shifted past the gap
+    const QByteArray timeZone = qgetenv("TZ");
+    qputenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3");
+    tzset();
+
+    ScheduleTemplate dstTemplate;
+    dstTemplate.setId(2LL);
+    dstTemplate.setUserId(2LL);
+    dstTemplate.setDayOfWeek(Qt::Sunday);
+    dstTemplate.setStartTime(QTime(2, 30, 0));
+    dstTemplate.setDuration(3600);
+    dstTemplate.setValidFrom(QDate(2016, 03, 01));
+
+    const QDateTime dstDayStart(QDate(2016, 03, 27), QTime(0, 0, 0));
+    schedules = dstTemplate.expand(dstDayStart, dstDayStart.addDays(1));
+
+    QList<QDateTime> dstTimestamps;
+
+    foreach (const Schedule &schedule, schedules)
+    {
+        dstTimestamps << schedule.startTimestamp().toUTC() << schedule.endTimestamp().toUTC();
+    }
+
+    // Restore the time zone
+    if (timeZone.isNull())
+    {
+        qunsetenv("TZ");
+    }
+    else
+    {
+        qputenv("TZ", timeZone);
+    }
+
+    tzset();
+
+    QCOMPARE(schedules.size(), 1);
+    QVERIFY(schedules.at(0).isValid());
+    QCOMPARE(dstTimestamps.at(0), QDateTime(QDate(2016, 03, 27), QTime(1, 30, 0), Qt::UTC));
+    QCOMPARE(dstTimestamps.at(1), QDateTime(QDate(2016, 03, 27), QTime(2, 30, 0), Qt::UTC));
+}
+
+// Working day cache unit tests ********************************************************************
+
+void ServerTest::testCaseWorkingDayCache()
+{
+    using namespace OpenTimeTracker::Server;
+
+    const QDateTime startOfDay(QDate(2016, 01, 01), QTime(7, 0, 0), Qt::UTC);
+    const QDateTime endOfDay(QDate(2016, 01, 01), QTime(22, 59, 59), Qt::UTC);
+
+    // Add working days out of order
+    WorkingDayCache workingDayCache;
+    QVERIFY(!workingDayCache.addWorkingDay(0LL, startOfDay, endOfDay));
+    QVERIFY(!workingDayCache.addWorkingDay(1LL, endOfDay, startOfDay));
+    QVERIFY(workingDayCache.addWorkingDay(3LL, startOfDay.addDays(2), endOfDay.addDays(2)));
+    QVERIFY(workingDayCache.addWorkingDay(1LL, startOfDay, endOfDay));
+    QVERIFY(workingDayCache.addWorkingDay(2LL, startOfDay.addDays(1), endOfDay.addDays(1)));
+    QCOMPARE(workingDayCache.size(), 3);
+
+    // Start, middle and end of a working day
+    qint64 workingDayId = -1LL;
+    QPair<QDateTime, QDateTime> workingDay =
+            workingDayCache.findWorkingDay(startOfDay.addDays(1), &workingDayId);
+    QCOMPARE(workingDayId, 2LL);
+    QCOMPARE(workingDay.first, startOfDay.addDays(1));
+    QCOMPARE(workingDay.second, endOfDay.addDays(1));
+
+    workingDayCache.findWorkingDay(startOfDay.addSecs(3600), &workingDayId);
+    QCOMPARE(workingDayId, 1LL);
+
+    workingDayCache.findWorkingDay(endOfDay.addDays(2), &workingDayId);
+    QCOMPARE(workingDayId, 3LL);
+
+    // Timestamps outside of the working days
+    workingDay = workingDayCache.findWorkingDay(startOfDay.addSecs(-1), &workingDayId);
+    QCOMPARE(workingDayId, 0LL);
+    QVERIFY(!workingDay.first.isValid());
+    QVERIFY(!workingDay.second.isValid());
+
+    workingDayCache.findWorkingDay(endOfDay.addSecs(1), &workingDayId);
+    QCOMPARE(workingDayId, 0LL);
+
+    // The working day with the highest ID is used for overlapping working days
+    QVERIFY(workingDayCache.addWorkingDay(4LL, startOfDay.addSecs(-3600), endOfDay.addDays(1)));
+    workingDayCache.findWorkingDay(startOfDay.addSecs(3600), &workingDayId);
+    QCOMPARE(workingDayId, 4LL);
+
+    workingDayCache.findWorkingDay(startOfDay.addSecs(-1800), &workingDayId);
+    QCOMPARE(workingDayId, 4LL);
+
+    workingDayCache.findWorkingDay(endOfDay.addDays(2), &workingDayId);
+    QCOMPARE(workingDayId, 3LL);
+
+    workingDayCache.clear();
+    QCOMPARE(workingDayCache.size(), 0);
+    workingDayCache.findWorkingDay(startOfDay, &workingDayId);
+    QCOMPARE(workingDayId, 0LL);
+}
+
+// Settings unit tests *****************************************************************************
+
+void ServerTest::testCaseSettings()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Default values
+    Settings settings;
+    QCOMPARE(settings.port(), static_cast<quint16>(61234));
+    QCOMPARE(settings.keepAliveInterval(), 30000);
+    QCOMPARE(settings.value(Settings::Key_CompressionThreshold), 1024);
+    QCOMPARE(Settings::key("idleTimeout"), Settings::Key_IdleTimeout);
+    QCOMPARE(Settings::key("unknown"), Settings::Key_Count);
+
+    // Server uses the same default values
+    Server server;
+    QCOMPARE(server.ioThreadCount(), settings.ioThreadCount());
+    QCOMPARE(server.idleTimeout(), settings.idleTimeout());
+    QCOMPARE(server.keepAliveInterval(), settings.keepAliveInterval());
+    QCOMPARE(server.maxFrameSize(), settings.maxFrameSize());
+    QCOMPARE(server.maxInputBufferSize(), settings.maxInputBufferSize());
+    QCOMPARE(server.compressionThreshold(), settings.compressionThreshold());
+
+    // Validation
+    QVERIFY(settings.setValue(Settings::Key_Port, QString("1234")));
+    QCOMPARE(settings.port(), static_cast<quint16>(1234));
+    QVERIFY(!settings.setValue(Settings::Key_Port, 70000));
+    QVERIFY(!settings.setValue(Settings::Key_Port, 0));
+    QVERIFY(!settings.setValue(Settings::Key_KeepAliveInterval, -1));
+    QVERIFY(!settings.setValue(Settings::Key_IoThreadCount, QString("abc")));
+    QCOMPARE(settings.port(), static_cast<quint16>(1234));
+    QCOMPARE(settings.keepAliveInterval(), 30000);
+
+    // Zero disables the frame size limit, other small frame sizes are rejected
+    QVERIFY(!settings.setValue(Settings::Key_MaxFrameSize, 512));
+    QVERIFY(settings.setValue(Settings::Key_MaxFrameSize, 0));
+    QCOMPARE(settings.maxFrameSize(), 0);
+    QVERIFY(settings.setValue(Settings::Key_MaxFrameSize, 64 * 1024));
+
+    // Load, missing settings get their default values and invalid settings are reported
+    QMap<QString, QVariant> storedSettings;
+    storedSettings["ioThreadCount"] = 2;
+    storedSettings["keepAliveInterval"] = QString("-5");
+    storedSettings["otherSetting"] = QString("value");
+
+    QStringList errors;
+    QVERIFY(!settings.load(storedSettings, &errors));
+    QCOMPARE(errors.size(), 1);
+    QCOMPARE(settings.ioThreadCount(), 2);
+    QCOMPARE(settings.keepAliveInterval(), 30000);
+    QCOMPARE(settings.port(), static_cast<quint16>(61234));
+
+    // Changes written to the database
+    QSignalSpy valueChangedSpy(&settings, SIGNAL(valueChanged(QString,int)));
+    settings.applySettingChanged("idleTimeout", 5000);
+    settings.applySettingChanged("idleTimeout", 5000);
+    settings.applySettingChanged("maxFrameSize", 10);
+    settings.applySettingChanged("otherSetting", 10);
+
+    QCOMPARE(settings.idleTimeout(), 5000);
+    QCOMPARE(settings.maxFrameSize(), 64 * 1024);
+    QCOMPARE(valueChangedSpy.size(), 1);
+    QCOMPARE(valueChangedSpy.at(0).at(0).toString(), QString("idleTimeout"));
+    QCOMPARE(valueChangedSpy.at(0).at(1).toInt(), 5000);
+}
+
+// Event recorder unit tests ***********************************************************************
+
+void ServerTest::testCaseEventRecorder()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Find the test user
+    qint64 userId = 0LL;
+
+    foreach (const User &user, Database::UserManagement::readUsers())
+    {
+        if (user.name() == QStringLiteral("user1"))
+        {
+            userId = user.id();
+        }
+    }
+
+    QVERIFY(userId > 0LL);
+
+    // Queue a valid event and an event that can't be written to the database
+    EventRecorder eventRecorder;
+    eventRecorder.setMaxWriteAttempts(2);
+
+    const QDateTime timestamp(QDate(2015, 7, 1), QTime(8, 0), Qt::UTC);
+    eventRecorder.addEvent(timestamp, userId, Event::Type_Started);
+    eventRecorder.addEvent(timestamp.addSecs(60), userId, Event::Type_Invalid);
+
+    QCOMPARE(eventRecorder.pendingEventCount(), 2);
+
+    // Valid event is written, the failed event stays queued for the next flush
+    eventRecorder.flush();
+
+    QCOMPARE(eventRecorder.pendingEventCount(), 1);
+    QCOMPARE(eventRecorder.droppedEventCount(), 0);
+    QCOMPARE(Database::EventManagement::readEvents(timestamp,
+                                                   timestamp.addSecs(3600),
+                                                   userId).size(),
+             1);
+
+    // Failed event is dropped after the maximum number of write attempts
+    eventRecorder.flush();
+
+    QCOMPARE(eventRecorder.pendingEventCount(), 0);
+    QCOMPARE(eventRecorder.droppedEventCount(), 1);
+
+    // Timed flush writes only the maximum number of events per flush, the remaining events are
+    // written by the following flushes
+    eventRecorder.setMaxEventsPerFlush(2);
+
+    for (int i = 0; i < 5; i++)
+    {
+        const Event::Type type = ((i % 2) == 0) ? Event::Type_Started : Event::Type_Finished;
+        eventRecorder.addEvent(timestamp.addSecs(3600 + (i * 60)), userId, type);
+    }
+
+    QVERIFY(QMetaObject::invokeMethod(&eventRecorder, "flushQueuedEvents", Qt::DirectConnection));
+    QCOMPARE(eventRecorder.pendingEventCount(), 3);
+
+    QTRY_COMPARE(eventRecorder.pendingEventCount(), 0);
+    QCOMPARE(eventRecorder.droppedEventCount(), 1);
+    QCOMPARE(Database::EventManagement::readEvents(timestamp.addSecs(3600),
+                                                   timestamp.addSecs(7200),
+                                                   userId).size(),
+             5);
+}
+
+// Latency histogram unit tests ********************************************************************
+
+void ServerTest::testCaseLatencyHistogram()
+{
+    using namespace OpenTimeTracker::Server;
+
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.count(), 0ULL);
+    QCOMPARE(histogram.average(), 0.0);
+
+    // Add samples
+    histogram.addSample(0LL);
+    histogram.addSample(1LL);
+    histogram.addSample(3LL);
+    histogram.addSample(1000000LL);
+
+    QCOMPARE(histogram.count(), 4ULL);
+    QCOMPARE(histogram.minimum(), 0LL);
+    QCOMPARE(histogram.maximum(), 1000000LL);
+    QCOMPARE(histogram.average(), 1000004.0 / 4.0);
+
+    // Check the buckets
+    QCOMPARE(histogram.bucketSampleCount(0), 1ULL);
+    QCOMPARE(histogram.bucketSampleCount(1), 1ULL);
+    QCOMPARE(histogram.bucketSampleCount(2), 1ULL);
+    QCOMPARE(histogram.bucketSampleCount(LatencyHistogram::bucketCount() - 1), 1ULL);
+    QCOMPARE(LatencyHistogram::bucketUpperBound(2), 4LL);
+    QVERIFY(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketCount() - 1) < 0LL);
+
+    // Merge histograms
+    LatencyHistogram other;
+    other.addSample(2LL);
+    histogram.merge(other);
+
+    QCOMPARE(histogram.count(), 5ULL);
+    QCOMPARE(histogram.bucketSampleCount(2), 2ULL);
+}
+
+// Value type unit tests ***************************************************************************
+
+void ServerTest::testCaseImplicitSharing()
+{
+    using namespace OpenTimeTracker::Server;
+
+    const QDateTime timestamp(QDate(2015, 6, 1), QTime(8, 0), Qt::UTC);
+
+    Event event;
+    event.setId(1LL);
+    event.setTimestamp(timestamp);
+    event.setUserId(2LL);
+    event.setType(Event::Type_Started);
+    event.setEnabled(true);
+    QVERIFY(event.isValid());
+
+    // Changing a copy detaches it, the original is unchanged
+    Event copy(event);
+    copy.setUserId(3LL);
+    copy.setType(Event::Type_Finished);
+
+    QCOMPARE(event.userId(), 2LL);
+    QCOMPARE(event.type(), Event::Type_Started);
+    QCOMPARE(copy.userId(), 3LL);
+    QCOMPARE(copy.type(), Event::Type_Finished);
+
+    // Moved-from object is left with default values and can still be used
+    Event moved(qMove(copy));
+    QCOMPARE(moved.userId(), 3LL);
+    QVERIFY(!copy.isValid());
+    QCOMPARE(copy.id(), 0LL);
+
+    copy.setId(4LL);
+    QCOMPARE(copy.id(), 4LL);
+    QCOMPARE(moved.id(), 1LL);
+
+    // Same for a type that is stored in the lists of the schedule cache
+    Schedule schedule;
+    schedule.setId(1LL);
+    schedule.setUserId(2LL);
+    schedule.setStartTimestamp(timestamp);
+    schedule.setEndTimestamp(timestamp.addSecs(3600));
+
+    Schedule scheduleCopy = schedule;
+    QVERIFY(scheduleCopy == schedule);
+
+    scheduleCopy.setEndTimestamp(timestamp.addSecs(7200));
+    QCOMPARE(schedule.endTimestamp(), timestamp.addSecs(3600));
+    QVERIFY(!(scheduleCopy == schedule));
+
+    Schedule movedSchedule(qMove(scheduleCopy));
+    QVERIFY(movedSchedule.isValid());
+    QVERIFY(!scheduleCopy.isValid());
+}
+
+// Packet unit tests *******************************************************************************
+
+void ServerTest::testCasePacketHandlerLimits()
+{
+    using namespace OpenTimeTracker::Server;
+
+    Packets::KeepAliveRequestPacket requestPacket;
+    requestPacket.setId(1U);
+
+    // Packet received in multiple parts is read when its end is received
+    PacketHandler packetHandler;
+    packetHandler.registerPacketReader(new Packets::KeepAliveRequestPacketReader());
+    packetHandler.registerPacketWriter(new Packets::KeepAliveRequestPacketWriter());
+    packetHandler.setMaxFrameSize(1024);
+    packetHandler.setMaxBufferSize(2048);
+
+    const QByteArray packetData = packetHandler.toByteArray(requestPacket);
+
+    QVERIFY(packetHandler.addData(packetData.left(5)));
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_NeedMoreData);
+    QVERIFY(packetHandler.addData(packetData.mid(5)));
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_Success);
+
+    QScopedPointer<Packets::Packet> packet(packetHandler.takePacket());
+    QVERIFY(!packet.isNull());
+    QCOMPARE(packet->id(), 1U);
+
+    // Data that doesn't fit into the buffer is rejected
+    QVERIFY(!packetHandler.addData(QByteArray(4096, 'a')));
+
+    // Unfinished packet that exceeds the frame size is rejected
+    QVERIFY(packetHandler.addData(QByteArray("\x02") + QByteArray(1025, 'a')));
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_Error);
+}
+
+void ServerTest::testCasePacketIdThreads()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Create packet IDs from multiple threads at the same time
+    const int threadCount = 4;
+    const int packetIdCount = 10000;
+    QList<Test::PacketIdThread *> threads;
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.append(new Test::PacketIdThread(packetIdCount));
+    }
+
+    foreach (Test::PacketIdThread *thread, threads)
+    {
+        thread->start();
+    }
+
+    // All packet IDs must be unique
+    QSet<quint32> packetIds;
+
+    foreach (Test::PacketIdThread *thread, threads)
+    {
+        QVERIFY(thread->wait());
+
+        foreach (const quint32 packetId, thread->packetIds())
+        {
+            QVERIFY(packetId != 0U);
+            packetIds.insert(packetId);
+        }
+    }
+
+    QCOMPARE(packetIds.size(), threadCount * packetIdCount);
+
+    qDeleteAll(threads);
+    threads.clear();
+}
+
+void ServerTest::testCasePacketCompression()
+{
+    using namespace OpenTimeTracker::Server;
+
+    // Prepare packet handler
+    PacketHandler packetHandler;
+    packetHandler.registerPacketReader(new Packets::KeepAliveRequestPacketReader());
+    packetHandler.registerPacketWriter(new Packets::KeepAliveRequestPacketWriter());
+    packetHandler.registerPacketReader(new Packets::UserTotalsResponsePacketReader());
+    packetHandler.registerPacketWriter(new Packets::UserTotalsResponsePacketWriter());
+    packetHandler.setCompressionThreshold(256);
+
+    // Prepare a large packet
+    Packets::UserTotalsResponsePacket packet;
+    packet.setId(1U);
+    packet.setReferenceId(2U);
+    packet.setAccepted(true);
+    packet.setTimestamp(QDateTime(QDate(2015, 6, 1), QTime(12, 0), Qt::UTC));
+
+    for (int i = 0; i < 100; i++)
+    {
+        Packets::UserTotalsResponsePacket::UserTotals totals;
+        totals.userId = i + 1;
+        totals.workingTime = 3600;
+        totals.breakTime = 600;
+        totals.totalWorkingTime = 4200;
+
+        packet.addTotals(totals);
+    }
+
+    // Large packet is compressed
+    const QByteArray packetData = packetHandler.toByteArray(packet);
+    const QByteArray frameData = packetHandler.compressFrame(packetData);
+
+    QCOMPARE(frameData.at(0), '\x01');
+    QVERIFY(frameData.size() < packetData.size());
+
+    // Compressed frame received in multiple parts is read when its end is received
+    QVERIFY(packetHandler.addData(frameData.left(3)));
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_NeedMoreData);
+    QVERIFY(packetHandler.addData(frameData.mid(3)));
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_Success);
+
+    QScopedPointer<Packets::Packet> readPacket(packetHandler.takePacket());
+    Packets::UserTotalsResponsePacket *responsePacket =
+            dynamic_cast<Packets::UserTotalsResponsePacket *>(readPacket.data());
+
+    QVERIFY(responsePacket != nullptr);
+    QCOMPARE(responsePacket->referenceId(), 2U);
+    QCOMPARE(responsePacket->totals().size(), 100);
+    QCOMPARE(responsePacket->totals().last().userId, 100LL);
+
+    // Small packet is not compressed
+    Packets::KeepAliveRequestPacket requestPacket;
+    requestPacket.setId(3U);
+
+    const QByteArray smallPacketData = packetHandler.toByteArray(requestPacket);
+    QCOMPARE(packetHandler.compressFrame(smallPacketData), smallPacketData);
+
+    // Nothing is compressed when compression is disabled
+    packetHandler.setCompressionThreshold(0);
+    QCOMPARE(packetHandler.compressFrame(packetData), packetData);
+
+    // Compressed frame with a payload that exceeds the frame size is rejected
+    packetHandler.setMaxFrameSize(packetData.size() / 2);
+
+    QVERIFY(packetHandler.addData(frameData));
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_Error);
+}
+
+void ServerTest::testCaseKeepAliveResponseTemplate_data()
+{
+    QTest::addColumn<quint32>("id");
+    QTest::addColumn<quint32>("referenceId");
+
+    QTest::newRow("Small IDs") << 1U << 2U;
+    QTest::newRow("Zero reference ID") << 123456U << 0U;
+    QTest::newRow("Maximum IDs") << static_cast<quint32>(UINT32_MAX)
+                                 << static_cast<quint32>(UINT32_MAX);
+}
+
+void ServerTest::testCaseKeepAliveResponseTemplate()
+{
+    using namespace OpenTimeTracker::Server;
+
+    QFETCH(quint32, id);
+    QFETCH(quint32, referenceId);
+
+    // Write the packet from the template
+    const QByteArray packetData =
+            Packets::KeepAliveResponsePacketWriter::writeFromTemplate(id, referenceId);
+
+    // Compare it with the packet written by the packet writer
+    PacketHandler packetHandler;
+    packetHandler.registerPacketReader(new Packets::KeepAliveResponsePacketReader());
+    packetHandler.registerPacketWriter(new Packets::KeepAliveResponsePacketWriter());
+    packetHandler.setJsonFormat(QJsonDocument::Compact);
+
+    Packets::KeepAliveResponsePacket packet;
+    packet.setId(id);
+    packet.setReferenceId(referenceId);
+
+    QCOMPARE(packetData, packetHandler.toByteArray(packet));
+
+    // Read the packet back
+    packetHandler.addData(packetData);
+    QCOMPARE(packetHandler.read(), PacketHandler::Result_Success);
+
+    QScopedPointer<Packets::Packet> readPacket(packetHandler.takePacket());
+    QVERIFY(!readPacket.isNull());
+
+    Packets::KeepAliveResponsePacket *derivedPacket =
+            dynamic_cast<Packets::KeepAliveResponsePacket *>(readPacket.data());
+
+    QVERIFY(derivedPacket != nullptr);
+    QCOMPARE(derivedPacket->id(), id);
+    QCOMPARE(derivedPacket->referenceId(), referenceId);
+}
+
+// Packet writer benchmarks ************************************************************************
+
+void ServerTest::testCaseBenchmarkPacketWriter_data()
+{
+    QTest::addColumn<QString>("packetType");
+    QTest::addColumn<int>("jsonFormat");
+
+    QTest::newRow("KeepAliveRequest, indented") << QString("KeepAliveRequest")
+                                                << static_cast<int>(QJsonDocument::Indented);
+    QTest::newRow("KeepAliveRequest, compact") << QString("KeepAliveRequest")
+                                               << static_cast<int>(QJsonDocument::Compact);
+    QTest::newRow("KeepAliveResponse, indented") << QString("KeepAliveResponse")
+                                                 << static_cast<int>(QJsonDocument::Indented);
+    QTest::newRow("KeepAliveResponse, compact") << QString("KeepAliveResponse")
+                                                << static_cast<int>(QJsonDocument::Compact);
+}
+
+void ServerTest::testCaseBenchmarkPacketWriter()
+{
+    using namespace OpenTimeTracker::Server;
+
+    QFETCH(QString, packetType);
+    QFETCH(int, jsonFormat);
+
+    // Prepare packet handler
+    PacketHandler packetHandler;
+    packetHandler.registerPacketWriter(new Packets::KeepAliveRequestPacketWriter());
+    packetHandler.registerPacketWriter(new Packets::KeepAliveResponsePacketWriter());
+    packetHandler.setJsonFormat(static_cast<QJsonDocument::JsonFormat>(jsonFormat));
+
+    // Prepare packet (use large IDs to get the worst case packet size)
+    QScopedPointer<Packets::Packet> packet;
+
+    if (packetType == Packets::KeepAliveRequestPacket::staticType())
+    {
+        packet.reset(new Packets::KeepAliveRequestPacket());
+    }
+    else
+    {
+        Packets::KeepAliveResponsePacket *responsePacket = new Packets::KeepAliveResponsePacket();
+        responsePacket->setReferenceId(UINT32_MAX - 1U);
+        packet.reset(responsePacket);
+    }
+
+    packet->setId(UINT32_MAX);
+
+    // Measure serialization time
+    QByteArray packetData;
+
+    QBENCHMARK
+    {
+        packetData = packetHandler.toByteArray(*packet);
+    }
+
+    QVERIFY(!packetData.isEmpty());
+
+    if (jsonFormat == static_cast<int>(QJsonDocument::Compact))
+    {
+        QVERIFY(!packetData.contains('\n'));
+    }
+
+    // Report packet size
+    qDebug("Packet size: %d bytes", packetData.size());
+}
+
+void ServerTest::testCaseBenchmarkPacketCompression_data()
+{
+    QTest::addColumn<int>("userCount");
+    QTest::addColumn<bool>("compressed");
+
+    QTest::newRow("10 users, uncompressed") << 10 << false;
+    QTest::newRow("10 users, compressed") << 10 << true;
+    QTest::newRow("100 users, uncompressed") << 100 << false;
+    QTest::newRow("100 users, compressed") << 100 << true;
+    QTest::newRow("1000 users, uncompressed") << 1000 << false;
+    QTest::newRow("1000 users, compressed") << 1000 << true;
+}
+
+void ServerTest::testCaseBenchmarkPacketCompression()
+{
+    using namespace OpenTimeTracker::Server;
+
+    QFETCH(int, userCount);
+    QFETCH(bool, compressed);
+
+    // Prepare packet handler
+    PacketHandler packetHandler;
+    packetHandler.registerPacketWriter(new Packets::UserTotalsResponsePacketWriter());
+    packetHandler.setJsonFormat(QJsonDocument::Compact);
+    packetHandler.setCompressionThreshold(compressed ? 1 : 0);
+
+    // Prepare a typical bulk response
+    Packets::UserTotalsResponsePacket packet;
+    packet.setId(PacketHandler::createPacketId());
+    packet.setReferenceId(PacketHandler::createPacketId());
+    packet.setAccepted(true);
+    packet.setTimestamp(QDateTime(QDate(2015, 6, 1), QTime(12, 0), Qt::UTC));
+
+    for (int i = 0; i < userCount; i++)
+    {
+        Packets::UserTotalsResponsePacket::UserTotals totals;
+        totals.userId = i + 1;
+        totals.workingTime = (i * 37) % 28800;
+        totals.breakTime = (i * 11) % 3600;
+        totals.totalWorkingTime = totals.workingTime + qMin(totals.breakTime, 1800);
+
+        packet.addTotals(totals);
+    }
+
+    // Measure serialization and compression time
+    QByteArray packetData;
+    QByteArray frameData;
+
+    QBENCHMARK
+    {
+        packetData = packetHandler.toByteArray(packet);
+        frameData = packetHandler.compressFrame(packetData);
+    }
+
+    QVERIFY(!frameData.isEmpty());
+    QVERIFY(frameData.size() <= packetData.size());
+
+    // Report frame size
+    qDebug("Frame size: %d bytes (uncompressed: %d bytes)", frameData.size(), packetData.size());
+}
+
+// Event benchmarks ********************************************************************************
+
+void ServerTest::testCaseBenchmarkEventList_data()
+{
+    QTest::addColumn<int>("eventCount");
+
+    QTest::newRow("100 events") << 100;
+    QTest::newRow("1000 events") << 1000;
+    QTest::newRow("10000 events") << 10000;
+}
+
+void ServerTest::testCaseBenchmarkEventList()
+{
+    using namespace OpenTimeTracker::Server;
+
+    QFETCH(int, eventCount);
+
+    // Prepare query results like the ones read from the database
+    const QDateTime startTimestamp(QDate(2015, 6, 1), QTime(8, 0), Qt::UTC);
+    QList<QMap<QString, QVariant> > results;
+
+    for (int i = 0; i < eventCount; i++)
+    {
+        QMap<QString, QVariant> result;
+        result["id"] = i + 1;
+        result["timestamp"] = startTimestamp.addSecs(i * 60).toString(Qt::ISODate);
+        result["userId"] = (i % 10) + 1;
+        result["type"] = static_cast<int>(Event::Type_Started);
+        result["enabled"] = true;
+
+        results.append(result);
+    }
+
+    // Measure construction of the event list and handing over copies of it
+    QList<Event> events;
+    QList<Event> copies;
+
+    QBENCHMARK
+    {
+        events.clear();
+        events.reserve(results.size());
+
+        for (int i = 0; i < results.size(); i++)
+        {
+            events.append(Event::fromMap(results.at(i)));
+        }
+
+        copies = events;
+        copies.detach();
+    }
+
+    QCOMPARE(events.size(), eventCount);
+    QCOMPARE(copies.size(), eventCount);
+    QVERIFY(copies.last().isValid());
+}
+
 // *************************************************************************************************
 
 QTEST_MAIN(ServerTest)